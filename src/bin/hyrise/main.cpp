@@ -20,6 +20,7 @@
 #include <net.h>
 #include "taskscheduler/SharedScheduler.h"
 #include "helper/HwlocHelper.h"
+#include "io/MergeDaemon.h"
 
 namespace po = boost::program_options;
 using namespace hyrise;
@@ -136,13 +137,15 @@ int main(int argc, char *argv[]) {
   size_t port = 0;
   std::string logPropertyFile;
   std::string scheduler_name;
+  double merge_budget;
 
   // Program Options
   po::options_description desc("Allowed Parameters");
   desc.add_options()("help", "Shows this help message")
   ("port,p", po::value<size_t>(&port)->default_value(DEFAULT_PORT), "Server Port")
   ("logdef,l", po::value<std::string>(&logPropertyFile)->default_value("build/log.properties"), "Log4CXX Log Properties File")
-  ("scheduler,s", po::value<std::string>(&scheduler_name)->default_value("WSSimpleTaskScheduler"), "Name of the scheduler to use");
+  ("scheduler,s", po::value<std::string>(&scheduler_name)->default_value("WSSimpleTaskScheduler"), "Name of the scheduler to use")
+  ("mergebudget,m", po::value<double>(&merge_budget)->default_value(0.0), "Fraction of time the background merge of deltas may take, 0 disables it");
   po::variables_map vm;
   po::store(po::parse_command_line(argc, argv, desc), vm);
   po::notify(vm);
@@ -162,6 +165,14 @@ int main(int argc, char *argv[]) {
     scheduler->resize(getNumberOfCoresOnSystem());
   }
 
+  std::unique_ptr<io::MergeDaemon> merge_daemon;
+  if (merge_budget > 0.0) {
+    io::MergePolicy policy;
+    policy.cpuBudget = merge_budget;
+    merge_daemon.reset(new io::MergeDaemon(policy));
+    merge_daemon->start();
+  }
+
   signal(SIGINT, &shutdown);
   // MainS erver Loop
   struct ev_loop *loop = ev_default_loop(0);
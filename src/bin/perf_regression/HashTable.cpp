@@ -0,0 +1,80 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest-bench.h>
+#include <gtest/gtest.h>
+#include <string>
+
+#include <access.h>
+#include <storage.h>
+#include <io.h>
+
+#include "storage/HashTable.h"
+
+namespace hyrise {
+namespace access {
+
+// Compares the open addressing hash tables with the node based ones on
+// the order line table, grouped like TPC-C orders (OL_W_ID, OL_D_ID, OL_O_ID)
+
+class HashTableBase : public ::testing::Benchmark {
+
+ protected:
+
+  StorageManager *sm;
+  storage::c_atable_ptr_t t;
+  field_list_t single_field;
+  field_list_t multi_fields;
+
+ public:
+
+  void BenchmarkSetUp() {
+    sm = StorageManager::getInstance();
+    t = sm->getTable("order_line");
+
+    single_field = {t->numberOfColumn("OL_I_ID")};
+    multi_fields = {t->numberOfColumn("OL_W_ID"), t->numberOfColumn("OL_D_ID"), t->numberOfColumn("OL_O_ID")};
+  }
+
+  void BenchmarkTearDown() {
+  }
+
+  HashTableBase() {
+    SetNumIterations(10);
+    SetWarmUp(2);
+  }
+
+  template <typename HT>
+  size_t buildAndProbe(const field_list_t &fields) {
+    HT ht(t, fields);
+    size_t matches = 0;
+    for (pos_t row = 0; row < t->size(); row += 16)
+      matches += ht.get(t, fields, row).size();
+    return matches;
+  }
+};
+
+BENCHMARK_F(HashTableBase, single_key_open_addressing) {
+  buildAndProbe<SingleAggregateHashTable>(single_field);
+}
+
+BENCHMARK_F(HashTableBase, single_key_node_based) {
+  buildAndProbe<NodeSingleAggregateHashTable>(single_field);
+}
+
+BENCHMARK_F(HashTableBase, multi_key_open_addressing) {
+  buildAndProbe<AggregateHashTable>(multi_fields);
+}
+
+BENCHMARK_F(HashTableBase, multi_key_node_based) {
+  buildAndProbe<NodeAggregateHashTable>(multi_fields);
+}
+
+BENCHMARK_F(HashTableBase, join_multi_key_open_addressing) {
+  buildAndProbe<JoinHashTable>(multi_fields);
+}
+
+BENCHMARK_F(HashTableBase, join_multi_key_node_based) {
+  buildAndProbe<NodeJoinHashTable>(multi_fields);
+}
+
+}
+}
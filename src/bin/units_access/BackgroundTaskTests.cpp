@@ -0,0 +1,35 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <atomic>
+#include <stdexcept>
+
+#include "testing/test.h"
+#include "taskscheduler/BackgroundTask.h"
+
+namespace hyrise {
+namespace access {
+
+TEST(BackgroundTaskTests, function_runs_once) {
+  std::atomic<int> runs(0);
+  BackgroundTask task([&runs]() { ++runs; });
+  EXPECT_FALSE(task.done());
+
+  task.wait();
+  task();
+  task.wait();
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(1, runs);
+
+  auto background = runInBackground([&runs]() { ++runs; });
+  background->wait();
+  EXPECT_EQ(2, runs);
+}
+
+TEST(BackgroundTaskTests, exception_is_rethrown_by_wait) {
+  BackgroundTask task([]() { throw std::runtime_error("merge failed"); });
+  task();
+  EXPECT_TRUE(task.done());
+  EXPECT_THROW(task.wait(), std::runtime_error);
+}
+
+}
+}
@@ -2,6 +2,7 @@
 #include "access/GroupByScan.h"
 #include "access/HashBuild.h"
 #include "io/shortcuts.h"
+#include "storage/Store.h"
 #include "testing/TableEqualityTest.h"
 #include "testing/test.h"
 
@@ -83,5 +84,51 @@ TEST_F(GroupByScanTests, group_by_with_aggregate_function) {
   EXPECT_RELATION_EQ(reference, result);
 }
 
+TEST_F(GroupByScanTests, group_by_with_min_and_max) {
+  auto t = Loader::shortcuts::load("test/10_30_group.tbl");
+  auto reference = Loader::shortcuts::load("test/10_30_group_min_max_result.tbl");
+
+  HashBuild hb;
+  hb.addInput(t);
+  hb.addField(1);
+  hb.setKey("groupby");
+  hb.execute();
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addFunction(new MinAggregateFun(0));
+  gs.addFunction(new MaxAggregateFun(2));
+  gs.addInputHash(hb.getResultHashTable());
+  gs.addField(1);
+  gs.execute();
+
+  EXPECT_RELATION_EQ(reference, gs.getResultTable());
+}
+
+TEST_F(GroupByScanTests, aggregates_over_main_and_delta) {
+  auto store = std::make_shared<Store>(Loader::shortcuts::load("test/groupby_xs_col.tbl"));
+  const auto &delta = store->getDeltaTable();
+  delta->resize(2);
+  const hyrise_int_t rows[2][4] = {{2015, 3, 5, 1}, {2009, 3, 50, 1}};
+  for (size_t row = 0; row < 2; ++row)
+    for (size_t column = 0; column < 4; ++column)
+      delta->setValue<hyrise_int_t>(column, row, rows[row][column]);
+
+  GroupByScan gs;
+  gs.addInput(store);
+  gs.addFunction(new SumAggregateFun(0));
+  gs.addFunction(new AverageAggregateFun(1));
+  gs.addFunction(new MinAggregateFun(2));
+  gs.addFunction(new MaxAggregateFun(0));
+  gs.execute();
+
+  const auto &result = gs.getResultTable();
+  ASSERT_EQ(1u, result->size());
+  EXPECT_EQ(48231, result->getValue<hyrise_int_t>(0, 0));
+  EXPECT_FLOAT_EQ(70.0f / 24, result->getValue<hyrise_float_t>(1, 0));
+  EXPECT_EQ(5, result->getValue<hyrise_int_t>(2, 0));
+  EXPECT_EQ(2015, result->getValue<hyrise_int_t>(3, 0));
+}
+
 }
 }
@@ -37,5 +37,39 @@ TEST_F(HashJoinProbeTests, DISABLED_basic_hash_join_probe_test) {
   EXPECT_RELATION_EQ(result, reference);
 }
 
+TEST_F(HashJoinProbeTests, value_id_join_matches_hashed_join) {
+  auto left = Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", "A|B|C\nINTEGER|STRING|FLOAT\n0_R|0_R|0_R");
+  auto right = Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", "D|E|F\nINTEGER|STRING|FLOAT\n0_R|0_R|0_R");
+
+  for (const field_t field : {0, 1, 2}) {
+    SCOPED_TRACE(field);
+    HashBuild hashed;
+    hashed.addInput(right);
+    hashed.addField(field);
+    hashed.setKey("join");
+    hashed.execute();
+
+    HashJoinProbe hashedProbe;
+    hashedProbe.addInput(left);
+    hashedProbe.addField(field);
+    hashedProbe.addInputHash(hashed.getResultHashTable());
+    hashedProbe.execute();
+
+    HashBuild valueIds;
+    valueIds.addInput(right);
+    valueIds.addField(field);
+    valueIds.setKey("valueid");
+    valueIds.execute();
+
+    HashJoinProbe valueIdProbe;
+    valueIdProbe.addInput(left);
+    valueIdProbe.addField(field);
+    valueIdProbe.addInputHash(valueIds.getResultHashTable());
+    valueIdProbe.execute();
+
+    EXPECT_RELATION_EQ(valueIdProbe.getResultTable(), hashedProbe.getResultTable());
+  }
+}
+
 }
 }
@@ -0,0 +1,104 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/InequalityJoin.h"
+#include "io/shortcuts.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/TableBuilder.h"
+#include "testing/test.h"
+
+#include <algorithm>
+
+namespace hyrise {
+namespace access {
+
+class InequalityJoinTests : public AccessTest {
+ protected:
+  typedef std::vector<std::pair<pos_t, pos_t>> pairs_t;
+
+  pairs_t joined(InequalityJoin &join) {
+    join.execute();
+    const auto &result = std::dynamic_pointer_cast<const MutableVerticalTable>(join.getResultTable());
+    const auto &left_pos = std::dynamic_pointer_cast<const PointerCalculator>(result->getContainer(0))->getPositions();
+    const auto &right_pos = std::dynamic_pointer_cast<const PointerCalculator>(result->getContainer(1))->getPositions();
+    EXPECT_EQ(left_pos->size(), right_pos->size());
+
+    pairs_t pairs;
+    for (size_t i = 0; i < left_pos->size(); ++i)
+      pairs.push_back(std::make_pair(left_pos->at(i), right_pos->at(i)));
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  }
+};
+
+TEST_F(InequalityJoinTests, band_join_matches_nested_loop) {
+  TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("a");
+  list.append().set_type("INTEGER").set_name("lo");
+  list.append().set_type("INTEGER").set_name("hi");
+  auto left = TableBuilder::build(list, false);
+  auto right = TableBuilder::build(list, false);
+
+  // enough left rows for several morsels
+  const size_t left_rows = 70000, right_rows = 300;
+  std::vector<hyrise_int_t> a(left_rows), lo(right_rows), hi(right_rows);
+  left->resize(left_rows);
+  for (size_t row = 0; row < left_rows; ++row) {
+    a[row] = (row * 7919) % 10007;
+    left->setValue<hyrise_int_t>(0, row, a[row]);
+    left->setValue<hyrise_int_t>(1, row, 0);
+    left->setValue<hyrise_int_t>(2, row, 0);
+  }
+  right->resize(right_rows);
+  for (size_t row = 0; row < right_rows; ++row) {
+    lo[row] = (row * 104729) % 10007;
+    hi[row] = lo[row] + row % 40;
+    right->setValue<hyrise_int_t>(0, row, 0);
+    right->setValue<hyrise_int_t>(1, row, lo[row]);
+    right->setValue<hyrise_int_t>(2, row, hi[row]);
+  }
+
+  pairs_t expected;
+  for (size_t l = 0; l < left_rows; ++l)
+    for (size_t r = 0; r < right_rows; ++r)
+      if (lo[r] <= a[l] && a[l] <= hi[r])
+        expected.push_back(std::make_pair(l, r));
+
+  InequalityJoin join;
+  join.addInput(left);
+  join.addInput(right);
+  join.addBetween(0, 1, 2);
+  const auto pairs = joined(join);
+  ASSERT_LT(0u, expected.size());
+  EXPECT_TRUE(expected == pairs);
+
+  // strict bounds
+  InequalityJoin strict;
+  strict.addInput(left);
+  strict.addInput(right);
+  strict.addPredicate(0, JoinComparison::LESS, 2);
+  strict.addPredicate(0, JoinComparison::GREATER, 1);
+  expected.erase(std::remove_if(expected.begin(), expected.end(), [&](const std::pair<pos_t, pos_t> &p) {
+        return a[p.first] == lo[p.second] || a[p.first] == hi[p.second];
+      }), expected.end());
+  EXPECT_TRUE(expected == joined(strict));
+}
+
+TEST_F(InequalityJoinTests, single_inequality_on_different_dictionaries) {
+  auto left = Loader::shortcuts::load("test/tables/employees.tbl");
+  auto right = Loader::shortcuts::load("test/tables/companies.tbl");
+
+  pairs_t expected;
+  for (size_t l = 0; l < left->size(); ++l)
+    for (size_t r = 0; r < right->size(); ++r)
+      if (left->getValue<hyrise_int_t>(1, l) >= right->getValue<hyrise_int_t>(0, r))
+        expected.push_back(std::make_pair(l, r));
+
+  InequalityJoin join;
+  join.addInput(left);
+  join.addInput(right);
+  join.addPredicate(1, JoinComparison::GREATER_EQUAL, 0);
+  EXPECT_TRUE(expected == joined(join));
+}
+
+}
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/HashBuild.h"
+#include "access/SimpleTableScan.h"
+#include "io/shortcuts.h"
+#include "storage/JoinFilter.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class JoinFilterTests : public AccessTest {};
+
+TEST_F(JoinFilterTests, scan_on_probe_input_skips_rows_without_partner) {
+  auto build = Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+  auto probe = Loader::shortcuts::load("test/10_30_group.tbl");
+
+  HashBuild hb;
+  hb.addInput(build);
+  hb.addField(0);
+  hb.setKey("join");
+  hb.setBuildJoinFilter(true);
+  hb.execute();
+
+  SimpleTableScan scan;
+  scan.addInput(probe);
+  scan.addInputHash(hb.getResultHashTable());
+  scan.setJoinFilterFields({0});
+  scan.execute();
+
+  // only col_0 = 0 of the probe table occurs in the build table
+  const auto &result = scan.getResultTable();
+  ASSERT_EQ(1u, result->size());
+  EXPECT_EQ(0, result->getValue<hyrise_int_t>(0, 0));
+}
+
+TEST_F(JoinFilterTests, shared_dictionary_filters_exactly) {
+  storage::atable_ptr_t table = Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+  // rows with A = 0
+  auto build = PointerCalculatorFactory::createPointerCalculatorNonRef(table, nullptr, new pos_list_t({0, 2, 3}));
+
+  JoinFilter filter(build, {0});
+  pos_list_t positions;
+  for (pos_t row = 0; row < table->size(); ++row)
+    positions.push_back(row);
+  filter.filter(table, {0}, positions);
+
+  EXPECT_EQ(pos_list_t({0, 2, 3}), positions);
+}
+
+}
+}
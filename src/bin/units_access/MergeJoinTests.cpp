@@ -0,0 +1,95 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MergeJoin.h"
+#include "io/shortcuts.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class MergeJoinTests : public AccessTest {
+ protected:
+  std::shared_ptr<const PointerCalculator> positions(const storage::c_atable_ptr_t &result, size_t input) {
+    return std::dynamic_pointer_cast<const PointerCalculator>(
+        std::dynamic_pointer_cast<const MutableVerticalTable>(result)->getContainer(input));
+  }
+
+  // Checks the join result of field against a nested loop over the values
+  template <typename T>
+  void expectJoined(const storage::c_atable_ptr_t &left, const storage::c_atable_ptr_t &right, field_t field) {
+    MergeJoin mj;
+    mj.addInput(left);
+    mj.addInput(right);
+    mj.addField(field);
+    mj.addField(field);
+    mj.execute();
+
+    const auto &left_pos = positions(mj.getResultTable(), 0)->getPositions();
+    const auto &right_pos = positions(mj.getResultTable(), 1)->getPositions();
+
+    size_t matches = 0;
+    for (size_t l = 0; l < left->size(); ++l)
+      for (size_t r = 0; r < right->size(); ++r)
+        matches += left->getValue<T>(field, l) == right->getValue<T>(field, r);
+
+    ASSERT_EQ(matches, left_pos->size());
+    ASSERT_EQ(matches, right_pos->size());
+    for (size_t i = 0; i < matches; ++i) {
+      EXPECT_EQ(left->getValue<T>(field, left_pos->at(i)), right->getValue<T>(field, right_pos->at(i)));
+      if (i > 0) {
+        EXPECT_LE(left->getValue<T>(field, left_pos->at(i - 1)), left->getValue<T>(field, left_pos->at(i)));
+      }
+    }
+  }
+};
+
+TEST_F(MergeJoinTests, joins_values_of_different_dictionaries) {
+  auto left = Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+  auto right = std::make_shared<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  const auto &delta = right->getDeltaTable();
+  delta->resize(2);
+  for (size_t row = 0; row < 2; ++row) {
+    delta->setValue<hyrise_int_t>(0, row, row);
+    delta->setValue<hyrise_string_t>(1, row, row ? "A" : "0");
+    delta->setValue<hyrise_float_t>(2, row, 3.0);
+  }
+
+  expectJoined<hyrise_int_t>(left, right, 0);
+  expectJoined<hyrise_string_t>(left, right, 1);
+  expectJoined<hyrise_float_t>(left, right, 2);
+}
+
+TEST_F(MergeJoinTests, merges_partitions_of_sorted_and_unsorted_inputs) {
+  auto left = Loader::shortcuts::load("test/reference/group_by_scan_using_table_2.tbl")->copy_structure_modifiable();
+  auto right = left->copy_structure_modifiable();
+  const size_t rows = 150000;
+  left->resize(rows);
+  right->resize(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    left->setValue<hyrise_int_t>(0, row, row / 3);
+    right->setValue<hyrise_int_t>(0, row, (row * 7) % 75000);
+  }
+
+  MergeJoin mj;
+  mj.addInput(left);
+  mj.addInput(right);
+  mj.addField(0);
+  mj.addField(0);
+  mj.execute();
+
+  // keys below 50000 appear three times left and twice right
+  const auto &left_pos = positions(mj.getResultTable(), 0)->getPositions();
+  const auto &right_pos = positions(mj.getResultTable(), 1)->getPositions();
+  ASSERT_EQ(300000u, left_pos->size());
+  for (size_t i = 0; i < left_pos->size(); ++i) {
+    ASSERT_EQ(left->getValue<hyrise_int_t>(0, left_pos->at(i)), right->getValue<hyrise_int_t>(0, right_pos->at(i)));
+    if (i > 0) {
+      ASSERT_LE(left_pos->at(i - 1), left_pos->at(i));
+    }
+  }
+}
+
+}
+}
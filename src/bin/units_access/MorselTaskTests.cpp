@@ -0,0 +1,43 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "testing/test.h"
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+TEST(MorselTaskTests, every_row_is_processed_once) {
+  const size_t size = 1000, morsel_size = 64;
+  std::vector<std::atomic<int>> visits(size);
+  for (auto& v : visits)
+    v = 0;
+  std::vector<size_t> morsel_starts(morselCount(size, morsel_size));
+
+  executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+      morsel_starts[morsel] = start;
+      for (size_t row = start; row < stop; ++row)
+        ++visits[row];
+    }, morsel_size);
+
+  ASSERT_EQ(16u, morsel_starts.size());
+  for (size_t morsel = 0; morsel < morsel_starts.size(); ++morsel)
+    EXPECT_EQ(morsel * morsel_size, morsel_starts[morsel]);
+  for (const auto& v : visits)
+    ASSERT_EQ(1, v);
+}
+
+TEST(MorselTaskTests, exception_is_rethrown_after_all_morsels) {
+  std::atomic<size_t> processed(0);
+  EXPECT_THROW(executeMorsels(100, [&](size_t morsel, size_t start, size_t stop) {
+        ++processed;
+        if (morsel == 3)
+          throw std::runtime_error("morsel failed");
+      }, 10), std::runtime_error);
+  EXPECT_EQ(10u, processed);
+}
+
+}
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/GroupByScan.h"
+#include "access/HashBuild.h"
+#include "access/ParallelGroupByScan.h"
+#include "io/shortcuts.h"
+#include "testing/TableEqualityTest.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class ParallelGroupByScanTests : public AccessTest {};
+
+namespace {
+
+storage::c_atable_ptr_t groupByWithHashBuild(const storage::c_atable_ptr_t &t,
+                                             const std::vector<field_t> &fields,
+                                             const std::vector<AggregateFun *> &functions) {
+  HashBuild hb;
+  hb.addInput(t);
+  for (const auto &field : fields)
+    hb.addField(field);
+  hb.setKey("groupby");
+  hb.execute();
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addInputHash(hb.getResultHashTable());
+  for (const auto &field : fields)
+    gs.addField(field);
+  for (const auto &function : functions)
+    gs.addFunction(function);
+  gs.execute();
+  return gs.getResultTable();
+}
+
+}
+
+TEST_F(ParallelGroupByScanTests, matches_group_by_scan_across_morsels) {
+  auto t = Loader::shortcuts::load("test/10_30_group.tbl");
+
+  ParallelGroupByScan gs;
+  gs.addInput(t);
+  gs.addField(1);
+  gs.addFunction(new CountAggregateFun(0));
+  gs.addFunction(new SumAggregateFun(2));
+  gs.addFunction(new AverageAggregateFun(3));
+  gs.setMorselSize(3);
+  gs.execute();
+
+  auto reference = groupByWithHashBuild(t, {1}, {new CountAggregateFun(0), new SumAggregateFun(2), new AverageAggregateFun(3)});
+
+  EXPECT_RELATION_EQ(reference, gs.getResultTable());
+}
+
+TEST_F(ParallelGroupByScanTests, float_aggregates_on_multiple_fields) {
+  auto t = Loader::shortcuts::load("test/join_transactions.tbl");
+
+  ParallelGroupByScan gs;
+  gs.addInput(t);
+  gs.addField(0);
+  gs.addField(1);
+  gs.addFunction(new SumAggregateFun(2));
+  gs.addFunction(new AverageAggregateFun(2));
+  gs.setMorselSize(2);
+  gs.execute();
+
+  auto reference = groupByWithHashBuild(t, {0, 1}, {new SumAggregateFun(2), new AverageAggregateFun(2)});
+
+  EXPECT_RELATION_EQ(reference, gs.getResultTable());
+}
+
+TEST_F(ParallelGroupByScanTests, min_max_across_morsels) {
+  auto t = Loader::shortcuts::load("test/join_transactions.tbl");
+
+  ParallelGroupByScan gs;
+  gs.addInput(t);
+  gs.addField(0);
+  gs.addFunction(new MinAggregateFun(2));
+  gs.addFunction(new MaxAggregateFun(1));
+  gs.addFunction(new CountAggregateFun(2));
+  gs.setMorselSize(2);
+  gs.execute();
+
+  auto reference = groupByWithHashBuild(t, {0}, {new MinAggregateFun(2), new MaxAggregateFun(1), new CountAggregateFun(2)});
+
+  EXPECT_RELATION_EQ(reference, gs.getResultTable());
+}
+
+TEST_F(ParallelGroupByScanTests, sum_of_strings_fails) {
+  auto t = Loader::shortcuts::load("test/join_transactions.tbl");
+
+  ParallelGroupByScan gs;
+  gs.addInput(t);
+  gs.addField(0);
+  gs.addFunction(new SumAggregateFun(1));
+  ASSERT_THROW(gs.execute(), std::runtime_error);
+}
+
+}
+}
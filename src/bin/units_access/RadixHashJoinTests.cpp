@@ -0,0 +1,77 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/RadixHashJoin.h"
+#include "io/shortcuts.h"
+#include "testing/TableEqualityTest.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class RadixHashJoinTests : public AccessTest {
+public:
+  storage::c_atable_ptr_t left, right;
+
+  RadixHashJoinTests() {
+    left = Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", "A|B|C\nINTEGER|STRING|FLOAT\n0_R|0_R|0_R");
+    right = Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", "D|E|F\nINTEGER|STRING|FLOAT\n0_R|0_R|0_R");
+  }
+};
+
+TEST_F(RadixHashJoinTests, join_on_integer_field) {
+  auto reference = Loader::shortcuts::loadWithStringHeader("test/reference/hash_table_test_int.tbl",
+                                                           "A|B|C|D|E|F\nINTEGER|STRING|FLOAT|INTEGER|STRING|FLOAT\n0_R|0_R|0_R|0_R|0_R|0_R");
+
+  RadixHashJoin join;
+  join.addInput(left);
+  join.addInput(right);
+  join.addField(0);
+  join.addField(0);
+  join.execute();
+
+  EXPECT_RELATION_EQ(join.getResultTable(), reference);
+}
+
+TEST_F(RadixHashJoinTests, partitioned_join_matches_unpartitioned) {
+  RadixHashJoin unpartitioned;
+  unpartitioned.addInput(left);
+  unpartitioned.addInput(right);
+  unpartitioned.addField(1);
+  unpartitioned.addField(1);
+  unpartitioned.setBits(0);
+  unpartitioned.execute();
+
+  RadixHashJoin partitioned;
+  partitioned.addInput(left);
+  partitioned.addInput(right);
+  partitioned.addField(1);
+  partitioned.addField(1);
+  partitioned.setBits(3);
+  partitioned.setMorselSize(3);
+  partitioned.execute();
+
+  // A appears 4 times, B 3 times and C once in the join field
+  ASSERT_EQ(26u, unpartitioned.getResultTable()->size());
+  EXPECT_RELATION_EQ(partitioned.getResultTable(), unpartitioned.getResultTable());
+}
+
+TEST_F(RadixHashJoinTests, rejects_too_many_radix_bits) {
+  RadixHashJoin join;
+  EXPECT_NO_THROW(join.setBits(12));
+  EXPECT_THROW(join.setBits(13), std::runtime_error);
+  EXPECT_THROW(join.setBits(64), std::runtime_error);
+
+  Json::Value data;
+  data["fields"].append(0);
+  data["fields"].append(0);
+  data["bits"] = 40;
+  EXPECT_THROW(RadixHashJoin::parse(data), std::runtime_error);
+}
+
+TEST_F(RadixHashJoinTests, radix_bits_grow_with_build_size) {
+  EXPECT_EQ(0u, RadixHashJoin::radixBits(100));
+  EXPECT_LE(RadixHashJoin::radixBits(1000), RadixHashJoin::radixBits(100000000));
+  EXPECT_LT(0u, RadixHashJoin::radixBits(100000000));
+}
+
+}
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/HashBuild.h"
+#include "access/SemiJoin.h"
+#include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class SemiJoinTests : public AccessTest {
+ protected:
+  storage::c_ahashtable_ptr_t build(const storage::c_atable_ptr_t &table, field_t field, const std::string &key) {
+    HashBuild hb;
+    hb.addInput(table);
+    hb.addField(field);
+    hb.setKey(key);
+    hb.execute();
+    return hb.getResultHashTable();
+  }
+
+  pos_list_t probe(SemiJoin &join, const storage::c_ahashtable_ptr_t &hash_table, const storage::c_atable_ptr_t &table, field_t field) {
+    join.addInputHash(hash_table);
+    join.addInput(table);
+    join.addField(field);
+    join.execute();
+    return *std::dynamic_pointer_cast<const PointerCalculator>(join.getResultTable())->getPositions();
+  }
+};
+
+TEST_F(SemiJoinTests, hashed_and_value_id_probes_return_each_row_once) {
+  // the build side holds company 3 twice and company 5 that no employee has
+  auto build_table = std::make_shared<Store>(Loader::shortcuts::load("test/tables/companies_apple_only.tbl"));
+  const auto &delta = build_table->getDeltaTable();
+  delta->resize(3);
+  for (size_t row = 0; row < 3; ++row) {
+    delta->setValue<hyrise_int_t>(0, row, row == 2 ? 5 : 3);
+    delta->setValue<hyrise_string_t>(1, row, "x");
+  }
+  auto probe_table = Loader::shortcuts::load("test/tables/employees.tbl");
+
+  pos_list_t expected_semi, expected_anti;
+  for (pos_t row = 0; row < probe_table->size(); ++row) {
+    const auto company = probe_table->getValue<hyrise_int_t>(1, row);
+    (company == 1 || company == 3 ? expected_semi : expected_anti).push_back(row);
+  }
+
+  for (const std::string key : {"join", "valueid"}) {
+    SCOPED_TRACE(key);
+    const auto hash_table = build(build_table, 0, key);
+
+    SemiJoin semi;
+    EXPECT_EQ(expected_semi, probe(semi, hash_table, probe_table, 1));
+
+    AntiJoin anti;
+    EXPECT_EQ(expected_anti, probe(anti, hash_table, probe_table, 1));
+  }
+}
+
+TEST_F(SemiJoinTests, value_id_probe_spans_several_morsels) {
+  auto build_table = Loader::shortcuts::load("test/tables/companies.tbl");
+  auto probe_table = Loader::shortcuts::load("test/reference/group_by_scan_using_table_2.tbl")->copy_structure_modifiable();
+  const size_t rows = 150000;
+  probe_table->resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    probe_table->setValue<hyrise_int_t>(0, row, row % 10);
+
+  SemiJoin semi;
+  const auto positions = probe(semi, build(build_table, 0, "valueid"), probe_table, 0);
+  ASSERT_EQ(rows * 4 / 10, positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const auto value = probe_table->getValue<hyrise_int_t>(0, positions[i]);
+    ASSERT_TRUE(value >= 1 && value <= 4);
+    if (i > 0) {
+      ASSERT_LT(positions[i - 1], positions[i]);
+    }
+  }
+}
+
+}
+}
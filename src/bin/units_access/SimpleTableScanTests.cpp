@@ -1,7 +1,13 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/SimpleTableScan.h"
+#include "access/UnitePositions.h"
 #include "access/predicates.h"
 #include "io/shortcuts.h"
+#include "storage/ChunkedTable.h"
+#include "storage/FrontCodedDictionary.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "storage/ZoneMap.h"
 #include "testing/test.h"
 
 namespace hyrise {
@@ -24,5 +30,281 @@ TEST_F(SimpleTableScanTests, basic_simple_table_scan_test) {
   ASSERT_EQ(100, result->getValue<storage::hyrise_int_t>(0, 0));
 }
 
+TEST_F(SimpleTableScanTests, block_evaluation_spans_multiple_blocks) {
+  storage::c_atable_ptr_t t = Loader::shortcuts::load("test/test10k_12.tbl");
+  auto expr = new CompoundExpression(new BetweenExpression<storage::hyrise_int_t>(t, 0, 1000, 150000),
+                                     new CompoundExpression(new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 100001), nullptr, NOT),
+                                     AND);
+
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(expr);
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+
+  ASSERT_EQ(4951u, result->size());
+  ASSERT_EQ(1000, result->getValue<storage::hyrise_int_t>(0, 0));
+  ASSERT_EQ(100000, result->getValue<storage::hyrise_int_t>(0, result->size() - 1));
+
+  // Block-wise evaluation has to agree with the row-wise operator
+  for (size_t row = 0; row < t->size(); ++row) {
+    bool in_result = (row >= 50) && (row < 50 + result->size());
+    ASSERT_EQ(in_result, (*expr)(row));
+  }
+}
+
+TEST_F(SimpleTableScanTests, position_scan_covers_main_and_delta) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/test10k_12.tbl"));
+  s->getDeltaTable()->resize(2);
+  s->getDeltaTable()->setValue<storage::hyrise_int_t>(0, 0, 1500);
+  s->getDeltaTable()->setValue<storage::hyrise_int_t>(0, 1, 999);
+  storage::c_atable_ptr_t t = s;
+
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(new BetweenExpression<storage::hyrise_int_t>(t, 0, 1000, 1500));
+  sts.setProducesPositions(true);
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+
+  ASSERT_EQ(27u, result->size());
+  ASSERT_EQ(1000, result->getValue<storage::hyrise_int_t>(0, 0));
+  ASSERT_EQ(1500, result->getValue<storage::hyrise_int_t>(0, 25));
+  ASSERT_EQ(1500, result->getValue<storage::hyrise_int_t>(0, 26));
+}
+
+TEST_F(SimpleTableScanTests, less_than_compares_delta_rows_by_value) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/test10k_12.tbl"));
+  s->getDeltaTable()->resize(2);
+  s->getDeltaTable()->setValue<storage::hyrise_int_t>(0, 0, 999999);
+  s->getDeltaTable()->setValue<storage::hyrise_int_t>(0, 1, 1);
+  storage::c_atable_ptr_t t = s;
+
+  // the delta value ids are small but belong to the delta dictionary
+  auto expr = new LessThanExpression<storage::hyrise_int_t>(t, 0, 1500);
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(expr);
+  sts.setProducesPositions(true);
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+  ASSERT_EQ(76u, result->size());
+  EXPECT_EQ(1480, result->getValue<storage::hyrise_int_t>(0, 74));
+  EXPECT_EQ(1, result->getValue<storage::hyrise_int_t>(0, 75));
+  EXPECT_FALSE((*expr)(t->size() - 2));
+  EXPECT_TRUE((*expr)(t->size() - 1));
+}
+
+TEST_F(SimpleTableScanTests, range_scan_uses_zone_maps_of_all_main_generations) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/test10k_12.tbl"));
+  s->setMerger(new TableMerger(new LogarithmicMergeStrategy(4), new SequentialHeapMerger()));
+  for (storage::hyrise_int_t value : {1490, 1510, 5}) {
+    const auto &delta = s->getDeltaTable();
+    delta->resize(1);
+    for (size_t column = 0; column < delta->columnCount(); ++column)
+      delta->setValue<storage::hyrise_int_t>(column, 0, value);
+    if (value != 5)
+      s->merge();
+  }
+
+  std::vector<std::shared_ptr<const ZoneMap>> zone_maps;
+  ASSERT_EQ(3u, s->getMainTables(zone_maps).size());
+  for (const auto &zone_map : zone_maps)
+    ASSERT_TRUE(zone_map != nullptr);
+
+  storage::c_atable_ptr_t t = s;
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(new BetweenExpression<storage::hyrise_int_t>(t, 0, 1000, 1500));
+  sts.setProducesPositions(true);
+  sts.execute();
+
+  // 26 rows of the first main and 1490 of the second match
+  const auto &result = sts.getResultTable();
+  ASSERT_EQ(27u, result->size());
+  EXPECT_EQ(1490, result->getValue<storage::hyrise_int_t>(0, 26));
+
+  SimpleTableScan lower;
+  lower.addInput(t);
+  lower.setPredicate(new LessThanExpression<storage::hyrise_int_t>(t, 0, 20));
+  lower.setProducesPositions(true);
+  lower.execute();
+  ASSERT_EQ(2u, lower.getResultTable()->size());
+  EXPECT_EQ(5, lower.getResultTable()->getValue<storage::hyrise_int_t>(0, 1));
+}
+
+TEST_F(SimpleTableScanTests, prefix_scan_on_front_coded_main_and_delta) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/tables/employees.tbl"));
+  s->setMerger(new TableMerger(new LogarithmicMergeStrategy(0), new SequentialHeapMerger()));
+  for (const storage::hyrise_string_t name : {"Steve Wozniak", "Stella"}) {
+    const auto &delta = s->getDeltaTable();
+    delta->resize(1);
+    delta->setValue<storage::hyrise_int_t>(0, 0, 7);
+    delta->setValue<storage::hyrise_int_t>(1, 0, 5);
+    delta->setValue<storage::hyrise_string_t>(2, 0, name);
+    if (name != "Stella")
+      s->merge();
+  }
+  ASSERT_TRUE(std::dynamic_pointer_cast<FrontCodedDictionary>(s->getMainTables()[0]->dictionaryAt(2)) != nullptr);
+
+  storage::c_atable_ptr_t t = s;
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(new PrefixExpression(t, 2, "Ste"));
+  sts.setProducesPositions(true);
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+  ASSERT_EQ(4u, result->size());
+  EXPECT_EQ("Steve Jobs", result->getValue<storage::hyrise_string_t>(2, 0));
+  EXPECT_EQ("Steve Wozniak", result->getValue<storage::hyrise_string_t>(2, 2));
+  EXPECT_EQ("Stella", result->getValue<storage::hyrise_string_t>(2, 3));
+}
+
+TEST_F(SimpleTableScanTests, scan_on_chunked_table_skips_sealed_chunks) {
+  ColumnMetadata a("a", IntegerType);
+  auto chunked = std::make_shared<ChunkedTable>(std::vector<const ColumnMetadata *> {&a}, nullptr, 1024);
+  chunked->resize(3000);
+  for (size_t row = 0; row < 3000; ++row)
+    chunked->setValue<storage::hyrise_int_t>(0, row, row / 100);
+  chunked->seal();
+
+  storage::c_atable_ptr_t t = chunked;
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(new EqualsExpression<storage::hyrise_int_t>(t, 0, 25));
+  sts.setProducesPositions(true);
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+  ASSERT_EQ(100u, result->size());
+  EXPECT_EQ(25, result->getValue<storage::hyrise_int_t>(0, 0));
+  EXPECT_EQ(25, result->getValue<storage::hyrise_int_t>(0, 99));
+}
+
+TEST_F(SimpleTableScanTests, run_length_encoded_chunks_match_whole_runs) {
+  ColumnMetadata a("a", IntegerType);
+  auto chunked = std::make_shared<ChunkedTable>(std::vector<const ColumnMetadata *> {&a}, nullptr, 1024);
+  chunked->resize(2048);
+  for (size_t row = 0; row < 2048; ++row)
+    chunked->setValue<storage::hyrise_int_t>(0, row, row / 100);
+  chunked->seal();
+  storage::c_atable_ptr_t t = chunked;
+
+  SimpleTableScan within;
+  within.addInput(t);
+  within.setPredicate(new EqualsExpression<storage::hyrise_int_t>(t, 0, 5));
+  within.setProducesPositions(true);
+  within.execute();
+  const auto withinRows = std::dynamic_pointer_cast<const PointerCalculator>(within.getResultTable());
+  ASSERT_TRUE(withinRows != nullptr);
+  EXPECT_TRUE(withinRows->isRange());
+  ASSERT_EQ(100u, withinRows->size());
+  EXPECT_EQ(5, withinRows->getValue<storage::hyrise_int_t>(0, 99));
+
+  // a run that spans two chunks is joined into one range
+  SimpleTableScan across;
+  across.addInput(t);
+  across.setPredicate(new EqualsExpression<storage::hyrise_int_t>(t, 0, 10));
+  across.setProducesPositions(true);
+  across.execute();
+  const auto acrossRows = std::dynamic_pointer_cast<const PointerCalculator>(across.getResultTable());
+  ASSERT_TRUE(acrossRows != nullptr);
+  EXPECT_TRUE(acrossRows->isRange());
+  ASSERT_EQ(100u, acrossRows->size());
+  EXPECT_EQ(10, acrossRows->getValue<storage::hyrise_int_t>(0, 0));
+}
+
+TEST_F(SimpleTableScanTests, range_scans_on_sealed_chunks_use_their_ordered_dictionaries) {
+  ColumnMetadata a("a", IntegerType);
+  auto chunked = std::make_shared<ChunkedTable>(std::vector<const ColumnMetadata *> {&a}, nullptr, 1024);
+  chunked->resize(3000);
+  // descending values get descending value ids in the shared dictionary
+  for (size_t row = 0; row < 3000; ++row)
+    chunked->setValue<storage::hyrise_int_t>(0, row, (2999 - row) / 100);
+  chunked->seal();
+  storage::c_atable_ptr_t t = chunked;
+
+  SimpleTableScan less;
+  less.addInput(t);
+  less.setPredicate(new LessThanExpression<storage::hyrise_int_t>(t, 0, 5));
+  less.setProducesPositions(true);
+  less.execute();
+  const auto &lessRows = less.getResultTable();
+  ASSERT_EQ(500u, lessRows->size());
+  EXPECT_EQ(4, lessRows->getValue<storage::hyrise_int_t>(0, 0));
+  EXPECT_EQ(0, lessRows->getValue<storage::hyrise_int_t>(0, 499));
+
+  SimpleTableScan between;
+  between.addInput(t);
+  between.setPredicate(new BetweenExpression<storage::hyrise_int_t>(t, 0, 10, 12));
+  between.setProducesPositions(true);
+  between.execute();
+  const auto &betweenRows = between.getResultTable();
+  ASSERT_EQ(300u, betweenRows->size());
+  EXPECT_EQ(12, betweenRows->getValue<storage::hyrise_int_t>(0, 0));
+  EXPECT_EQ(10, betweenRows->getValue<storage::hyrise_int_t>(0, 299));
+
+  // bounds missing from the dictionary
+  SimpleTableScan greater;
+  greater.addInput(t);
+  greater.setPredicate(new GreaterThanExpression<storage::hyrise_int_t>(t, 0, -1));
+  greater.setProducesPositions(true);
+  greater.execute();
+  EXPECT_EQ(3000u, greater.getResultTable()->size());
+
+  // a written chunk is matched by value, the sealed ones after it by range
+  chunked->setValue<storage::hyrise_int_t>(0, 0, 3);
+  SimpleTableScan written;
+  written.addInput(t);
+  written.setPredicate(new LessThanExpression<storage::hyrise_int_t>(t, 0, 5));
+  written.setProducesPositions(true);
+  written.execute();
+  const auto &writtenRows = written.getResultTable();
+  ASSERT_EQ(501u, writtenRows->size());
+  EXPECT_EQ(3, writtenRows->getValue<storage::hyrise_int_t>(0, 0));
+
+  SimpleTableScan equals;
+  equals.addInput(t);
+  equals.setPredicate(new EqualsExpression<storage::hyrise_int_t>(t, 0, 3));
+  equals.setProducesPositions(true);
+  equals.execute();
+  EXPECT_EQ(101u, equals.getResultTable()->size());
+}
+
+TEST_F(SimpleTableScanTests, dense_positions_are_ranges_and_bitmaps) {
+  storage::c_atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  SimpleTableScan high;
+  high.addInput(t);
+  high.setPredicate(new GreaterThanExpression<storage::hyrise_int_t>(t, 0, 500));
+  high.setProducesPositions(true);
+  high.execute();
+  const auto highRows = std::dynamic_pointer_cast<const PointerCalculator>(high.getResultTable());
+  ASSERT_TRUE(highRows != nullptr);
+  EXPECT_TRUE(highRows->isRange());
+  EXPECT_EQ(49u, highRows->size());
+
+  SimpleTableScan low;
+  low.addInput(t);
+  low.setPredicate(new LessThanExpression<storage::hyrise_int_t>(t, 0, 100));
+  low.setProducesPositions(true);
+  low.execute();
+
+  UnitePositions unite;
+  unite.addInput(high.getResultTable());
+  unite.addInput(low.getResultTable());
+  unite.execute();
+  const auto rows = std::dynamic_pointer_cast<const PointerCalculator>(unite.getResultTable());
+  ASSERT_TRUE(rows != nullptr);
+  EXPECT_TRUE(rows->isBitmap());
+  ASSERT_EQ(59u, rows->size());
+  EXPECT_EQ(90, rows->getValue<storage::hyrise_int_t>(0, 9));
+  EXPECT_EQ(510, rows->getValue<storage::hyrise_int_t>(0, 10));
+}
+
 }
 }
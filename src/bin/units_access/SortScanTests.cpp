@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/SortScan.h"
 #include "io/shortcuts.h"
+#include "storage/Store.h"
 #include "testing/test.h"
 
 namespace hyrise {
@@ -22,5 +23,74 @@ TEST_F(SortScanTests, basic_sort_scan_test) {
   ASSERT_TRUE(result->contentEquals(reference));
 }
 
+TEST_F(SortScanTests, sorts_by_several_fields_of_main_and_delta) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/tables/employees.tbl"));
+  const auto &delta = s->getDeltaTable();
+  delta->resize(2);
+  delta->setValue<hyrise_int_t>(0, 0, 7);
+  delta->setValue<hyrise_int_t>(1, 0, 3);
+  delta->setValue<hyrise_string_t>(2, 0, "Anna");
+  delta->setValue<hyrise_int_t>(0, 1, 8);
+  delta->setValue<hyrise_int_t>(1, 1, 4);
+  delta->setValue<hyrise_string_t>(2, 1, "Zoe");
+
+  SortScan ss;
+  ss.addInput(s);
+  ss.addSortField(1, false);
+  ss.addSortField(2);
+  ss.setProducesPositions(true);
+  ss.execute();
+
+  const auto &result = ss.getResultTable();
+  const std::vector<hyrise_string_t> names {"Jeffrey O. Henley", "Larry Page", "Zoe", "Anna", "Bill McDermott",
+      "Vishall Sikkha", "Steve Balmer", "Steve Jobs"};
+  ASSERT_EQ(names.size(), result->size());
+  for (size_t row = 0; row < names.size(); ++row)
+    EXPECT_EQ(names[row], result->getValue<hyrise_string_t>(2, row));
+}
+
+TEST_F(SortScanTests, sorts_delta_values_contained_in_the_main) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/tables/employees.tbl"));
+  const auto &delta = s->getDeltaTable();
+  delta->resize(1);
+  delta->setValue<hyrise_int_t>(0, 0, 7);
+  delta->setValue<hyrise_int_t>(1, 0, 3);
+  delta->setValue<hyrise_string_t>(2, 0, "Steve Jobs");
+
+  SortScan ss;
+  ss.addInput(s);
+  ss.addSortField(2, false);
+  ss.setProducesPositions(true);
+  ss.execute();
+
+  const auto &result = ss.getResultTable();
+  ASSERT_EQ(s->size(), result->size());
+  EXPECT_EQ("Vishall Sikkha", result->getValue<hyrise_string_t>(2, 0));
+  EXPECT_EQ("Steve Jobs", result->getValue<hyrise_string_t>(2, 1));
+  EXPECT_EQ("Steve Jobs", result->getValue<hyrise_string_t>(2, 2));
+  for (size_t row = 1; row < result->size(); ++row)
+    ASSERT_GE(result->getValue<hyrise_string_t>(2, row - 1), result->getValue<hyrise_string_t>(2, row));
+}
+
+TEST_F(SortScanTests, radix_sort_spans_several_morsels) {
+  auto t = Loader::shortcuts::load("test/reference/group_by_scan_using_table_2.tbl")->copy_structure_modifiable();
+  const size_t rows = 200000;
+  t->resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    t->setValue<hyrise_int_t>(0, row, (row * 7919) % 100003);
+
+  SortScan ss;
+  ss.addInput(t);
+  ss.addSortField(0, false);
+  ss.setProducesPositions(true);
+  ss.execute();
+
+  const auto &result = ss.getResultTable();
+  ASSERT_EQ(rows, result->size());
+  EXPECT_EQ(100002, result->getValue<hyrise_int_t>(0, 0));
+  for (size_t row = 1; row < rows; ++row)
+    ASSERT_GE(result->getValue<hyrise_int_t>(0, row - 1), result->getValue<hyrise_int_t>(0, row));
+}
+
 }
 }
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/TableLoad.h"
 #include "io/shortcuts.h"
+#include "storage/ChunkedTable.h"
 #include "storage/RawTable.h"
 #include "testing/test.h"
 
@@ -81,5 +82,23 @@ TEST_F(TableLoadTests, table_load_with_header_file_test) {
   ASSERT_TRUE(result->contentEquals(t));
 }
 
+TEST_F(TableLoadTests, table_load_into_chunks_test) {
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  TableLoad tl;
+  tl.setFileName("lin_xxs.tbl");
+  tl.setTableName("myTable6");
+  tl.setChunkSize(32);
+  tl.execute();
+
+  const auto &result = tl.getResultTable();
+  const auto chunked = std::dynamic_pointer_cast<const ChunkedTable>(result);
+  ASSERT_TRUE(chunked != nullptr);
+  EXPECT_EQ(4u, chunked->chunkCount());
+  EXPECT_TRUE(chunked->chunk(0)->dictionaryAt(0)->isOrdered());
+  EXPECT_FALSE(chunked->chunk(3)->dictionaryAt(0)->isOrdered());
+  ASSERT_TRUE(result->contentEquals(t));
+}
+
 }
 }
@@ -0,0 +1,66 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/SortScan.h"
+#include "access/TopK.h"
+#include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class TopKTests : public AccessTest {};
+
+TEST_F(TopKTests, returns_first_rows_of_main_and_delta) {
+  auto s = std::make_shared<Store>(Loader::shortcuts::load("test/tables/employees.tbl"));
+  const auto &delta = s->getDeltaTable();
+  delta->resize(1);
+  delta->setValue<hyrise_int_t>(0, 0, 7);
+  delta->setValue<hyrise_int_t>(1, 0, 4);
+  delta->setValue<hyrise_string_t>(2, 0, "Anna");
+
+  TopK tk;
+  tk.addInput(s);
+  tk.addSortField(1, false);
+  tk.addSortField(2);
+  tk.setLimit(3);
+  tk.execute();
+
+  const auto &result = tk.getResultTable();
+  ASSERT_TRUE(std::dynamic_pointer_cast<const PointerCalculator>(result) != nullptr);
+  const std::vector<hyrise_string_t> names {"Anna", "Jeffrey O. Henley", "Larry Page"};
+  ASSERT_EQ(names.size(), result->size());
+  for (size_t row = 0; row < names.size(); ++row)
+    EXPECT_EQ(names[row], result->getValue<hyrise_string_t>(2, row));
+}
+
+TEST_F(TopKTests, matches_sort_scan_over_several_morsels) {
+  auto t = Loader::shortcuts::load("test/reference/group_by_scan_using_table_2.tbl")->copy_structure_modifiable();
+  const size_t rows = 200000;
+  t->resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    t->setValue<hyrise_int_t>(0, row, (row * 7919) % 1009);
+
+  TopK tk;
+  tk.addInput(t);
+  tk.addSortField(0, false);
+  tk.setLimit(50);
+  tk.execute();
+
+  SortScan ss;
+  ss.addInput(t);
+  ss.addSortField(0, false);
+  ss.setProducesPositions(true);
+  ss.execute();
+
+  // rows with equal keys keep their input order like in the sort
+  const auto &result = std::dynamic_pointer_cast<const PointerCalculator>(tk.getResultTable());
+  const auto &sorted = std::dynamic_pointer_cast<const PointerCalculator>(ss.getResultTable());
+  ASSERT_EQ(50u, result->size());
+  EXPECT_EQ(1008, result->getValue<hyrise_int_t>(0, 0));
+  for (size_t row = 0; row < 50; ++row)
+    EXPECT_EQ(sorted->getPositions()->at(row), result->getPositions()->at(row));
+}
+
+}
+}
@@ -5,6 +5,8 @@
 #include "access/SetTable.h"
 
 #include "io/shortcuts.h"
+#include "storage/BaseDictionary.h"
+#include "storage/Store.h"
 
 namespace hyrise {
 namespace access {
@@ -29,8 +31,42 @@ TEST_F(GetSetTests, basic_set) {
 TEST_F(GetSetTests, basic_get) {
   StorageManager::getInstance()->loadTable("new_table", _table);
   GetTable gt("new_table");
-  ASSERT_EQ(_table, gt.execute()->getResultTable())
-      << "Result table should be equal to the one loaded prior to operation";
+  const auto result = std::dynamic_pointer_cast<const Store>(gt.execute()->getResultTable());
+  ASSERT_TRUE(result != nullptr);
+  ASSERT_EQ(std::dynamic_pointer_cast<const Store>(_table)->getMainTables(), result->getMainTables())
+      << "Result table should be a snapshot of the one loaded prior to operation";
+}
+
+TEST_F(GetSetTests, get_pins_store_across_merge) {
+  auto store = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  ASSERT_TRUE(store != nullptr);
+  {
+    auto deltaLock = store->lockDelta();
+    const auto &delta = store->getDeltaTable();
+    delta->resize(2);
+    for (size_t row = 0; row < 2; ++row) {
+      delta->setValue<hyrise_int_t>(0, row, 3);
+      delta->setValue<hyrise_string_t>(1, row, row == 0 ? "D" : "A");
+      delta->setValue<hyrise_float_t>(2, row, 0.5f);
+    }
+  }
+  StorageManager::getInstance()->loadTable("new_table", store);
+
+  GetTable gt("new_table");
+  const auto table = gt.execute()->getResultTable();
+  std::vector<ValueId> value_ids(table->size());
+  table->getValueIds(1, 0, table->size(), value_ids.data());
+
+  // renumbers the partitions of the live store between reading the value ids and decoding them
+  store->merge();
+  ASSERT_EQ(1u, store->getMainTables().size());
+
+  const std::vector<hyrise_string_t> expected {"A", "B", "A", "B", "A", "C", "A", "B", "D", "A"};
+  ASSERT_EQ(expected.size(), value_ids.size());
+  for (size_t row = 0; row < value_ids.size(); ++row) {
+    const auto dict = std::dynamic_pointer_cast<BaseDictionary<hyrise_string_t> >(table->dictionaryByTableId(1, value_ids[row].table));
+    EXPECT_EQ(expected[row], dict->getValueForValueId(value_ids[row].valueId)) << "row " << row;
+  }
 }
 
 TEST_F(GetSetTests, get_fails) {
@@ -0,0 +1,84 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <io/MergeDaemon.h>
+#include <io/StorageManager.h>
+#include <io/shortcuts.h>
+#include <storage/Store.h>
+
+namespace hyrise {
+namespace io {
+
+class MergeDaemonTests : public ::hyrise::Test {
+ public:
+  virtual void SetUp() {
+    StorageManager::getInstance()->removeAll();
+  }
+
+  virtual void TearDown() {
+    StorageManager::getInstance()->removeAll();
+  }
+
+  std::shared_ptr<Store> storeWithDelta(const size_t deltaRows) {
+    auto store = std::make_shared<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+    auto deltaLock = store->lockDelta();
+    const auto &delta = store->getDeltaTable();
+    delta->resize(deltaRows);
+    for (size_t row = 0; row < deltaRows; ++row) {
+      delta->setValue<hyrise_int_t>(0, row, row);
+      delta->setValue<hyrise_string_t>(1, row, "D");
+      delta->setValue<hyrise_float_t>(2, row, 0.5f);
+    }
+    return store;
+  }
+};
+
+TEST_F(MergeDaemonTests, thresholds) {
+  MergePolicy policy;
+  policy.minDeltaRows = 2;
+  policy.maxDeltaRows = 100;
+  policy.maxDeltaDictionarySize = 100;
+  policy.maxScanPenalty = 1.0;
+
+  DeltaStatistics statistics;
+  statistics.mainRows = 1000;
+  statistics.deltaRows = 10;
+  statistics.deltaDictionarySize = 10;
+  statistics.scanPenalty = 0.1;
+  EXPECT_FALSE(MergeDaemon::needsMerge(statistics, policy));
+
+  statistics.deltaDictionarySize = 100;
+  EXPECT_TRUE(MergeDaemon::needsMerge(statistics, policy));
+
+  // too small deltas are never merged
+  statistics.deltaRows = 1;
+  EXPECT_FALSE(MergeDaemon::needsMerge(statistics, policy));
+}
+
+TEST_F(MergeDaemonTests, tick_merges_stores_over_threshold) {
+  auto large = storeWithDelta(8);
+  auto small = storeWithDelta(1);
+  StorageManager::getInstance()->loadTable("large", large);
+  StorageManager::getInstance()->loadTable("small", small);
+
+  MergePolicy policy;
+  policy.minDeltaRows = 1;
+  policy.maxScanPenalty = 1.0;
+
+  // 8 of 16 rows in the delta cost 1.5 times an all-main scan extra
+  EXPECT_DOUBLE_EQ(1.5, DeltaStatistics::of(*large, policy).scanPenalty);
+  policy.deltaRowScanCost = 2.0;
+  EXPECT_DOUBLE_EQ(0.5, DeltaStatistics::of(*large, policy).scanPenalty);
+  policy.deltaRowScanCost = 4.0;
+
+  MergeDaemon daemon(policy);
+  EXPECT_EQ(1u, daemon.tick());
+
+  EXPECT_EQ(0u, large->getDeltaTable()->size());
+  EXPECT_EQ(16u, large->size());
+  EXPECT_EQ(7, large->getValue<hyrise_int_t>(0, 15));
+  EXPECT_EQ(1u, small->getDeltaTable()->size());
+}
+
+}
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+#include "io/shortcuts.h"
+#include "storage/AbstractTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+#include "storage/Store.h"
+#include "storage/TableRangeView.h"
+
+namespace {
+
+void assertBatchMatchesSingle(hyrise::storage::c_atable_ptr_t table, const size_t column) {
+  ValueIdList range(table->size());
+  table->getValueIds(column, 0, table->size(), range.data());
+
+  pos_list_t rows;
+  for (size_t i = 0; i < table->size(); i += 3)
+    rows.push_back(table->size() - 1 - i);
+  ValueIdList gathered(rows.size());
+  table->gatherValueIds(column, rows.data(), rows.size(), gathered.data());
+
+  for (size_t row = 0; row < table->size(); ++row) {
+    ASSERT_EQ(table->getValueId(column, row).valueId, range[row].valueId);
+    ASSERT_EQ(table->getValueId(column, row).table, range[row].table);
+  }
+  for (size_t i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(table->getValueId(column, rows[i]).valueId, gathered[i].valueId);
+    ASSERT_EQ(table->getValueId(column, rows[i]).table, gathered[i].table);
+  }
+}
+
+}
+
+TEST(AbstractTable_getValueIds, store_spanning_main_and_delta) {
+  auto store = std::make_shared<Store>(Loader::shortcuts::load("test/test10k_12.tbl"));
+  store->getDeltaTable()->resize(3);
+  for (size_t row = 0; row < 3; ++row)
+    store->getDeltaTable()->setValue<hyrise_int_t>(1, row, 7 * row);
+
+  assertBatchMatchesSingle(store, 1);
+}
+
+TEST(AbstractTable_getValueIds, views) {
+  hyrise::storage::atable_ptr_t table = Loader::shortcuts::load("test/test10k_12.tbl");
+
+  auto positions = new pos_list_t;
+  for (size_t row = 0; row < table->size(); row += 7)
+    positions->push_back(row);
+  assertBatchMatchesSingle(PointerCalculatorFactory::createPointerCalculatorNonRef(table, nullptr, positions), 2);
+
+  assertBatchMatchesSingle(std::make_shared<TableRangeView>(table, 1500, 4700), 3);
+}
@@ -3,7 +3,9 @@
 #include <storage.h>
 
 #include <storage/BitCompressedVector.h>
+#include <storage/ConcurrentDeltaVector.h>
 #include <storage/FixedLengthVector.h>
+#include <storage/RunLengthVector.h>
 #include <storage/AttributeVectorFactory.h>
 #include <memory/strategies.h>
 
@@ -175,3 +177,129 @@ TYPED_TEST(AttributeVectorTests, empty_size_does_not_change_with_reserve) {
 
 }
 
+
+TYPED_TEST(AttributeVectorTests, scan_range_matches_get) {
+  const size_t rows = 1000;
+  auto tuples = AttributeVectorFactory::getAttributeVector2<uint32_t, typename TypeParam::Allocator>(2, rows, TypeParam::compressed, std::vector<uint64_t> {7, 13});
+  tuples->resize(rows);
+
+  for (size_t row = 0; row < rows; ++row) {
+    tuples->set(0, row, row % 128);
+    tuples->set(1, row, (row * 7) % 8192);
+  }
+
+  for (size_t column = 0; column < 2; ++column) {
+    pos_list_t expected;
+    for (size_t row = 10; row < 990; ++row) {
+      auto value = tuples->get(column, row);
+      if (value >= 30 && value <= 2000) {
+        expected.push_back(row + 5);
+      }
+    }
+
+    pos_list_t positions;
+    tuples->scanRange(column, 10, 990, 30, 2000, positions, 5);
+    ASSERT_EQ(expected, positions);
+  }
+}
+
+TYPED_TEST(AttributeVectorTests, scan_range_reaches_the_last_row) {
+  const size_t rows = 1001;
+  auto values = AttributeVectorFactory::getAttributeVector2<uint32_t, typename TypeParam::Allocator>(1, rows, TypeParam::compressed, std::vector<uint64_t> {32});
+  values->resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    values->set(0, row, static_cast<uint32_t>(row * 2654435761u));
+
+  for (const uint32_t high : {0xFFFFFFFFu, 0x7FFFFFFFu}) {
+    pos_list_t expected;
+    for (size_t row = 3; row < rows; ++row) {
+      if (values->get(0, row) <= high)
+        expected.push_back(row);
+    }
+
+    pos_list_t positions;
+    values->scanRange(0, 3, rows, 0, high, positions);
+    ASSERT_EQ(expected, positions);
+  }
+}
+
+TEST(RunLengthVectorTest, encode_modify_and_scan_runs) {
+  const size_t rows = 1000;
+  FixedLengthVector<uint32_t> plain(2, rows);
+  plain.resize(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    plain.set(0, row, row / 100);
+    plain.set(1, row, row % 3);
+  }
+
+  auto runs = RunLengthVector<uint32_t>::encode(plain, 2, rows);
+  ASSERT_EQ(rows, runs->size());
+  EXPECT_EQ(10u, runs->runCount(0));
+  EXPECT_EQ(rows, runs->runCount(1));
+  for (size_t row = 0; row < rows; ++row) {
+    ASSERT_EQ(plain.get(0, row), runs->get(0, row));
+    ASSERT_EQ(plain.get(1, row), runs->get(1, row));
+  }
+
+  // whole runs are emitted, clipped to the scanned rows
+  pos_list_t positions;
+  runs->scanRange(0, 150, 420, 2, 3, positions, 5);
+  ASSERT_EQ(200u, positions.size());
+  EXPECT_EQ(205u, positions.front());
+  EXPECT_EQ(404u, positions.back());
+
+  // adjacent matching runs form one range
+  std::vector<row_range_t> ranges;
+  ASSERT_TRUE(runs->scanRanges(0, 150, 420, 2, 3, ranges, 5));
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(row_range_t(205, 405), ranges[0]);
+  EXPECT_FALSE(plain.scanRanges(0, 150, 420, 2, 3, ranges, 5));
+  EXPECT_EQ(1u, ranges.size());
+
+  // a write splits its run and joins it again once the value is restored
+  runs->set(0, 150, 7);
+  EXPECT_EQ(12u, runs->runCount(0));
+  EXPECT_EQ(7u, runs->get(0, 150));
+  EXPECT_EQ(1u, runs->get(0, 151));
+  runs->set(0, 150, 1);
+  EXPECT_EQ(10u, runs->runCount(0));
+
+  runs->resize(250);
+  EXPECT_EQ(3u, runs->runCount(0));
+  runs->resize(300);
+  EXPECT_EQ(0u, runs->get(0, 299));
+  EXPECT_EQ(2u, runs->get(0, 249));
+}
+
+TEST(ConcurrentDeltaVectorTest, growing_keeps_rows_in_place) {
+  ConcurrentDeltaVector<uint32_t> vector(2, 10);
+  vector.resize(10);
+  vector.set(1, 5, 42);
+  const uint32_t *row = vector.rowData(5, 2);
+
+  // grows past the first chunks, written rows do not move
+  const size_t rows = 5000;
+  vector.resize(rows);
+  for (size_t r = 0; r < rows; ++r)
+    vector.set(0, r, r);
+  EXPECT_EQ(row, vector.rowData(5, 2));
+  EXPECT_EQ(42u, row[1]);
+  EXPECT_EQ(rows, vector.size());
+  EXPECT_EQ(0u, vector.get(1, rows - 1));
+
+  std::vector<uint32_t> decoded(rows - 1000);
+  vector.decode(0, 1000, rows, decoded.data());
+  for (size_t r = 1000; r < rows; ++r)
+    ASSERT_EQ(r, decoded[r - 1000]);
+
+  pos_list_t positions;
+  vector.scanRange(0, 1000, 3000, 1020, 2100, positions);
+  ASSERT_EQ(1081u, positions.size());
+  EXPECT_EQ(1020u, positions.front());
+  EXPECT_EQ(2100u, positions.back());
+
+  auto copied = vector.copy();
+  EXPECT_EQ(rows, copied->size());
+  EXPECT_EQ(42u, copied->get(1, 5));
+  EXPECT_EQ(4999u, copied->get(0, 4999));
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "storage/ChunkedTable.h"
+#include "storage/RunLengthVector.h"
+#include "storage/ZoneMap.h"
+
+namespace hyrise {
+namespace storage {
+
+class ChunkedTableTests : public Test {
+ protected:
+  std::shared_ptr<ChunkedTable> create(size_t chunkSize) {
+    ColumnMetadata a("a", IntegerType), b("b", StringType);
+    return std::make_shared<ChunkedTable>(std::vector<const ColumnMetadata *> {&a, &b}, nullptr, chunkSize);
+  }
+};
+
+TEST_F(ChunkedTableTests, appending_adds_chunks_without_moving_rows) {
+  auto table = create(4);
+  table->resize(3);
+  for (size_t row = 0; row < 3; ++row)
+    table->setValue<hyrise_int_t>(0, row, row);
+  const auto first = table->chunk(0);
+
+  table->resize(10);
+  for (size_t row = 3; row < 10; ++row)
+    table->setValue<hyrise_int_t>(0, row, row);
+  for (size_t row = 0; row < 10; ++row)
+    table->setValue<hyrise_string_t>(1, row, row % 2 ? "odd" : "even");
+
+  ASSERT_EQ(3u, table->chunkCount());
+  EXPECT_EQ(first, table->chunk(0));
+  EXPECT_EQ(2u, table->chunk(2)->size());
+  EXPECT_EQ(table->dictionaryAt(0), table->chunk(2)->dictionaryAt(0));
+
+  ValueIdList value_ids(10);
+  table->getValueIds(0, 0, 10, value_ids.data());
+  for (size_t row = 0; row < 10; ++row) {
+    EXPECT_EQ(static_cast<hyrise_int_t>(row), table->getValue<hyrise_int_t>(0, row));
+    EXPECT_EQ(table->getValueId(0, row).valueId, value_ids[row].valueId);
+  }
+  EXPECT_EQ("odd", table->getValue<hyrise_string_t>(1, 7));
+
+  const auto copy = table->copy();
+  EXPECT_EQ(9, copy->getValue<hyrise_int_t>(0, 9));
+  EXPECT_NE(table->dictionaryAt(0), copy->dictionaryAt(0));
+}
+
+TEST_F(ChunkedTableTests, sealing_encodes_full_chunks_and_builds_zone_maps) {
+  auto table = create(1024);
+  table->resize(2500);
+  for (size_t row = 0; row < 2500; ++row) {
+    table->setValue<hyrise_int_t>(0, row, row / 1024);
+    table->setValue<hyrise_string_t>(1, row, "x");
+  }
+
+  // the last chunk is not full and stays writable without a zone map
+  EXPECT_EQ(2u, table->seal());
+  EXPECT_EQ(0u, table->seal());
+  std::vector<std::shared_ptr<const ZoneMap>> zone_maps;
+  const auto chunks = table->getChunks(zone_maps);
+  ASSERT_EQ(3u, chunks.size());
+  ASSERT_TRUE(zone_maps[1] != nullptr);
+  EXPECT_TRUE(zone_maps[2] == nullptr);
+  EXPECT_EQ(table->chunk(1)->getValueId(0, 0).valueId, zone_maps[1]->min(0, 0));
+  EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthVector<value_id_t> >(table->chunk(0)->getAttributeVectors(0).at(0).attribute_vector) != nullptr);
+  EXPECT_EQ(1, table->getValue<hyrise_int_t>(0, 2047));
+
+  // sealed chunks have their own ordered dictionaries, the table still
+  // returns value ids of the shared dictionaries
+  EXPECT_TRUE(table->chunk(1)->dictionaryAt(0)->isOrdered());
+  EXPECT_EQ(1u, table->chunk(1)->dictionaryAt(0)->size());
+  EXPECT_EQ(table->dictionaryAt(0), table->chunk(2)->dictionaryAt(0));
+  EXPECT_EQ(table->getValueIdForValue<hyrise_int_t>(0, 1).valueId, table->getValueId(0, 1024).valueId);
+  ValueIdList value_ids(3);
+  const pos_t rows[] = {0, 1024, 2048};
+  table->gatherValueIds(0, rows, 3, value_ids.data());
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_EQ(table->getValueIdForValue<hyrise_int_t>(0, i).valueId, value_ids[i].valueId);
+
+  // writing to a sealed chunk encodes it with the shared dictionaries and
+  // invalidates its zone map
+  table->setValue<hyrise_int_t>(0, 1024, 2);
+  table->getChunks(zone_maps);
+  EXPECT_TRUE(zone_maps[1] == nullptr);
+  EXPECT_TRUE(zone_maps[0] != nullptr);
+  EXPECT_EQ(table->dictionaryAt(0), table->chunk(1)->dictionaryAt(0));
+  EXPECT_EQ(2, table->getValue<hyrise_int_t>(0, 1024));
+  EXPECT_EQ(1, table->getValue<hyrise_int_t>(0, 1025));
+
+  // value ids read from sealed chunks can be written to other chunks
+  table->setValueId(0, 2048, table->getValueId(0, 0));
+  EXPECT_EQ(0, table->getValue<hyrise_int_t>(0, 2048));
+  EXPECT_EQ(1u, table->seal());
+  EXPECT_EQ(2, table->getValue<hyrise_int_t>(0, 1024));
+}
+
+}
+}
@@ -3,6 +3,11 @@
 
 #include <io.h>
 #include <storage.h>
+#include <thread>
+
+#include <storage/ConcurrentDeltaDictionary.h>
+#include <storage/FrameOfReferenceDictionary.h>
+#include <storage/FrontCodedDictionary.h>
 
 class DictionaryTest : public ::hyrise::Test {};
 
@@ -123,3 +128,108 @@ TEST_F(DictionaryTest, order_preserving_string_exists) {
   ASSERT_FALSE(dict.valueExists("321"));
 
 }
+
+TEST_F(DictionaryTest, translate_between_order_preserving_dictionaries) {
+  auto from = std::make_shared<OrderPreservingDictionary<std::string> >();
+  auto to = std::make_shared<OrderPreservingDictionary<std::string> >();
+  for (const std::string value : {"a", "c", "d", "f"})
+    from->addValue(value);
+  for (const std::string value : {"b", "c", "f", "g"})
+    to->addValue(value);
+
+  EXPECT_EQ(value_id_translation_t({NO_TRANSLATION, 1, NO_TRANSLATION, 2}),
+            translateValueIds(from, to, StringType));
+  EXPECT_EQ(2u, translateValueId(from, to, StringType, 3));
+}
+
+TEST_F(DictionaryTest, translate_into_order_indifferent_dictionary) {
+  auto from = std::make_shared<OrderPreservingDictionary<hyrise_int_t> >();
+  auto to = std::make_shared<OrderIndifferentDictionary<hyrise_int_t> >();
+  for (const hyrise_int_t value : {1, 2, 3})
+    from->addValue(value);
+  for (const hyrise_int_t value : {3, 1})
+    to->addValue(value);
+
+  EXPECT_EQ(value_id_translation_t({1, NO_TRANSLATION, 0}), translateValueIds(from, to, IntegerType));
+}
+
+TEST_F(DictionaryTest, frame_of_reference_dictionary) {
+  FrameOfReferenceDictionary<hyrise_int_t> d;
+  EXPECT_EQ(0u, d.addValue(10));
+  EXPECT_EQ(3u, d.addValue(13));
+  ASSERT_EQ(4u, d.size());
+
+  EXPECT_EQ(12, d.getValueForValueId(2));
+  EXPECT_EQ(0u, d.getValueIdForValue(5));
+  EXPECT_EQ(1u, d.getValueIdForValue(11));
+  EXPECT_EQ(4u, d.getValueIdForValue(20));
+  EXPECT_EQ(2u, d.getValueIdForValueGreater(11));
+  EXPECT_TRUE(d.valueExists(13));
+  EXPECT_FALSE(d.valueExists(14));
+  EXPECT_THROW(d.addValue(12), std::runtime_error);
+
+  std::vector<hyrise_int_t> values;
+  for (auto it = d.begin(); it != d.end(); ++it)
+    values.push_back(*it);
+  EXPECT_EQ(std::vector<hyrise_int_t>({10, 11, 12, 13}), values);
+
+  auto other = std::make_shared<FrameOfReferenceDictionary<hyrise_int_t> >(12, 4);
+  EXPECT_EQ(value_id_translation_t({NO_TRANSLATION, NO_TRANSLATION, 0, 1}),
+            translateValueIds(d.copy(), other, IntegerType));
+}
+
+TEST_F(DictionaryTest, front_coded_dictionary) {
+  FrontCodedDictionary d;
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 100; ++i) {
+    values.push_back("customer#" + std::to_string(1000 + i * 2));
+    EXPECT_EQ(i, d.addValue(values.back()));
+  }
+  EXPECT_THROW(d.addValue("customer#0"), std::runtime_error);
+  ASSERT_EQ(100u, d.size());
+
+  for (value_id_t id = 0; id < values.size(); ++id)
+    EXPECT_EQ(values[id], d.getValueForValueId(id));
+  EXPECT_EQ(17u, d.getValueIdForValue("customer#1034"));
+  EXPECT_EQ(18u, d.getValueIdForValue("customer#1035"));
+  EXPECT_EQ(18u, d.getValueIdForValueGreater("customer#1034"));
+  EXPECT_EQ(0u, d.getValueIdForValue("a"));
+  EXPECT_EQ(100u, d.getValueIdForValue("z"));
+  EXPECT_TRUE(d.valueExists("customer#1032"));
+  EXPECT_FALSE(d.valueExists("customer#1033"));
+
+  value_id_t low, high;
+  d.getValueIdRangeForPrefix("customer#11", low, high);
+  EXPECT_EQ(50u, low);
+  EXPECT_EQ(100u, high);
+
+  size_t id = 0;
+  for (auto it = d.begin(); it != d.end(); ++it, ++id)
+    EXPECT_EQ(values[id], *it);
+  EXPECT_EQ(100u, id);
+  EXPECT_LT(d.encodedSize(), 100 * values[0].size());
+}
+
+TEST_F(DictionaryTest, concurrent_delta_dictionary_inserts) {
+  ConcurrentDeltaDictionary<hyrise_int_t> d;
+  std::vector<std::thread> writers;
+  for (size_t writer = 0; writer < 4; ++writer) {
+    writers.emplace_back([&d, writer]() {
+        for (hyrise_int_t value = 0; value < 5000; ++value)
+          d.addValue((value * 31 + writer) % 5000);
+      });
+  }
+  for (auto &writer : writers)
+    writer.join();
+
+  ASSERT_EQ(5000u, d.size());
+  for (hyrise_int_t value = 0; value < 5000; ++value)
+    ASSERT_EQ(value, d.getValueForValueId(d.getValueIdForValue(value)));
+
+  hyrise_int_t expected = 0;
+  for (auto it = d.begin(); it != d.end(); ++it, ++expected) {
+    ASSERT_EQ(expected, *it);
+    ASSERT_EQ(expected, d.getValueForValueId(it.getValueId()));
+  }
+  EXPECT_EQ(5000, expected);
+}
@@ -7,6 +7,7 @@
 #include "io/shortcuts.h"
 #include "storage/HashTable.h"
 #include "storage/Store.h"
+#include "storage/ValueIdHashTable.h"
 
 template <typename HT>
 ::testing::AssertionResult TestCoverage(const hyrise::storage::atable_ptr_t &table,
@@ -45,7 +46,8 @@ public:
   }
 };
 
-typedef ::testing::Types<SingleJoinHashTable, SingleAggregateHashTable> single_hash_types;
+typedef ::testing::Types<SingleJoinHashTable, SingleAggregateHashTable,
+                         NodeSingleJoinHashTable, NodeSingleAggregateHashTable> single_hash_types;
 TYPED_TEST_CASE(SingleHashTableTest, single_hash_types);
 
 
@@ -72,7 +74,7 @@ public:
 };
 
 
-typedef ::testing::Types<JoinHashTable, AggregateHashTable> hash_types;
+typedef ::testing::Types<JoinHashTable, AggregateHashTable, NodeJoinHashTable, NodeAggregateHashTable> hash_types;
 TYPED_TEST_CASE(HashTableTest, hash_types);
 
 TYPED_TEST(HashTableTest, load) {
@@ -197,4 +199,51 @@ TYPED_TEST(HashTableViewTest, partial_range) {
   }
 }
 
+TEST(OpenAddressingMultimapTest, groups_equal_keys_across_growth) {
+  aggregate_hash_map_t map;
+  for (pos_t row = 0; row < 1000; ++row)
+    map.insert(aggregate_hash_map_t::value_type(aggregate_key_t {static_cast<value_id_t>(row % 37), 1}, row));
+  map.finalize();
+
+  // Inserting after finalize() merges the new entries into their groups
+  map.insert(aggregate_hash_map_t::value_type(aggregate_key_t {5, 1}, 1000));
+  EXPECT_THROW(map.begin(), std::logic_error);
+  map.finalize();
+
+  EXPECT_EQ(1001u, map.size());
+  EXPECT_EQ(37u, map.keyCount());
+  EXPECT_EQ(0u, map.count(aggregate_key_t {5, 2}));
+
+  auto range = map.equal_range(aggregate_key_t {5, 1});
+  pos_list_t positions;
+  for (auto it = range.first; it != range.second; ++it)
+    positions.push_back(it->second);
+  ASSERT_EQ(28u, positions.size());
+  EXPECT_EQ(5u, positions.front());
+  EXPECT_EQ(1000u, positions.back());
+
+  size_t groups = 0;
+  for (auto it1 = map.begin(), it2 = it1; it1 != map.end(); it1 = it2, ++groups)
+    for (; it2 != map.end() && it1->first == it2->first; ++it2);
+  EXPECT_EQ(37u, groups);
+}
 
+TEST(ValueIdHashTableTest, probe_main_and_delta_with_foreign_dictionary) {
+  auto build = std::make_shared<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  const auto &delta = build->getDeltaTable();
+  delta->resize(2);
+  delta->setValue<hyrise_string_t>(1, 0, "C");
+  delta->setValue<hyrise_string_t>(1, 1, "D");
+  hyrise::storage::c_atable_ptr_t probe = Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+
+  ValueIdHashTable htable(build, {1});
+  EXPECT_EQ(10u, htable.size());
+  EXPECT_EQ(5u, htable.numKeys());
+
+  // probe row 5 holds C, which occurs in main row 5 and delta row 8
+  pos_list_t buildRows, probeRows;
+  htable.probe(probe, 1, 5, 6, buildRows, probeRows);
+  EXPECT_EQ(pos_list_t({5, 8}), buildRows);
+  EXPECT_EQ(pos_list_t({5, 5}), probeRows);
+  EXPECT_EQ(buildRows, htable.get(probe, {1}, 5));
+}
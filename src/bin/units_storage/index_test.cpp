@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 
+#include <storage/csb_index.h>
 #include <storage/csb_tree.h>
 
 using namespace hyrise::index;
@@ -516,3 +517,26 @@ TEST_F(IndexTests, index_fixed_pos_3) {
 
   ASSERT_EQ(40u, i);
 }
+
+TEST_F(IndexTests, csb_index_string_keys_in_order) {
+  CSBIndex<std::string, unsigned> idx;
+  std::vector<std::string> keys;
+  for (unsigned i = 0; i < 5000; ++i)
+    keys.push_back(std::to_string((i * 7919) % 5000));
+  for (unsigned i = 0; i < keys.size(); ++i)
+    ASSERT_TRUE(idx.insert(keys[i], i));
+  ASSERT_FALSE(idx.insert(keys[42], 0));
+  ASSERT_EQ(5000u, idx.size());
+
+  for (unsigned i = 0; i < keys.size(); ++i) {
+    ASSERT_TRUE(idx.find(keys[i]) != nullptr);
+    EXPECT_EQ(i, *idx.find(keys[i]));
+  }
+  EXPECT_TRUE(idx.find("x") == nullptr);
+
+  std::sort(keys.begin(), keys.end());
+  size_t position = 0;
+  for (auto it = idx.begin(); it != idx.end(); ++it, ++position)
+    ASSERT_EQ(keys[position], it.key());
+  EXPECT_EQ(keys.size(), position);
+}
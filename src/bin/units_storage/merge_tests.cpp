@@ -7,6 +7,8 @@
 #include <io/shortcuts.h>
 
 #include <storage.h>
+#include <storage/FrameOfReferenceDictionary.h>
+#include <storage/RunLengthVector.h>
 
 #include <helper/PapiTracer.h>
 #include <helper/types.h>
@@ -329,3 +331,81 @@ TEST_F(MergeTests, merge_with_different_layout_2) {
   ASSERT_EQ(dest, result[0]);
 
 }
+
+TEST_F(MergeTests, merge_keeps_clustered_columns_as_runs) {
+  TableGenerator g(true);
+  std::vector<hyrise::storage::c_atable_ptr_t > tables;
+  tables.push_back(g.one_value(1000, 2, 3));
+  tables.push_back(g.one_value_delta(10, 2, 4));
+
+  TableMerger merger(new LogarithmicMergeStrategy(0), new SequentialHeapMerger());
+  const auto& result = merger.merge(tables);
+
+  ASSERT_EQ(1u, result.size());
+  const auto vector = result[0]->getAttributeVectors(0).at(0).attribute_vector;
+  const auto runs = std::dynamic_pointer_cast<RunLengthVector<value_id_t> >(vector);
+  ASSERT_TRUE(runs != nullptr);
+  EXPECT_EQ(2u, runs->runCount(0));
+  EXPECT_EQ(3, result[0]->getValue<hyrise_int_t>(1, 999));
+  EXPECT_EQ(4, result[0]->getValue<hyrise_int_t>(1, 1000));
+}
+
+TEST_F(MergeTests, merge_encodes_dense_integer_columns_as_frame_of_reference) {
+  TableGenerator g(true);
+  auto main = g.create_empty_table_modifiable(1000, 1);
+  main->resize(1000);
+  for (size_t row = 0; row < 1000; ++row)
+    main->setValue<hyrise_int_t>(0, row, 5000 + row + row / 100);
+  auto delta = g.create_empty_table_modifiable(10, 1);
+  delta->resize(10);
+  for (size_t row = 0; row < 10; ++row)
+    delta->setValue<hyrise_int_t>(0, row, 6019 - row);
+
+  std::vector<hyrise::storage::c_atable_ptr_t > tables;
+  tables.push_back(main);
+  tables.push_back(delta);
+  TableMerger merger(new LogarithmicMergeStrategy(0), new SequentialHeapMerger());
+  const auto& result = merger.merge(tables);
+
+  ASSERT_EQ(1u, result.size());
+  const auto dictionary = std::dynamic_pointer_cast<FrameOfReferenceDictionary<hyrise_int_t> >(result[0]->dictionaryAt(0));
+  ASSERT_TRUE(dictionary != nullptr);
+  EXPECT_EQ(5000, dictionary->base());
+  EXPECT_EQ(1020u, dictionary->size());
+  EXPECT_EQ(5000, result[0]->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(6008, result[0]->getValue<hyrise_int_t>(0, 999));
+  EXPECT_EQ(6010, result[0]->getValue<hyrise_int_t>(0, 1009));
+}
+
+TEST_F(MergeTests, merge_of_frame_of_reference_main_skips_absent_values) {
+  TableGenerator g(true);
+  auto main = g.create_empty_table_modifiable(300, 1);
+  main->resize(300);
+  // 100 and 201 are absent
+  for (size_t row = 0; row < 300; ++row)
+    main->setValue<hyrise_int_t>(0, row, row + row / 100);
+  auto delta = g.create_empty_table_modifiable(1, 1);
+  delta->resize(1);
+  delta->setValue<hyrise_int_t>(0, 0, 0);
+
+  std::vector<hyrise::storage::c_atable_ptr_t > tables;
+  tables.push_back(main);
+  tables.push_back(delta);
+  TableMerger merger(new LogarithmicMergeStrategy(0), new SequentialHeapMerger());
+  const auto encoded = merger.merge(tables);
+  ASSERT_TRUE(std::dynamic_pointer_cast<FrameOfReferenceDictionary<hyrise_int_t> >(encoded[0]->dictionaryAt(0)) != nullptr);
+
+  auto sparse = g.create_empty_table_modifiable(1, 1);
+  sparse->resize(1);
+  sparse->setValue<hyrise_int_t>(0, 0, 1000000);
+  tables.clear();
+  tables.push_back(encoded[0]);
+  tables.push_back(sparse);
+  const auto result = merger.merge(tables);
+
+  ASSERT_EQ(1u, result.size());
+  EXPECT_EQ(301u, result[0]->dictionaryAt(0)->size());
+  EXPECT_FALSE(std::dynamic_pointer_cast<BaseDictionary<hyrise_int_t> >(result[0]->dictionaryAt(0))->valueExists(100));
+  EXPECT_EQ(101, result[0]->getValue<hyrise_int_t>(0, 100));
+  EXPECT_EQ(1000000, result[0]->getValue<hyrise_int_t>(0, 301));
+}
@@ -180,3 +180,64 @@ TEST_F(PointerCalcTests, pc_on_selected_columns) {
 
 }
 
+
+TEST_F(PointerCalcTests, pc_keeps_sorted_positions_as_range_or_bitmap) {
+  hyrise::storage::c_atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  pos_list_t *even = new pos_list_t;
+  for (pos_t row = 0; row < t->size(); row += 2)
+    even->push_back(row);
+  auto evenRows = PointerCalculatorFactory::createPointerCalculatorForSorted(t, nullptr, even);
+  ASSERT_TRUE(evenRows->isBitmap());
+  ASSERT_EQ(t->size() / 2, evenRows->size());
+  EXPECT_EQ(t->getValueId(0, 14).valueId, evenRows->getValueId(0, 7).valueId);
+
+  std::vector<ValueId> valueIds(4);
+  evenRows->getValueIds(0, 3, 7, valueIds.data());
+  for (size_t i = 0; i < valueIds.size(); ++i)
+    EXPECT_EQ(t->getValueId(0, 2 * (3 + i)).valueId, valueIds[i].valueId);
+
+  auto middle = PointerCalculatorFactory::createPointerCalculatorForSorted(t, nullptr, new pos_list_t {10, 11, 12, 13, 14, 15, 16, 17, 18, 19});
+  ASSERT_TRUE(middle->isRange());
+  EXPECT_EQ(t->getValueId(0, 12).valueId, middle->getValueId(0, 2).valueId);
+
+  // few positions stay a list
+  auto few = PointerCalculatorFactory::createPointerCalculatorForSorted(t, nullptr, new pos_list_t {3, 50});
+  EXPECT_FALSE(few->isRange() || few->isBitmap());
+
+  const pos_list_t *positions = evenRows->getPositions();
+  ASSERT_EQ(evenRows->size(), positions->size());
+  EXPECT_EQ(98u, positions->back());
+}
+
+TEST_F(PointerCalcTests, pc_combines_ranges_and_bitmaps) {
+  hyrise::storage::c_atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  pos_list_t *even = new pos_list_t, *odd = new pos_list_t;
+  for (pos_t row = 0; row < t->size(); ++row)
+    (row % 2 ? odd : even)->push_back(row);
+  auto evenRows = PointerCalculatorFactory::createPointerCalculatorForSorted(t, nullptr, even);
+  auto oddRows = PointerCalculatorFactory::createPointerCalculatorForSorted(t, nullptr, odd);
+  auto first = PointerCalculatorFactory::createView(t, 10, 39);
+  auto second = PointerCalculatorFactory::createView(t, 40, 59);
+
+  auto evenInFirst = evenRows->intersect(first);
+  ASSERT_EQ(15u, evenInFirst->size());
+  EXPECT_EQ(10u, evenInFirst->getTableRowForRow(0));
+  EXPECT_EQ(38u, evenInFirst->getTableRowForRow(14));
+
+  auto both = first->unite(second);
+  ASSERT_TRUE(both->isRange());
+  EXPECT_EQ(50u, both->size());
+  EXPECT_EQ(59u, both->getTableRowForRow(49));
+  EXPECT_EQ(0u, first->intersect(second)->size());
+
+  auto all = evenRows->unite(oddRows);
+  ASSERT_TRUE(all->isRange());
+  EXPECT_EQ(t->size(), all->size());
+  EXPECT_EQ(0u, evenRows->intersect(oddRows)->size());
+
+  // positions are filtered by the other view
+  auto some = PointerCalculatorFactory::createPointerCalculatorForSorted(t, nullptr, new pos_list_t {3, 12, 50});
+  EXPECT_EQ(2u, some->intersect(evenRows)->size());
+  EXPECT_EQ(1u, first->intersect(some)->size());
+}
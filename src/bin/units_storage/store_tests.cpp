@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "testing/test.h"
 
+#include "io/shortcuts.h"
+#include "storage/ConcurrentDeltaDictionary.h"
 #include "storage/Store.h"
 #include "storage/TableGenerator.h"
 
@@ -35,5 +37,74 @@ TEST_F(StoreTests, test_write_through_fail) {
 #endif
 }
 
+TEST_F(StoreTests, delta_uses_concurrent_dictionaries) {
+  Store s(tg.one_value(1, 1, 0));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ConcurrentDeltaDictionary<hyrise_int_t> >(s.getDeltaTable()->dictionaryAt(0)) != nullptr);
+}
+
+TEST_F(StoreTests, merge_publishes_new_main_and_keeps_snapshots) {
+  auto store = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  ASSERT_TRUE(store != nullptr);
+  {
+    auto deltaLock = store->lockDelta();
+    const auto &delta = store->getDeltaTable();
+    delta->resize(2);
+    for (size_t row = 0; row < 2; ++row) {
+      delta->setValue<hyrise_int_t>(0, row, row == 0 ? 5 : -1);
+      delta->setValue<hyrise_string_t>(1, row, "D");
+      delta->setValue<hyrise_float_t>(2, row, 0.5f);
+    }
+  }
+  auto before = store->snapshot();
+
+  store->startMerge();
+  // rows of the frozen delta keep their positions until the merge is published
+  EXPECT_EQ(10u, store->size());
+  EXPECT_EQ(5, store->getValue<hyrise_int_t>(0, 8));
+  store->waitForMerge();
+
+  ASSERT_EQ(1u, store->getMainTables().size());
+  EXPECT_EQ(0u, store->getDeltaTable()->size());
+  EXPECT_EQ(10u, store->size());
+  EXPECT_EQ(5, store->getValue<hyrise_int_t>(0, 8));
+  EXPECT_EQ(-1, store->getValue<hyrise_int_t>(0, 9));
+
+  ASSERT_EQ(1u, before->getMainTables().size());
+  EXPECT_EQ(2u, before->getDeltaTable()->size());
+  EXPECT_EQ(-1, before->getValue<hyrise_int_t>(0, 9));
+}
+
+TEST_F(StoreTests, snapshot_ends_at_delta_rows_written_before_it) {
+  auto store = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  ASSERT_TRUE(store != nullptr);
+  const size_t main_rows = store->size();
+  auto append = [&store] (hyrise_int_t value) {
+    auto deltaLock = store->lockDelta();
+    const auto &delta = store->getDeltaTable();
+    const size_t row = delta->size();
+    delta->resize(row + 1);
+    delta->setValue<hyrise_int_t>(0, row, value);
+    delta->setValue<hyrise_string_t>(1, row, "D");
+    delta->setValue<hyrise_float_t>(2, row, 0.5f);
+  };
+
+  append(5);
+  auto before = store->snapshot();
+  // appends grow the shared delta past the first chunk of its rows
+  for (size_t row = 0; row < 2000; ++row)
+    append(6);
+
+  EXPECT_EQ(main_rows + 2001, store->size());
+  EXPECT_EQ(main_rows + 1, before->size());
+  EXPECT_EQ(5, before->getValue<hyrise_int_t>(0, main_rows));
+  EXPECT_EQ(6, store->getValue<hyrise_int_t>(0, main_rows + 2000));
+
+  pos_list_t rows = {main_rows};
+  std::vector<ValueId> value_ids(1);
+  before->gatherValueIds(0, rows.data(), 1, value_ids.data());
+  EXPECT_EQ(5, before->getValueForValueId<hyrise_int_t>(0, value_ids[0]));
+  EXPECT_EQ(main_rows + 1, before->copy()->size());
+}
+
 }
 }
@@ -0,0 +1,46 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "io/shortcuts.h"
+#include "storage/Store.h"
+#include "storage/ZoneMap.h"
+
+namespace hyrise {
+namespace storage {
+
+class ZoneMapTests : public Test {};
+
+TEST_F(ZoneMapTests, candidate_ranges_skip_blocks_out_of_range) {
+  auto store = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  // column A holds 0 1 | 0 0 | 1 2 | 1 1, the value ids equal the values
+  ZoneMap zoneMap(store->getMainTables()[0], 2);
+  ASSERT_EQ(4u, zoneMap.blockCount());
+  EXPECT_EQ(1u, zoneMap.min(0, 2));
+  EXPECT_EQ(2u, zoneMap.max(0, 2));
+
+  std::vector<row_range_t> ranges;
+  zoneMap.candidateRanges(0, 0, 8, 2, 2, ranges);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(row_range_t(4, 6), ranges[0]);
+
+  // adjacent blocks are joined and the range is clipped to [start, stop)
+  ranges.clear();
+  zoneMap.candidateRanges(0, 1, 7, 0, 0, ranges);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(row_range_t(1, 4), ranges[0]);
+}
+
+TEST_F(ZoneMapTests, store_drops_zone_map_of_modified_main) {
+  auto store = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/tables/hash_table_test.tbl"));
+  std::vector<std::shared_ptr<const ZoneMap>> zoneMaps;
+  store->getMainTables(zoneMaps);
+  ASSERT_EQ(1u, zoneMaps.size());
+  ASSERT_TRUE(zoneMaps[0] != nullptr);
+
+  store->setValueId(0, 0, store->getValueId(0, 5));
+  store->getMainTables(zoneMaps);
+  EXPECT_TRUE(zoneMaps[0] == nullptr);
+}
+
+}
+}
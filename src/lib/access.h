@@ -9,7 +9,7 @@
 #include <access/predicates.h>
 #include <access/SimpleTableScan.h>
 #include <access/SimpleRawTableScan.h>
-#include <access/MergeJoin.hpp>
+#include <access/MergeJoin.h>
 #include <access/PlanOperation.h>
 #include <access/JoinScan.h>
 #include <access/UnionScan.h>
@@ -17,6 +17,7 @@
 #include <access/InsertScan.h>
 #include <access/UpdateScan.h>
 #include <access/GroupByScan.h>
+#include <access/ParallelGroupByScan.h>
 #include <access/ExpressionScan.h>
 #include <access/ProjectionScan.h>
 #include <access/MaterializingScan.h>
@@ -27,6 +28,7 @@
 #include <access/OutputTask.h>
 #include <access/HashBuild.h>
 #include <access/HashJoinProbe.h>
+#include <access/RadixHashJoin.h>
 #include <access/SettingsOperation.h>
 #include <access/ThreadpoolAdjustment.h>
 #include <access/TaskSchedulerAdjustment.h>
@@ -0,0 +1,133 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/AbstractExpression.h"
+
+#include <memory>
+
+#include "storage/BitVector.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+
+namespace hyrise { namespace access {
+
+storage::pos_list_t* matchMorsels(AbstractExpression &expr, const size_t size, const size_t morselSize) {
+  std::vector<std::unique_ptr<storage::pos_list_t>> parts(morselCount(size, morselSize));
+  executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+      parts[morsel].reset(expr.match(start, stop));
+    }, morselSize);
+
+  if (parts.size() == 1)
+    return parts[0].release();
+
+  size_t total = 0;
+  for (const auto& part : parts)
+    total += part->size();
+
+  // Concatenating in morsel order keeps the positions sorted
+  auto positions = new storage::pos_list_t;
+  positions->reserve(total);
+  for (const auto& part : parts)
+    positions->insert(positions->end(), part->begin(), part->end());
+  return positions;
+}
+
+namespace {
+
+// Matches of a morsel, kept as positions, as ranges or as bitmap over
+// its rows
+struct morsel_matches_t {
+  std::unique_ptr<storage::pos_list_t> positions;
+  std::vector<row_range_t> ranges;
+  std::unique_ptr<BitVector> rows;
+  size_t start;
+  size_t count;
+};
+
+// Sets the rows of part in rows, a bitmap over all rows of the table
+void setRows(const morsel_matches_t &part, BitVector &rows) {
+  if (part.rows) {
+    part.rows->forEachSetBit([&](size_t row) { rows.set(part.start + row, true); });
+  } else if (part.positions) {
+    for (const auto &row : *part.positions)
+      rows.set(row, true);
+  } else {
+    for (const auto &range : part.ranges)
+      rows.setRange(range.first, range.second);
+  }
+}
+
+}
+
+std::shared_ptr<PointerCalculator> matchMorselsToPointerCalculator(AbstractExpression &expr, const storage::c_atable_ptr_t &table, const size_t morselSize) {
+  const size_t size = table->size();
+  std::vector<morsel_matches_t> parts(morselCount(size, morselSize));
+  executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+      auto &part = parts[morsel];
+      part.start = start;
+      if (expr.matchRanges(start, stop, part.ranges)) {
+        part.count = 0;
+        for (const auto &range : part.ranges)
+          part.count += range.second - range.first;
+        return;
+      }
+
+      part.positions.reset(expr.match(start, stop));
+      part.count = part.positions->size();
+      if (PointerCalculator::prefersBitmap(part.count, stop - start)) {
+        part.rows.reset(new BitVector(stop - start));
+        for (const auto &row : *part.positions)
+          part.rows->set(row - start, true);
+        part.positions.reset();
+      }
+    }, morselSize);
+
+  size_t total = 0;
+  for (const auto &part : parts)
+    total += part.count;
+
+  // matches that form a single range of rows, e.g. a run of a sorted
+  // column, are kept as range without visiting single rows
+  row_range_t single(0, 0);
+  bool contiguous = total > 0;
+  for (const auto &part : parts) {
+    if (part.count == 0)
+      continue;
+    if (part.positions || part.rows || part.ranges.size() != 1 ||
+        (single.first != single.second && single.second != part.ranges[0].first)) {
+      contiguous = false;
+      break;
+    }
+    if (single.first == single.second)
+      single.first = part.ranges[0].first;
+    single.second = part.ranges[0].second;
+  }
+  if (contiguous) {
+    auto result = std::make_shared<PointerCalculator>(table, nullptr, nullptr);
+    result->setRange(single.first, single.second);
+    return result;
+  }
+
+  if (PointerCalculator::prefersBitmap(total, size)) {
+    BitVector *rows = new BitVector(size);
+    for (const auto &part : parts)
+      setRows(part, *rows);
+    return PointerCalculatorFactory::createPointerCalculatorForBitmap(table, nullptr, rows);
+  }
+
+  // Concatenating in morsel order keeps the positions sorted
+  auto positions = new storage::pos_list_t;
+  positions->reserve(total);
+  for (const auto &part : parts) {
+    if (part.rows) {
+      part.rows->forEachSetBit([&](size_t row) { positions->push_back(part.start + row); });
+    } else if (part.positions) {
+      positions->insert(positions->end(), part.positions->begin(), part.positions->end());
+    } else {
+      for (const auto &range : part.ranges)
+        for (size_t row = range.first; row < range.second; ++row)
+          positions->push_back(row);
+    }
+  }
+  return PointerCalculatorFactory::createPointerCalculatorForSorted(table, nullptr, positions);
+}
+
+}}
@@ -1,8 +1,13 @@
 #ifndef SRC_LIB_ACCESS_ABSTRACTEXPRESSION_H_
 #define SRC_LIB_ACCESS_ABSTRACTEXPRESSION_H_
 
+#include <memory>
 #include <vector>
 #include "helper/types.h"
+#include "storage/storage_types.h"
+#include "taskscheduler/MorselTask.h"
+
+class PointerCalculator;
 
 namespace hyrise { namespace access {
 
@@ -12,8 +17,30 @@ class AbstractExpression {
   virtual ~AbstractExpression() {}
   virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) = 0;
   virtual storage::pos_list_t* match(const size_t start, const size_t stop) = 0;
+
+  /// Matches the rows [start, stop) like match(), but appends the
+  /// matching rows as ascending row ranges, e.g. whole runs of a run
+  /// length encoded column. Returns false without appending anything if
+  /// the expression can't match these rows as ranges.
+  virtual bool matchRanges(const size_t start, const size_t stop, std::vector<row_range_t> &ranges) {
+    return false;
+  }
 };
 
+/// Matches the rows [0, size) morsel-wise on the shared scheduler and
+/// returns the positions in row order, match() of the expression has
+/// to be safe to call concurrently for disjoint ranges
+storage::pos_list_t* matchMorsels(AbstractExpression &expr, const size_t size,
+                                  const size_t morselSize = DEFAULT_MORSEL_SIZE);
+
+/// Like matchMorsels on all rows of table, but returns the matching rows
+/// as PointerCalculator in the representation that is smallest for the
+/// selectivity, a range, bitmap or position list. Dense morsels are kept
+/// as bitmaps right away and morsels matched as ranges stay ranges, so no
+/// list of all positions is built for them
+std::shared_ptr<PointerCalculator> matchMorselsToPointerCalculator(AbstractExpression &expr, const storage::c_atable_ptr_t &table,
+                                                                   const size_t morselSize = DEFAULT_MORSEL_SIZE);
+
 }}
 
 #endif
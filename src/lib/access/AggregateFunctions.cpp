@@ -5,6 +5,11 @@
 
 namespace hyrise {
 namespace storage {
+template<>
+void sum_aggregate_functor::operator()<std::string>() {
+  throw std::runtime_error("Cannot calculate sum for column of StringType");
+}
+
 template<>
 void average_aggregate_functor::operator()<std::string>() {
   throw std::runtime_error("Cannot calculate average for column of StringType");
@@ -17,6 +22,8 @@ aggregateFunctionMap_t getAggregateFunctionMap() {
   d["SUM"] = AggregateFunctions::SUM;
   d["COUNT"] = AggregateFunctions::COUNT;
   d["AVG"] = AggregateFunctions::AVG;
+  d["MIN"] = AggregateFunctions::MIN;
+  d["MAX"] = AggregateFunctions::MAX;
   return d;
 }
 
@@ -34,6 +41,10 @@ AggregateFun *parseAggregateFunction(const Json::Value &data) {
       return CountAggregateFun::parse(data);
     case AggregateFunctions::AVG:
       return AverageAggregateFun::parse(data);
+    case AggregateFunctions::MIN:
+      return MinAggregateFun::parse(data);
+    case AggregateFunctions::MAX:
+      return MaxAggregateFun::parse(data);
     default:
       throw std::runtime_error("Aggregation function not supported in GroupByScan");
   }
@@ -62,3 +73,15 @@ AggregateFun *AverageAggregateFun::parse(const Json::Value &f) {
   else if (f["field"].isString()) return new AverageAggregateFun(f["field"].asString());
   else throw std::runtime_error("Could not parse json");
 };
+
+AggregateFun *MinAggregateFun::parse(const Json::Value &f) {
+  if (f["field"].isNumeric()) return new MinAggregateFun(f["field"].asUInt());
+  else if (f["field"].isString()) return new MinAggregateFun(f["field"].asString());
+  else throw std::runtime_error("Could not parse json");
+};
+
+AggregateFun *MaxAggregateFun::parse(const Json::Value &f) {
+  if (f["field"].isNumeric()) return new MaxAggregateFun(f["field"].asUInt());
+  else if (f["field"].isString()) return new MaxAggregateFun(f["field"].asString());
+  else throw std::runtime_error("Could not parse json");
+};
@@ -3,10 +3,12 @@
 #define SRC_LIB_ACCESS_AGGEGATEFUNCTIONS_H_
 
 #include <storage/AbstractTable.h>
+#include <storage/BaseDictionary.h>
 #include <storage/HashTable.h>
 #include <storage/storage_types.h>
 #include <storage/meta_storage.h>
 #include <json.h>
+#include <limits>
 #include <vector>
 
 
@@ -20,6 +22,69 @@
  */
 namespace hyrise {
 namespace storage {
+
+/*
+ * Calls fn for the value id of field in every row of rows, or in all rows
+ * of input if rows is nullptr. Value ids are fetched in batches.
+ */
+template <typename F>
+void forEachValueId(const c_atable_ptr_t &input, field_t field, const pos_list_t *rows, F fn) {
+  const size_t size = rows ? rows->size() : input->size();
+  ValueIdList valueIds(std::min<size_t>(size, VALUE_ID_BATCH_SIZE));
+  for (size_t batch = 0; batch < size; batch += VALUE_ID_BATCH_SIZE) {
+    const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, size - batch);
+    if (rows)
+      input->gatherValueIds(field, rows->data() + batch, count, valueIds.data());
+    else
+      input->getValueIds(field, batch, batch + count, valueIds.data());
+    for (size_t i = 0; i < count; ++i)
+      fn(valueIds[i]);
+  }
+}
+
+/*
+ * Calls fn(value, count) for the values of field in rows, or in all rows
+ * of input if rows is nullptr. For every partition of the column whose
+ * dictionary has at most half as many entries as there are rows, the
+ * occurrences of each value id are counted first and every distinct value
+ * is decoded only once. Values of other partitions are passed with a
+ * count of one each.
+ */
+template <typename R, typename F>
+void forEachValueCount(const c_atable_ptr_t &input, field_t field, const pos_list_t *rows, F fn) {
+  const size_t size = rows ? rows->size() : input->size();
+  std::vector<std::shared_ptr<BaseDictionary<R> > > dictionaries;
+  std::vector<std::vector<size_t> > histograms;
+  std::vector<bool> counted;
+
+  forEachValueId(input, field, rows, [&](const ValueId &vid) {
+      if (vid.table >= dictionaries.size()) {
+        dictionaries.resize(vid.table + 1);
+        histograms.resize(vid.table + 1);
+        counted.resize(vid.table + 1, false);
+      }
+      auto &dictionary = dictionaries[vid.table];
+      if (!dictionary) {
+        dictionary = std::static_pointer_cast<BaseDictionary<R> >(input->dictionaryByTableId(field, vid.table));
+        counted[vid.table] = dictionary->size() <= size / 2;
+        if (counted[vid.table])
+          histograms[vid.table].assign(dictionary->size(), 0);
+      }
+
+      if (counted[vid.table])
+        ++histograms[vid.table][vid.valueId];
+      else
+        fn(dictionary->getValueForValueId(vid.valueId), 1);
+    });
+
+  for (size_t table = 0; table < histograms.size(); ++table) {
+    for (value_id_t valueId = 0; valueId < histograms[table].size(); ++valueId) {
+      if (histograms[table][valueId] != 0)
+        fn(dictionaries[table]->getValueForValueId(valueId), histograms[table][valueId]);
+    }
+  }
+}
+
 struct sum_aggregate_functor {
   typedef void value_type;
 
@@ -40,23 +105,16 @@ struct sum_aggregate_functor {
   template <typename R>
   void operator()() {
     R result = 0;
-
-    if (rows != nullptr) {
-      for (const auto& currentRow: *rows) {
-        result += input->getValue<R>(sourceField, currentRow);
-      }
-    } else {
-      size_t input_size = input->size();
-
-      for (size_t i = 0; i < input_size; ++i) {
-        result += input->getValue<R>(sourceField, i);
-      }
-    }
-
+    forEachValueCount<R>(input, sourceField, rows, [&result](const R &value, size_t count) {
+        result += value * static_cast<R>(count);
+      });
     target->setValue<R>(targetColumn, targetRow, result);
   }
 };
 
+template<>
+void sum_aggregate_functor::operator()<std::string>();
+
 struct average_aggregate_functor {
   typedef void value_type;
 
@@ -81,27 +139,84 @@ struct average_aggregate_functor {
 template<typename R>
 void average_aggregate_functor::operator()() {
   R sum = 0;
-  int count = 0;
+  int count = rows != nullptr ? rows->size() : input->size();
 
-  if (rows != NULL) {
-    for (const auto& currentRow: *rows) {
-      sum += input->getValue<R>(sourceField, currentRow);
-    }
-    count = rows->size();
-  } else {
-    size_t input_size = input->size();
-
-    for (size_t i = 0; i < input_size; ++i) {
-      sum += input->getValue<R>(sourceField, i);
-    }
-    count = input->size();
-  }
+  forEachValueCount<R>(input, sourceField, rows, [&sum](const R &value, size_t occurrences) {
+      sum += value * static_cast<R>(occurrences);
+    });
 
   target->setValue<float>(targetColumn, targetRow, ((float)sum / count));
 }
 
 template<>
 void average_aggregate_functor::operator()<std::string>();
+
+/// MIN or MAX of a column. Value ids of ordered dictionaries are compared
+/// without decoding, only the extreme value id of each partition is
+/// decoded; values of unordered partitions are decoded and compared.
+struct extremum_aggregate_functor {
+  typedef void value_type;
+
+  const hyrise::storage::c_atable_ptr_t& input;
+  hyrise::storage::atable_ptr_t& target;
+  pos_list_t *rows;
+  field_t sourceField;
+  std::string targetColumn;
+  size_t targetRow;
+  bool maximum;
+
+  extremum_aggregate_functor(const hyrise::storage::c_atable_ptr_t& i,
+                             hyrise::storage::atable_ptr_t& t,
+                             pos_list_t *forRows,
+                             field_t sourceF,
+                             std::string column,
+                             size_t toRow,
+                             bool max): input(i), target(t), rows(forRows), sourceField(sourceF), targetColumn(column), targetRow(toRow), maximum(max) {};
+
+  template <typename R>
+  void operator()();
+};
+
+template<typename R>
+void extremum_aggregate_functor::operator()() {
+  const value_id_t none = std::numeric_limits<value_id_t>::max();
+  std::vector<std::shared_ptr<BaseDictionary<R> > > dictionaries;
+  std::vector<value_id_t> extremes;
+  bool found = false;
+  R result = R();
+
+  auto take = [&](const R &value) {
+    if (!found || (maximum ? result < value : value < result)) {
+      result = value;
+      found = true;
+    }
+  };
+
+  forEachValueId(input, sourceField, rows, [&](const ValueId &vid) {
+      if (vid.table >= dictionaries.size()) {
+        dictionaries.resize(vid.table + 1);
+        extremes.resize(vid.table + 1, none);
+      }
+      auto &dictionary = dictionaries[vid.table];
+      if (!dictionary)
+        dictionary = std::static_pointer_cast<BaseDictionary<R> >(input->dictionaryByTableId(sourceField, vid.table));
+
+      if (dictionary->isOrdered()) {
+        value_id_t &extreme = extremes[vid.table];
+        if (extreme == none || (maximum ? extreme < vid.valueId : vid.valueId < extreme))
+          extreme = vid.valueId;
+      } else {
+        take(dictionary->getValueForValueId(vid.valueId));
+      }
+    });
+
+  for (size_t table = 0; table < extremes.size(); ++table) {
+    if (extremes[table] != none)
+      take(dictionaries[table]->getValueForValueId(extremes[table]));
+  }
+
+  target->setValue<R>(targetColumn, targetRow, result);
+}
 }
 }
 
@@ -109,7 +224,9 @@ struct AggregateFunctions {
   enum type {
     SUM,
     COUNT,
-    AVG
+    AVG,
+    MIN,
+    MAX
   };
 };
 
@@ -145,6 +262,9 @@ class AggregateFun {
   virtual void processValuesForRows(const hyrise::storage::c_atable_ptr_t& t, 
     pos_list_t *rows, hyrise::storage::atable_ptr_t& target, size_t targetRow) = 0;
   virtual DataType getType() const = 0;
+  /// kind of aggregation, lets operators that keep partial aggregates
+  /// instead of position lists compute the function themselves
+  virtual AggregateFunctions::type getFunctionType() const = 0;
   virtual std::string columnName(const std::string &oldName) = 0;
 };
 
@@ -183,6 +303,10 @@ class SumAggregateFun: public AggregateFun {
     }
   }
 
+  virtual AggregateFunctions::type getFunctionType() const {
+    return AggregateFunctions::SUM;
+  }
+
   virtual std::string columnName(const std::string &oldName) {
     return "SUM(" + oldName + ")";
   }
@@ -219,6 +343,10 @@ class CountAggregateFun: public AggregateFun {
     return IntegerType;
   }
 
+  virtual AggregateFunctions::type getFunctionType() const {
+    return AggregateFunctions::COUNT;
+  }
+
   virtual std::string columnName(const std::string &oldName) {
     return "COUNT(" + oldName + ")";
   }
@@ -257,6 +385,10 @@ class AverageAggregateFun: public AggregateFun {
     }
   }
 
+  virtual AggregateFunctions::type getFunctionType() const {
+    return AggregateFunctions::AVG;
+  }
+
   virtual std::string columnName(const std::string &oldName) {
     return "AVG(" + oldName + ")";
   }
@@ -264,4 +396,80 @@ class AverageAggregateFun: public AggregateFun {
   static AggregateFun *parse(const Json::Value &);
 };
 
+class MinAggregateFun: public AggregateFun {
+  DataType _datatype;
+
+ public:
+  explicit MinAggregateFun(field_t field): AggregateFun(field) { }
+  explicit MinAggregateFun(field_name_t field): AggregateFun(field) { }
+  virtual ~MinAggregateFun() {};
+
+  /*!
+   * finds the smallest value of the given rows, if rows == nullptr
+   * all rows of the input table are considered
+   */
+  virtual void processValuesForRows(const hyrise::storage::c_atable_ptr_t& t, pos_list_t *rows, hyrise::storage::atable_ptr_t& target, size_t targetRow) {
+    hyrise::storage::extremum_aggregate_functor fun(t, target, rows, _field, columnName(t->nameOfColumn(_field)), targetRow, false);
+    hyrise::storage::type_switch<hyrise_basic_types> ts;
+    ts(_datatype, fun);
+  }
+
+  virtual DataType getType() const {
+    return _datatype;
+  }
+
+  virtual void walk(const AbstractTable &table) {
+    AggregateFun::walk(table);
+    _datatype = table.typeOfColumn(_field);
+  }
+
+  virtual AggregateFunctions::type getFunctionType() const {
+    return AggregateFunctions::MIN;
+  }
+
+  virtual std::string columnName(const std::string &oldName) {
+    return "MIN(" + oldName + ")";
+  }
+
+  static AggregateFun *parse(const Json::Value &);
+};
+
+class MaxAggregateFun: public AggregateFun {
+  DataType _datatype;
+
+ public:
+  explicit MaxAggregateFun(field_t field): AggregateFun(field) { }
+  explicit MaxAggregateFun(field_name_t field): AggregateFun(field) { }
+  virtual ~MaxAggregateFun() {};
+
+  /*!
+   * finds the greatest value of the given rows, if rows == nullptr
+   * all rows of the input table are considered
+   */
+  virtual void processValuesForRows(const hyrise::storage::c_atable_ptr_t& t, pos_list_t *rows, hyrise::storage::atable_ptr_t& target, size_t targetRow) {
+    hyrise::storage::extremum_aggregate_functor fun(t, target, rows, _field, columnName(t->nameOfColumn(_field)), targetRow, true);
+    hyrise::storage::type_switch<hyrise_basic_types> ts;
+    ts(_datatype, fun);
+  }
+
+  virtual DataType getType() const {
+    return _datatype;
+  }
+
+  virtual void walk(const AbstractTable &table) {
+    AggregateFun::walk(table);
+    _datatype = table.typeOfColumn(_field);
+  }
+
+  virtual AggregateFunctions::type getFunctionType() const {
+    return AggregateFunctions::MAX;
+  }
+
+  virtual std::string columnName(const std::string &oldName) {
+    return "MAX(" + oldName + ")";
+  }
+
+  static AggregateFun *parse(const Json::Value &);
+};
+
 #endif // AGGEGATEFUNCTIONS
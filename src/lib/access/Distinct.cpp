@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/Distinct.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "access/BasicParser.h"
@@ -31,13 +32,17 @@ void Distinct::executePlanOperation() {
   // iterate over all rows
   const auto &in = input.getTable(0);
   uint64_t numRows = in->size();
-  ValueId val;
+  ValueIdList value_ids(VALUE_ID_BATCH_SIZE);
 
   // Build distinct value list
-  for (uint64_t i = 0; i < numRows; ++i) {
-    val = in->getValueId(distinct, i);
-    if (map.count(val.valueId) == 0)
-      map[val.valueId] = i;
+  for (uint64_t start = 0; start < numRows; start += VALUE_ID_BATCH_SIZE) {
+    uint64_t stop = std::min<uint64_t>(start + VALUE_ID_BATCH_SIZE, numRows);
+    in->getValueIds(distinct, start, stop, value_ids.data());
+    for (uint64_t i = start; i < stop; ++i) {
+      const auto &val = value_ids[i - start];
+      if (map.count(val.valueId) == 0)
+        map[val.valueId] = i;
+    }
   }
 
   //Build result list
@@ -19,7 +19,7 @@ GetTable::~GetTable() {
 }
 
 void GetTable::executePlanOperation() {
-  output.add(StorageManager::getInstance()->getTable(_name));
+  output.add(StorageManager::getInstance()->getTableSnapshot(_name));
 }
 
 std::shared_ptr<_PlanOperation> GetTable::parse(Json::Value& data) {
@@ -22,11 +22,6 @@ write_group_functor::write_group_functor(const c_atable_ptr_t &t,
                                          _row(toRow) {
 }
 
-template <typename R>
-void write_group_functor::operator()() {
-  _target->setValue<R>(_input->nameOfColumn(_columnNr), _row, _input->getValue<R>(_columnNr, _sourceRow));
-}
-
 }
 }
 
@@ -69,20 +64,23 @@ void GroupByScan::executePlanOperation() {
 
 std::shared_ptr<_PlanOperation> GroupByScan::parse(Json::Value &v) {
   std::shared_ptr<GroupByScan> gs = std::make_shared<GroupByScan>();
+  parseGroupBy(*gs, v);
+  return gs;
+}
 
+void GroupByScan::parseGroupBy(GroupByScan &gs, Json::Value &v) {
   if (v.isMember("fields")) {
     for (unsigned i = 0; i <  v["fields"].size(); ++i) {
-      gs->addField(v["fields"][i]);
+      gs.addField(v["fields"][i]);
     }
   }
 
   if (v.isMember("functions")) {
     for (unsigned i = 0; i < v["functions"].size(); ++i) {
       const Json::Value &f = v["functions"][i];
-      gs->addFunction(parseAggregateFunction(f));
+      gs.addFunction(parseAggregateFunction(f));
     }
   }
-  return gs;
 }
 
 const std::string GroupByScan::vname() {
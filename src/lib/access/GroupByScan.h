@@ -32,6 +32,11 @@ private:
   pos_t _row;
 };
 
+template <typename R>
+void write_group_functor::operator()() {
+  _target->setValue<R>(_input->nameOfColumn(_columnNr), _row, _input->getValue<R>(_columnNr, _sourceRow));
+}
+
 }
 }
 
@@ -73,9 +78,14 @@ public:
   /// _field_definitions member of _PlanOperation holds
   /// added (grouping) fields
   storage::atable_ptr_t createResultTableLayout();
-  /// adds a given AggregateFunction to group by scan instance SUM or COUNT
+  /// adds a given AggregateFunction to group by scan instance SUM, COUNT, AVG, MIN or MAX
   void addFunction(AggregateFun *fun);
 
+protected:
+  /// reads the grouping fields and aggregate functions of gs from v
+  static void parseGroupBy(GroupByScan &gs, Json::Value &v);
+  std::vector<AggregateFun *> _aggregate_functions;
+
 private:
   void splitInput();
   void writeGroupResult(storage::atable_ptr_t &resultTab,
@@ -84,7 +94,6 @@ private:
   /// Depending on the number of fields to group by choose the appropriate map type
   template<typename HashTableType, typename MapType, typename KeyType>
   void executeGroupBy();
-  std::vector<AggregateFun *> _aggregate_functions;
 };
 
 }
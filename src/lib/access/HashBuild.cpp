@@ -2,7 +2,9 @@
 #include "access/HashBuild.h"
 
 #include "storage/HashTable.h"
+#include "storage/JoinFilter.h"
 #include "storage/TableRangeView.h"
+#include "storage/ValueIdHashTable.h"
 
 namespace hyrise {
 namespace access {
@@ -11,6 +13,9 @@ namespace {
   auto _ = QueryParser::registerPlanOperation<HashBuild>("HashBuild");
 }
 
+HashBuild::HashBuild() : _buildJoinFilter(false) {
+}
+
 HashBuild::~HashBuild() {
 }
 
@@ -20,19 +25,26 @@ void HashBuild::executePlanOperation() {
   auto input = std::dynamic_pointer_cast<const TableRangeView>(getInputTable());
   if(input) 
     row_offset = input->getStart();   
+  storage::ahashtable_ptr_t hashTable;
   if (_key == "groupby" || _key == "selfjoin" ) {
     if (_field_definition.size() == 1)
-        addResultHash(std::make_shared<SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset));
-      else
-        addResultHash(std::make_shared<AggregateHashTable>(getInputTable(), _field_definition, row_offset));
+      hashTable = std::make_shared<SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset);
+    else
+      hashTable = std::make_shared<AggregateHashTable>(getInputTable(), _field_definition, row_offset);
   } else if (_key == "join") {
     if (_field_definition.size() == 1)
-      addResultHash(std::make_shared<SingleJoinHashTable>(getInputTable(), _field_definition, row_offset));      
+      hashTable = std::make_shared<SingleJoinHashTable>(getInputTable(), _field_definition, row_offset);
     else
-      addResultHash(std::make_shared<JoinHashTable>(getInputTable(), _field_definition, row_offset));
+      hashTable = std::make_shared<JoinHashTable>(getInputTable(), _field_definition, row_offset);
+  } else if (_key == "valueid") {
+    hashTable = std::make_shared<ValueIdHashTable>(getInputTable(), _field_definition, row_offset);
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
+
+  if (_buildJoinFilter)
+    hashTable->setJoinFilter(std::make_shared<JoinFilter>(getInputTable(), _field_definition));
+  addResultHash(hashTable);
 }
 
 std::shared_ptr<_PlanOperation> HashBuild::parse(Json::Value &data) {
@@ -45,6 +57,7 @@ std::shared_ptr<_PlanOperation> HashBuild::parse(Json::Value &data) {
   if (data.isMember("key")) {
     instance->setKey(data["key"].asString());
   }
+  instance->setBuildJoinFilter(data["filter"].asBool());
   return instance;
 }
 
@@ -60,5 +73,9 @@ const std::string HashBuild::getKey() const {
   return _key;
 }
 
+void HashBuild::setBuildJoinFilter(const bool buildJoinFilter) {
+  _buildJoinFilter = buildJoinFilter;
+}
+
 }
 }
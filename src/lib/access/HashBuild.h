@@ -9,6 +9,7 @@ namespace access {
 
 class HashBuild : public _PlanOperation {
 public:
+  HashBuild();
   virtual ~HashBuild();
 
   void executePlanOperation();
@@ -21,18 +22,26 @@ public:
   ///         },
   ///         "1": {
   ///             "type": "HashBuild",
-  ///             "fields" : [1]
+  ///             "fields" : [1],
+  ///             "key": "join",
+  ///             "filter": true
   ///         },
   ///     },
   ///         "edges": [["0", "1"]]
   /// }
+  /// With "filter", a JoinFilter of the hashed keys is attached to the
+  /// hash table for scans on the probe input (see SimpleTableScan).
+  /// The key "valueid" builds a ValueIdHashTable on a single field, which
+  /// HashJoinProbe matches by translated value ids instead of value hashes.
   static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
   const std::string vname();
   void setKey(const std::string &key);
   const std::string getKey() const;
+  void setBuildJoinFilter(bool buildJoinFilter);
 
 private:
   std::string _key;
+  bool _buildJoinFilter;
 };
 
 }
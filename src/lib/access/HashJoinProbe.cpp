@@ -6,6 +6,7 @@
 #include "storage/HashTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/PointerCalculatorFactory.h"
+#include "storage/ValueIdHashTable.h"
 
 namespace hyrise {
 namespace access {
@@ -30,7 +31,13 @@ void HashJoinProbe::executePlanOperation() {
   storage::pos_list_t *buildTablePosList = new pos_list_t;
   storage::pos_list_t *probeTablePosList = new pos_list_t;
 
-  if (_selfjoin) {
+  const auto &valueIdHashTable = std::dynamic_pointer_cast<const ValueIdHashTable>(getInputHashTable(0));
+  if (valueIdHashTable) {
+    if (_field_definition.size() != 1)
+      throw std::runtime_error("HashJoinProbe on value ids needs exactly one probe field");
+    valueIdHashTable->probe(getProbeTable(), _field_definition[0], 0, getProbeTable()->size(),
+                            *buildTablePosList, *probeTablePosList);
+  } else if (_selfjoin) {
     if (_field_definition.size() == 1)
       fetchPositions<SingleAggregateHashTable>(buildTablePosList, probeTablePosList);
     else
@@ -11,6 +11,8 @@ namespace access {
 /// The HashJoinProbe operator performs the probe phase of a hash join to
 /// produce the join result.
 /// It takes the build table's AbstractHashTable and the probe table as input.
+/// A ValueIdHashTable (HashBuild key "valueid") is probed with translated
+/// value ids of the probe field instead of hashed values.
 class HashJoinProbe : public _PlanOperation {
 public:
   HashJoinProbe();
@@ -87,7 +87,7 @@ void Histogram::executeHistogram() {
   if (p) {
     auto ipair = getDataVector(p->getActualTable(), p->getTableColumnForColumn(field));
     const auto &ivec = ipair.first;
-    const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
+    const auto &dict = std::dynamic_pointer_cast<BaseDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
     const auto &offset = ipair.second;
 
     auto hasher = std::hash<T>();
@@ -98,7 +98,7 @@ void Histogram::executeHistogram() {
   } else {
     auto ipair = getDataVector(tab, field);
     const auto &ivec = ipair.first;
-    const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(field));
+    const auto &dict = std::dynamic_pointer_cast<BaseDictionary<T>>(tab->dictionaryAt(field));
     const auto &offset =  ipair.second;
 
     auto hasher = std::hash<T>();
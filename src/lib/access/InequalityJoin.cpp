@@ -0,0 +1,212 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/InequalityJoin.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "access/QueryParser.h"
+#include "access/SortKey.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/BitVector.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+auto _ = QueryParser::registerPlanOperation<InequalityJoin>("InequalityJoin");
+
+// Keys of the fields of a predicate for the rows of both inputs
+struct predicate_keys_t {
+  std::vector<uint64_t> left;
+  std::vector<uint64_t> right;
+  uint64_t max;
+  size_t bits;
+};
+
+predicate_keys_t keysOf(const storage::c_atable_ptr_t &left,
+                        const storage::c_atable_ptr_t &right,
+                        const InequalityJoin::predicate_t &predicate) {
+  const auto keys = SortKey::common({left, right}, {predicate.left, predicate.right});
+  return {SortKey::keysOf(left, keys, 0), SortKey::keysOf(right, keys, 1), keys[0].max, keys[0].bits()};
+}
+
+std::vector<pos_t> allRows(const size_t size) {
+  std::vector<pos_t> rows(size);
+  for (pos_t row = 0; row < size; ++row)
+    rows[row] = row;
+  return rows;
+}
+
+// Range [first, last) of the sorted keys k that satisfy key comparison k
+void rangeOf(const std::vector<uint64_t> &sorted, const uint64_t key, const JoinComparison::type comparison,
+             size_t &first, size_t &last) {
+  first = 0;
+  last = sorted.size();
+  switch (comparison) {
+    case JoinComparison::LESS:
+      first = std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+      break;
+    case JoinComparison::LESS_EQUAL:
+      first = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+      break;
+    case JoinComparison::GREATER:
+      last = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+      break;
+    case JoinComparison::GREATER_EQUAL:
+      last = std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+      break;
+  }
+}
+
+JoinComparison::type parseComparison(const std::string &op) {
+  if (op == "LT") return JoinComparison::LESS;
+  if (op == "LE") return JoinComparison::LESS_EQUAL;
+  if (op == "GT") return JoinComparison::GREATER;
+  if (op == "GE") return JoinComparison::GREATER_EQUAL;
+  throw std::runtime_error("Unknown join comparison " + op);
+}
+
+}
+
+InequalityJoin::~InequalityJoin() {
+}
+
+void InequalityJoin::executePlanOperation() {
+  if (_predicates.empty() || _predicates.size() > 2)
+    throw std::runtime_error("InequalityJoin needs one or two predicates");
+
+  const auto &left = input.getTable(0);
+  const auto &right = input.getTable(1);
+  const size_t left_size = left->size();
+  const size_t right_size = right->size();
+
+  // right rows in the order of the first predicate
+  auto x = keysOf(left, right, _predicates[0]);
+  const auto x_comparison = _predicates[0].comparison;
+  auto right_by_x = allRows(right_size);
+  radixSort(x.right, right_by_x, x.bits);
+
+  const size_t morsels = morselCount(left_size);
+  std::vector<pos_list_t> left_parts(morsels), right_parts(morsels);
+
+  if (_predicates.size() == 1) {
+    executeMorsels(left_size, [&](size_t morsel, size_t start, size_t stop) {
+        size_t first, last;
+        for (pos_t row = start; row < stop; ++row) {
+          rangeOf(x.right, x.left[row], x_comparison, first, last);
+          for (size_t i = first; i < last; ++i) {
+            left_parts[morsel].push_back(row);
+            right_parts[morsel].push_back(right_by_x[i]);
+          }
+        }
+      });
+  } else {
+    auto y = keysOf(left, right, _predicates[1]);
+    auto y_comparison = _predicates[1].comparison;
+
+    // left < right holds where the inverted keys satisfy left > right
+    if (y_comparison == JoinComparison::LESS || y_comparison == JoinComparison::LESS_EQUAL) {
+      for (auto &key : y.left)
+        key = y.max - key;
+      for (auto &key : y.right)
+        key = y.max - key;
+      y_comparison = y_comparison == JoinComparison::LESS ? JoinComparison::GREATER : JoinComparison::GREATER_EQUAL;
+    }
+
+    // Visiting the left rows by ascending key, the right rows with a
+    // smaller key only ever get more
+    auto left_by_y = allRows(left_size);
+    radixSort(y.left, left_by_y, y.bits);
+    auto right_by_y = allRows(right_size);
+    radixSort(y.right, right_by_y, y.bits);
+
+    std::vector<size_t> x_position(right_size);
+    for (size_t i = 0; i < right_size; ++i)
+      x_position[right_by_x[i]] = i;
+
+    // Participants claim morsels in ascending order, each one marks the
+    // right rows satisfying the second predicate in its own bit vector
+    // over the order of the first one
+    const size_t participants = morselParticipants(left_size);
+    std::vector<BitVector> marked(participants, BitVector(right_size));
+    std::vector<size_t> next_right(participants, 0);
+
+    executeMorselsPerParticipant(left_size, [&](size_t participant, size_t morsel, size_t start, size_t stop) {
+        auto &bits = marked[participant];
+        auto &next = next_right[participant];
+        size_t first, last;
+        for (size_t i = start; i < stop; ++i) {
+          const uint64_t key = y.left[i];
+          while (next < right_size &&
+                 (y.right[next] < key || (y_comparison == JoinComparison::GREATER_EQUAL && y.right[next] == key))) {
+            bits.set(x_position[right_by_y[next]], true);
+            ++next;
+          }
+
+          const pos_t row = left_by_y[i];
+          rangeOf(x.right, x.left[row], x_comparison, first, last);
+          for (size_t bit = bits.nextSetBit(first); bit < last; bit = bits.nextSetBit(bit + 1)) {
+            left_parts[morsel].push_back(row);
+            right_parts[morsel].push_back(right_by_x[bit]);
+          }
+        }
+      });
+  }
+
+  std::vector<size_t> offsets(morsels + 1, 0);
+  for (size_t morsel = 0; morsel < morsels; ++morsel)
+    offsets[morsel + 1] = offsets[morsel] + left_parts[morsel].size();
+
+  auto left_pos = new pos_list_t(offsets[morsels]);
+  auto right_pos = new pos_list_t(offsets[morsels]);
+  executeMorsels(morsels, [&](size_t, size_t first, size_t last) {
+      for (size_t morsel = first; morsel < last; ++morsel) {
+        std::copy(left_parts[morsel].begin(), left_parts[morsel].end(), left_pos->begin() + offsets[morsel]);
+        std::copy(right_parts[morsel].begin(), right_parts[morsel].end(), right_pos->begin() + offsets[morsel]);
+      }
+    }, 1);
+
+  std::vector<storage::atable_ptr_t> parts({
+    std::dynamic_pointer_cast<AbstractTable>(PointerCalculatorFactory::createPointerCalculatorNonRef(left, nullptr, left_pos)),
+    std::dynamic_pointer_cast<AbstractTable>(PointerCalculatorFactory::createPointerCalculatorNonRef(right, nullptr, right_pos))
+  });
+
+  addResult(std::make_shared<MutableVerticalTable>(parts));
+}
+
+std::shared_ptr<_PlanOperation> InequalityJoin::parse(Json::Value &data) {
+  std::shared_ptr<InequalityJoin> s = std::make_shared<InequalityJoin>();
+  for (unsigned i = 0; i < data["predicates"].size(); ++i) {
+    const Json::Value &predicate = data["predicates"][i];
+    const Json::Value &fields = predicate["fields"];
+    if (predicate["op"].asString() == "BETWEEN") {
+      s->addBetween(fields[0u].asUInt(), fields[1u].asUInt(), fields[2u].asUInt());
+    } else {
+      s->addPredicate(fields[0u].asUInt(), parseComparison(predicate["op"].asString()), fields[1u].asUInt());
+    }
+  }
+  return s;
+}
+
+const std::string InequalityJoin::vname() {
+  return "InequalityJoin";
+}
+
+void InequalityJoin::addPredicate(const field_t left_field, const JoinComparison::type comparison, const field_t right_field) {
+  _predicates.push_back({left_field, comparison, right_field});
+}
+
+void InequalityJoin::addBetween(const field_t field, const field_t lower, const field_t upper) {
+  addPredicate(field, JoinComparison::GREATER_EQUAL, lower);
+  addPredicate(field, JoinComparison::LESS_EQUAL, upper);
+}
+
+}
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_INEQUALITYJOIN_H_
+#define SRC_LIB_ACCESS_INEQUALITYJOIN_H_
+
+#include <vector>
+
+#include "access/PlanOperation.h"
+#include "helper/types.h"
+
+namespace hyrise {
+namespace access {
+
+struct JoinComparison {
+  enum type {
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL
+  };
+};
+
+/// Joins two tables on one or two inequalities between a field of the
+/// left and a field of the right input, e.g. left.a < right.b, or a band
+/// like left.a BETWEEN right.lo AND right.hi, following IEJoin: the
+/// right rows are sorted by the field of the first inequality, so the
+/// matches of a left row form one range of them. For a second
+/// inequality the left rows are visited in the order of its field, the
+/// right rows that satisfy it are marked in a bit vector over the first
+/// order and the matches are the marked bits in the range. Values are
+/// not compared, both fields of an inequality are translated into one
+/// domain of keys like for MergeJoin. The left rows are split into
+/// morsels, each participant of the execution keeps its own bit vector.
+///
+/// Parameters: "predicates" lists one or two inequalities, each with
+/// "op" "LT", "LE", "GT" or "GE" and "fields" with the left and the
+/// right field; "BETWEEN" takes the left field, the lower and the upper
+/// bound field of the right input.
+/// Query graph inputs:
+/// 1. left table
+/// 2. right table
+/// Query graph output:
+/// - a MutableVerticalTable of the positions of the matching rows of
+///   both inputs
+class InequalityJoin : public _PlanOperation {
+public:
+  virtual ~InequalityJoin();
+
+  void executePlanOperation();
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
+  const std::string vname();
+
+  /// Adds the condition left.left_field comparison right.right_field
+  void addPredicate(const field_t left_field, const JoinComparison::type comparison, const field_t right_field);
+
+  /// Adds the condition left.field BETWEEN right.lower AND right.upper
+  void addBetween(const field_t field, const field_t lower, const field_t upper);
+
+  struct predicate_t {
+    field_t left;
+    JoinComparison::type comparison;
+    field_t right;
+  };
+
+private:
+  std::vector<predicate_t> _predicates;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_INEQUALITYJOIN_H_
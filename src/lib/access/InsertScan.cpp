@@ -15,9 +15,13 @@ void InsertScan::executePlanOperation() {
     throw std::runtime_error("Insert without delta is not supported");
   }
 
-  size_t max = store->getDeltaTable()->size();
-  store->getDeltaTable()->resize(max + 1);
-  store->getDeltaTable()->copyRowFrom(_data, 0, max, true);
+  // a snapshot's delta may be frozen by a merge, rows go to the live delta
+  const auto live = store->liveStore();
+  auto deltaLock = live->lockDelta();
+  const auto &delta = live->getDeltaTable();
+  size_t max = delta->size();
+  delta->resize(max + 1);
+  delta->copyRowFrom(_data, 0, max, true);
 
   addResult(input.getTable(0));
 }
@@ -0,0 +1,47 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_JOINFILTEREXPRESSION_H_
+#define SRC_LIB_ACCESS_JOINFILTEREXPRESSION_H_
+
+#include "access/AbstractExpression.h"
+#include "storage/JoinFilter.h"
+
+namespace hyrise { namespace access {
+
+/// Removes the rows without a possible join partner from the positions
+/// matched by another expression, or from all rows if there is none.
+/// Does not own the wrapped expression, which has to be walked already.
+class JoinFilterExpression : public AbstractExpression {
+ public:
+  JoinFilterExpression(AbstractExpression *expression,
+                       const JoinFilter &filter,
+                       const storage::c_atable_ptr_t &table,
+                       const field_list_t &fields) :
+      _expression(expression), _filter(filter), _table(table), _fields(fields) {}
+
+  virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) {
+    _table = l.at(0);
+  }
+
+  virtual storage::pos_list_t* match(const size_t start, const size_t stop) {
+    storage::pos_list_t *positions;
+    if (_expression) {
+      positions = _expression->match(start, stop);
+    } else {
+      positions = new storage::pos_list_t(stop - start);
+      for (size_t row = start; row < stop; ++row)
+        (*positions)[row - start] = row;
+    }
+    _filter.filter(_table, _fields, *positions);
+    return positions;
+  }
+
+ private:
+  AbstractExpression *_expression;
+  const JoinFilter &_filter;
+  storage::c_atable_ptr_t _table;
+  const field_list_t _fields;
+};
+
+}}
+
+#endif  // SRC_LIB_ACCESS_JOINFILTEREXPRESSION_H_
@@ -47,7 +47,7 @@ void LayoutTableLoad::executePlanOperation() {
     CSVInput input(_file_name, CSVInput::params().setCSVParams(csv::HYRISE_FORMAT));
     StorageManager *sm = StorageManager::getInstance();
     sm->loadTable(_table_name, Loader::params().setHeader(header).setInput(input));
-    addResult(sm->getTable(_table_name));
+    addResult(sm->getTableSnapshot(_table_name));
   } else {
     throw std::runtime_error("Input of LayoutTableLoad doesn't have at least one field to begin with");
   }
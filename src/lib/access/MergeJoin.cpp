@@ -0,0 +1,162 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MergeJoin.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include "access/BasicParser.h"
+#include "access/QueryParser.h"
+#include "access/SortKey.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+auto _ = QueryParser::registerPlanOperation<MergeJoin>("MergeJoin");
+
+// Join keys of one input in key order with their rows
+struct sorted_input_t {
+  std::vector<uint64_t> keys;
+  std::vector<pos_t> rows;
+};
+
+bool isSorted(const std::vector<uint64_t> &keys) {
+  std::atomic<bool> sorted(true);
+  executeMorsels(keys.size(), [&](size_t, size_t start, size_t stop) {
+      for (size_t i = std::max<size_t>(start, 1); i < stop && sorted; ++i)
+        if (keys[i - 1] > keys[i])
+          sorted = false;
+    });
+  return sorted;
+}
+
+sorted_input_t sortInput(const storage::c_atable_ptr_t &table, const std::vector<SortKey> &keys, const size_t input) {
+  sorted_input_t result;
+  result.keys = SortKey::keysOf(table, keys, input);
+  result.rows.resize(result.keys.size());
+  for (pos_t row = 0; row < result.rows.size(); ++row)
+    result.rows[row] = row;
+
+  // inputs sorted on the join field, e.g. by a previous join, stay as
+  // they are
+  if (!isSorted(result.keys))
+    radixSort(result.keys, result.rows, keys[input].bits());
+  return result;
+}
+
+// Merges the left keys [left, left_end) with the right keys [right,
+// right_end), every pair of rows with equal keys is a match
+void merge(const sorted_input_t &left_input, size_t left, const size_t left_end,
+           const sorted_input_t &right_input, size_t right, const size_t right_end,
+           pos_list_t &left_pos, pos_list_t &right_pos) {
+  const auto &left_keys = left_input.keys;
+  const auto &right_keys = right_input.keys;
+  while (left < left_end && right < right_end) {
+    if (left_keys[left] < right_keys[right]) {
+      ++left;
+    } else if (right_keys[right] < left_keys[left]) {
+      ++right;
+    } else {
+      const uint64_t key = left_keys[left];
+      size_t left_run = left, right_run = right;
+      while (left_run < left_end && left_keys[left_run] == key)
+        ++left_run;
+      while (right_run < right_end && right_keys[right_run] == key)
+        ++right_run;
+
+      for (size_t l = left; l < left_run; ++l) {
+        for (size_t r = right; r < right_run; ++r) {
+          left_pos.push_back(left_input.rows[l]);
+          right_pos.push_back(right_input.rows[r]);
+        }
+      }
+      left = left_run;
+      right = right_run;
+    }
+  }
+}
+
+}
+
+MergeJoin::~MergeJoin() {
+}
+
+void MergeJoin::executePlanOperation() {
+  if (!producesPositions) {
+    throw std::runtime_error("MergeJoin execute() not supported with producesPositions == false");
+  }
+  if (_field_definition.size() != 2) {
+    throw std::runtime_error("MergeJoin needs one field per input");
+  }
+
+  const auto &left_table = input.getTable(0);
+  const auto &right_table = input.getTable(1);
+  const auto keys = SortKey::common({left_table, right_table}, {_field_definition[0], _field_definition[1]});
+
+  const auto left = sortInput(left_table, keys, 0);
+  const auto right = sortInput(right_table, keys, 1);
+
+  // Partitions start at morsel boundaries of the left keys, moved past
+  // runs of equal keys so that each key is merged by one partition only;
+  // the right keys of a partition start at its first left key
+  const size_t partitions = morselCount(left.keys.size());
+  std::vector<size_t> left_bounds(partitions + 1, left.keys.size());
+  std::vector<size_t> right_bounds(partitions + 1, right.keys.size());
+  left_bounds[0] = right_bounds[0] = 0;
+  for (size_t partition = 1; partition < partitions; ++partition) {
+    size_t bound = std::max(partition * DEFAULT_MORSEL_SIZE, left_bounds[partition - 1]);
+    while (bound > 0 && bound < left.keys.size() && left.keys[bound - 1] == left.keys[bound])
+      ++bound;
+    left_bounds[partition] = bound;
+    if (bound < left.keys.size())
+      right_bounds[partition] = std::lower_bound(right.keys.begin(), right.keys.end(), left.keys[bound]) - right.keys.begin();
+  }
+
+  std::vector<pos_list_t> left_parts(partitions), right_parts(partitions);
+  executeMorsels(partitions, [&](size_t, size_t first, size_t last) {
+      for (size_t partition = first; partition < last; ++partition)
+        merge(left, left_bounds[partition], left_bounds[partition + 1],
+              right, right_bounds[partition], right_bounds[partition + 1],
+              left_parts[partition], right_parts[partition]);
+    }, 1);
+
+  std::vector<size_t> offsets(partitions + 1, 0);
+  for (size_t partition = 0; partition < partitions; ++partition)
+    offsets[partition + 1] = offsets[partition] + left_parts[partition].size();
+
+  auto left_pos = new pos_list_t(offsets[partitions]);
+  auto right_pos = new pos_list_t(offsets[partitions]);
+  executeMorsels(partitions, [&](size_t, size_t first, size_t last) {
+      for (size_t partition = first; partition < last; ++partition) {
+        std::copy(left_parts[partition].begin(), left_parts[partition].end(), left_pos->begin() + offsets[partition]);
+        std::copy(right_parts[partition].begin(), right_parts[partition].end(), right_pos->begin() + offsets[partition]);
+      }
+    }, 1);
+
+  std::vector<storage::atable_ptr_t> parts({
+    std::dynamic_pointer_cast<AbstractTable>(PointerCalculatorFactory::createPointerCalculatorNonRef(left_table, nullptr, left_pos)),
+    std::dynamic_pointer_cast<AbstractTable>(PointerCalculatorFactory::createPointerCalculatorNonRef(right_table, nullptr, right_pos))
+  });
+
+  addResult(std::make_shared<MutableVerticalTable>(parts));
+}
+
+std::shared_ptr<_PlanOperation> MergeJoin::parse(Json::Value &data) {
+  return BasicParser<MergeJoin>::parse(data);
+}
+
+const std::string MergeJoin::vname() {
+  return "MergeJoin";
+}
+
+}
+}
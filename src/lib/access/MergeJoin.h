@@ -0,0 +1,38 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_MERGEJOIN_H_
+#define SRC_LIB_ACCESS_MERGEJOIN_H_
+
+#include "access/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Equi join of two tables that sorts both inputs on their join field
+/// and merges them. Values are not compared: the value ids of both
+/// fields are translated into one domain of integer keys, where value ids
+/// of a single shared ordered dictionary are the keys already. Inputs
+/// whose keys are in order are not sorted, the others are radix sorted
+/// in parallel, and the merge is split into partitions of the left keys
+/// that are merged in parallel.
+///
+/// Parameters: "fields" holds the join field of the left and of the
+/// right input.
+/// Query graph inputs:
+/// 1. left table
+/// 2. right table
+/// Query graph output:
+/// - a MutableVerticalTable of the positions of the matching rows of
+///   both inputs, ordered by the join key
+class MergeJoin : public _PlanOperation {
+public:
+  virtual ~MergeJoin();
+
+  void executePlanOperation();
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
+  const std::string vname();
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_MERGEJOIN_H_
@@ -24,7 +24,7 @@ void MySQLTableLoad::executePlanOperation() {
   StorageManager *sm = StorageManager::getInstance();
   storage::atable_ptr_t t;
   if (sm->exists(_table_name)) {
-    t = sm->getTable(_table_name);
+    t = sm->getTableSnapshot(_table_name);
     addResult(t);
   } else {
     t = Loader::load(
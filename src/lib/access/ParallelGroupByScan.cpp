@@ -0,0 +1,371 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/ParallelGroupByScan.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "access/QueryParser.h"
+
+#include "storage/BaseDictionary.h"
+#include "storage/HashTable.h"
+#include "storage/OpenAddressingMultimap.h"
+#include "storage/meta_storage.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerPlanOperation<ParallelGroupByScan>("ParallelGroupByScan");
+
+  // Hash partitions per participant in which the partial aggregates are merged
+  const size_t PARTITIONS_PER_PARTICIPANT = 4;
+
+  typedef OpenAddressingKeyIndex<aggregate_key_t> group_index_t;
+
+  union partial_sum_t {
+    hyrise_int_t integer;
+    double floating;
+  };
+
+  template <typename T>
+  struct partial_sum_of;
+
+  template <>
+  struct partial_sum_of<hyrise_int_t> {
+    static hyrise_int_t &get(partial_sum_t &sum) { return sum.integer; }
+  };
+
+  template <>
+  struct partial_sum_of<hyrise_float_t> {
+    static double &get(partial_sum_t &sum) { return sum.floating; }
+  };
+
+  /// adds the values of a batch of value ids to the partial sums of their groups
+  template <typename T>
+  void addValues(const storage::c_atable_ptr_t &table,
+                 const field_t field,
+                 const ValueIdList &valueIds,
+                 const std::vector<size_t> &groups,
+                 const size_t count,
+                 std::vector<partial_sum_t> &sums,
+                 const size_t stride,
+                 const size_t slot) {
+    std::shared_ptr<BaseDictionary<T> > dictionary;
+    table_id_t dictionaryTable = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const ValueId &vid = valueIds[i];
+      if (!dictionary || vid.table != dictionaryTable) {
+        dictionary = std::dynamic_pointer_cast<BaseDictionary<T> >(table->dictionaryByTableId(field, vid.table));
+        dictionaryTable = vid.table;
+      }
+      partial_sum_of<T>::get(sums[groups[i] * stride + slot]) += dictionary->getValueForValueId(vid.valueId);
+    }
+  }
+
+  /// orders the value ids of a column by their values, value ids of the
+  /// same ordered dictionary are compared without decoding
+  class value_order_t {
+   public:
+    virtual ~value_order_t() {}
+    virtual bool less(const ValueId &a, const ValueId &b) = 0;
+
+    static std::unique_ptr<value_order_t> of(const storage::c_atable_ptr_t &table, const field_t field);
+  };
+
+  template <typename T>
+  class typed_value_order_t : public value_order_t {
+   public:
+    typed_value_order_t(const storage::c_atable_ptr_t &table, const field_t field) : _table(table), _field(field) {}
+
+    virtual bool less(const ValueId &a, const ValueId &b) {
+      const auto &dictionary = dictionaryOf(a.table);
+      if (a.table == b.table && dictionary->isOrdered())
+        return a.valueId < b.valueId;
+      return dictionary->getValueForValueId(a.valueId) < dictionaryOf(b.table)->getValueForValueId(b.valueId);
+    }
+
+   private:
+    const std::shared_ptr<BaseDictionary<T> > &dictionaryOf(const table_id_t table) {
+      if (table >= _dictionaries.size())
+        _dictionaries.resize(table + 1);
+      if (!_dictionaries[table])
+        _dictionaries[table] = std::dynamic_pointer_cast<BaseDictionary<T> >(_table->dictionaryByTableId(_field, table));
+      return _dictionaries[table];
+    }
+
+    const storage::c_atable_ptr_t _table;
+    const field_t _field;
+    std::vector<std::shared_ptr<BaseDictionary<T> > > _dictionaries;
+  };
+
+  std::unique_ptr<value_order_t> value_order_t::of(const storage::c_atable_ptr_t &table, const field_t field) {
+    switch (table->typeOfColumn(field)) {
+      case IntegerType:
+        return std::unique_ptr<value_order_t>(new typed_value_order_t<hyrise_int_t>(table, field));
+      case FloatType:
+        return std::unique_ptr<value_order_t>(new typed_value_order_t<hyrise_float_t>(table, field));
+      default:
+        return std::unique_ptr<value_order_t>(new typed_value_order_t<hyrise_string_t>(table, field));
+    }
+  }
+
+  /// value id of a group whose extreme was not set yet
+  const value_id_t NO_VALUE_ID = std::numeric_limits<value_id_t>::max();
+
+  /// replaces extreme by candidate if it is smaller, or greater for MAX
+  inline void takeExtreme(value_order_t &order, const bool maximum, const ValueId &candidate, ValueId &extreme) {
+    if (extreme.valueId == NO_VALUE_ID || (maximum ? order.less(extreme, candidate) : order.less(candidate, extreme)))
+      extreme = candidate;
+  }
+
+  inline size_t partitionOf(const size_t hash, const size_t partitions) {
+    return ((hash * 0x9e3779b97f4a7c15ull) >> 40) % partitions;
+  }
+}
+
+/// Aggregates of the groups seen by one participant or of one partition
+struct ParallelGroupByScan::PartialAggregates {
+  group_index_t index;
+  /// first input row of every group, used to write the grouping fields
+  std::vector<pos_t> rows;
+  std::vector<hyrise_int_t> counts;
+  /// _sum_fields.size() partial sums per group
+  std::vector<partial_sum_t> sums;
+  /// _extreme_fields.size() value ids of the minimum or maximum per group
+  std::vector<ValueId> extremes;
+
+  size_t addGroup(const size_t group, const pos_t row, const size_t sumCount, const size_t extremeCount) {
+    if (group == rows.size()) {
+      rows.push_back(row);
+      counts.push_back(0);
+      partial_sum_t zero;
+      zero.integer = 0;
+      sums.resize(sums.size() + sumCount, zero);
+      ValueId none;
+      none.valueId = NO_VALUE_ID;
+      none.table = 0;
+      extremes.resize(extremes.size() + extremeCount, none);
+    }
+    return group;
+  }
+};
+
+ParallelGroupByScan::ParallelGroupByScan() : _morselSize(DEFAULT_MORSEL_SIZE) {
+}
+
+ParallelGroupByScan::~ParallelGroupByScan() {
+}
+
+void ParallelGroupByScan::executePlanOperation() {
+  // without grouping fields, there is only one group
+  if (_field_definition.size() == 0)
+    return GroupByScan::executePlanOperation();
+
+  const auto &table = getInputTable(0);
+
+  _slots.clear();
+  _sum_fields.clear();
+  _sum_types.clear();
+  _extreme_fields.clear();
+  _extreme_maximum.clear();
+  for (const auto &fun : _aggregate_functions) {
+    switch (fun->getFunctionType()) {
+      case AggregateFunctions::COUNT:
+        _slots.push_back(0);
+        break;
+      case AggregateFunctions::MIN:
+      case AggregateFunctions::MAX:
+        _slots.push_back(_extreme_fields.size());
+        _extreme_fields.push_back(fun->getField());
+        _extreme_maximum.push_back(fun->getFunctionType() == AggregateFunctions::MAX);
+        break;
+      default:
+        if (table->typeOfColumn(fun->getField()) == StringType)
+          throw std::runtime_error(fun->getFunctionType() == AggregateFunctions::SUM ?
+                                   "Cannot calculate sum for column of StringType" :
+                                   "Cannot calculate average for column of StringType");
+        _slots.push_back(_sum_fields.size());
+        _sum_fields.push_back(fun->getField());
+        _sum_types.push_back(table->typeOfColumn(fun->getField()));
+    }
+  }
+
+  const size_t participants = morselParticipants(table->size(), _morselSize);
+  std::vector<PartialAggregates> partials(participants);
+  executeMorselsPerParticipant(table->size(), [&](size_t participant, size_t, size_t start, size_t stop) {
+      aggregateRows(partials[participant], start, stop);
+    }, _morselSize);
+
+  if (participants == 1)
+    return writeResult(partials);
+
+  // Sort the groups of every participant into hash partitions, then merge
+  // all participants' groups of a partition on one thread
+  const size_t partitions = participants * PARTITIONS_PER_PARTICIPANT;
+  std::vector<std::vector<std::vector<uint32_t> > > partitionGroups(participants);
+  executeMorsels(participants, [&](size_t participant, size_t, size_t) {
+      auto &groups = partitionGroups[participant];
+      const auto &partial = partials[participant];
+      groups.resize(partitions);
+      for (size_t group = 0; group < partial.rows.size(); ++group)
+        groups[partitionOf(partial.index.hashAt(group), partitions)].push_back(group);
+    }, 1);
+
+  const size_t sumCount = _sum_fields.size();
+  const size_t extremeCount = _extreme_fields.size();
+  std::vector<PartialAggregates> merged(partitions);
+  executeMorsels(partitions, [&](size_t partition, size_t, size_t) {
+      auto &target = merged[partition];
+      std::vector<std::unique_ptr<value_order_t> > orders;
+      for (const auto &field : _extreme_fields)
+        orders.push_back(value_order_t::of(table, field));
+
+      for (size_t participant = 0; participant < participants; ++participant) {
+        const auto &source = partials[participant];
+        for (const auto &group : partitionGroups[participant][partition]) {
+          const size_t into = target.addGroup(target.index.findOrInsert(source.index.keyAt(group), source.index.hashAt(group)),
+                                              source.rows[group], sumCount, extremeCount);
+          target.rows[into] = std::min(target.rows[into], source.rows[group]);
+          target.counts[into] += source.counts[group];
+          for (size_t slot = 0; slot < sumCount; ++slot) {
+            partial_sum_t &sum = target.sums[into * sumCount + slot];
+            const partial_sum_t &add = source.sums[group * sumCount + slot];
+            if (_sum_types[slot] == IntegerType)
+              sum.integer += add.integer;
+            else
+              sum.floating += add.floating;
+          }
+          for (size_t slot = 0; slot < extremeCount; ++slot)
+            takeExtreme(*orders[slot], _extreme_maximum[slot], source.extremes[group * extremeCount + slot],
+                        target.extremes[into * extremeCount + slot]);
+        }
+      }
+    }, 1);
+
+  writeResult(merged);
+}
+
+void ParallelGroupByScan::aggregateRows(PartialAggregates &partial, const size_t start, const size_t stop) const {
+  const auto &table = getInputTable(0);
+  const size_t fieldCount = _field_definition.size();
+  const size_t sumCount = _sum_fields.size();
+  const size_t extremeCount = _extreme_fields.size();
+
+  std::vector<std::unique_ptr<value_order_t> > orders;
+  for (const auto &field : _extreme_fields)
+    orders.push_back(value_order_t::of(table, field));
+
+  std::vector<ValueIdList> keyIds(fieldCount, ValueIdList(VALUE_ID_BATCH_SIZE));
+  ValueIdList valueIds(VALUE_ID_BATCH_SIZE);
+  std::vector<size_t> groups(VALUE_ID_BATCH_SIZE);
+  aggregate_key_t key(fieldCount);
+
+  for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+    const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+    for (size_t f = 0; f < fieldCount; ++f)
+      table->getValueIds(_field_definition[f], batch, batch + count, keyIds[f].data());
+
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t f = 0; f < fieldCount; ++f)
+        key[f] = keyIds[f][i].valueId;
+      groups[i] = partial.addGroup(partial.index.findOrInsert(key, group_index_t::hash(key)), batch + i, sumCount, extremeCount);
+      ++partial.counts[groups[i]];
+    }
+
+    for (size_t slot = 0; slot < sumCount; ++slot) {
+      table->getValueIds(_sum_fields[slot], batch, batch + count, valueIds.data());
+      if (_sum_types[slot] == IntegerType)
+        addValues<hyrise_int_t>(table, _sum_fields[slot], valueIds, groups, count, partial.sums, sumCount, slot);
+      else
+        addValues<hyrise_float_t>(table, _sum_fields[slot], valueIds, groups, count, partial.sums, sumCount, slot);
+    }
+
+    for (size_t slot = 0; slot < extremeCount; ++slot) {
+      table->getValueIds(_extreme_fields[slot], batch, batch + count, valueIds.data());
+      for (size_t i = 0; i < count; ++i)
+        takeExtreme(*orders[slot], _extreme_maximum[slot], valueIds[i], partial.extremes[groups[i] * extremeCount + slot]);
+    }
+  }
+}
+
+void ParallelGroupByScan::writeResult(const std::vector<PartialAggregates> &partitions) {
+  const auto &table = getInputTable(0);
+  auto resultTab = createResultTableLayout();
+
+  size_t groups = 0;
+  for (const auto &partition : partitions)
+    groups += partition.rows.size();
+  resultTab->resize(groups);
+
+  std::vector<size_t> columns;
+  for (const auto &fun : _aggregate_functions)
+    columns.push_back(resultTab->numberOfColumn(fun->columnName(table->nameOfColumn(fun->getField()))));
+
+  const size_t sumCount = _sum_fields.size();
+  const size_t extremeCount = _extreme_fields.size();
+  storage::type_switch<hyrise_basic_types> ts;
+  pos_t row = 0;
+  for (const auto &partition : partitions) {
+    for (size_t group = 0; group < partition.rows.size(); ++group, ++row) {
+      for (const auto &columnNr : _field_definition) {
+        storage::write_group_functor fun(table, resultTab, partition.rows[group], (size_t)columnNr, row);
+        ts(table->typeOfColumn(columnNr), fun);
+      }
+
+      const hyrise_int_t count = partition.counts[group];
+      for (size_t f = 0; f < _aggregate_functions.size(); ++f) {
+        const size_t slot = _slots[f];
+        const auto type = _aggregate_functions[f]->getFunctionType();
+        const bool sums = type == AggregateFunctions::SUM || type == AggregateFunctions::AVG;
+        const bool integer = !sums || _sum_types[slot] == IntegerType;
+        const partial_sum_t *sum = sums ? &partition.sums[group * sumCount + slot] : nullptr;
+
+        switch (type) {
+          case AggregateFunctions::COUNT:
+            resultTab->setValue<hyrise_int_t>(columns[f], row, count);
+            break;
+          case AggregateFunctions::MIN:
+          case AggregateFunctions::MAX:
+            resultTab->copyValueFrom(table, _extreme_fields[slot], partition.extremes[group * extremeCount + slot], columns[f], row);
+            break;
+          case AggregateFunctions::SUM:
+            if (integer)
+              resultTab->setValue<hyrise_int_t>(columns[f], row, sum->integer);
+            else
+              resultTab->setValue<hyrise_float_t>(columns[f], row, sum->floating);
+            break;
+          case AggregateFunctions::AVG:
+            if (integer)
+              resultTab->setValue<hyrise_float_t>(columns[f], row, static_cast<hyrise_float_t>(sum->integer) / count);
+            else
+              resultTab->setValue<hyrise_float_t>(columns[f], row, sum->floating / count);
+            break;
+          default:
+            break;
+        }
+      }
+    }
+  }
+
+  addResult(resultTab);
+}
+
+std::shared_ptr<_PlanOperation> ParallelGroupByScan::parse(Json::Value &v) {
+  std::shared_ptr<ParallelGroupByScan> gs = std::make_shared<ParallelGroupByScan>();
+  parseGroupBy(*gs, v);
+  return gs;
+}
+
+const std::string ParallelGroupByScan::vname() {
+  return "ParallelGroupByScan";
+}
+
+void ParallelGroupByScan::setMorselSize(const size_t morselSize) {
+  _morselSize = morselSize;
+}
+
+}
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_PARALLELGROUPBYSCAN_H_
+#define SRC_LIB_ACCESS_PARALLELGROUPBYSCAN_H_
+
+#include <vector>
+
+#include "access/GroupByScan.h"
+
+namespace hyrise {
+namespace access {
+
+/// Group by with SUM, COUNT, AVG, MIN and MAX that needs no HashBuild.
+///
+/// The input is split into morsels and every participating thread keeps
+/// partial aggregates per group for the morsels it processes, keyed by
+/// the value ids of the grouping fields. The partials of all threads are
+/// then merged in parallel, every thread merging one hash partition of
+/// the groups, before the result table is written. MIN and MAX keep the
+/// value id of the extreme, which is decoded only to compare it with
+/// value ids of another dictionary.
+///
+/// Like HashBuild, groups are identified by value id only, so the input
+/// must not contain the same value with different value ids (e.g. in the
+/// main and delta partition of a store).
+class ParallelGroupByScan : public GroupByScan {
+public:
+  struct PartialAggregates;
+
+  ParallelGroupByScan();
+  virtual ~ParallelGroupByScan();
+
+  void executePlanOperation();
+  /// Takes the same fields and functions as the GroupByScan, but no
+  /// HashBuild:
+  /// {
+  ///     "operators": {
+  ///         "0": {
+  ///              "type": "TableLoad",
+  ///              "table": "table1",
+  ///              "filename": "..."
+  ///          },
+  ///          "1": {
+  ///              "type": "ParallelGroupByScan",
+  ///              "fields" : [1],
+  ///              "functions": [{"type": "SUM", "field": 2}]
+  ///          }
+  ///      },
+  ///      "edges": [["0", "1"]]
+  ///  }
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &v);
+  const std::string vname();
+  void setMorselSize(size_t morselSize);
+
+private:
+  void aggregateRows(PartialAggregates &partial, size_t start, size_t stop) const;
+  void writeResult(const std::vector<PartialAggregates> &partitions);
+
+  size_t _morselSize;
+  /// slot of each aggregate function in the partial sums or extremes,
+  /// COUNT has none
+  std::vector<size_t> _slots;
+  std::vector<field_t> _sum_fields;
+  std::vector<DataType> _sum_types;
+  std::vector<field_t> _extreme_fields;
+  std::vector<bool> _extreme_maximum;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_PARALLELGROUPBYSCAN_H_
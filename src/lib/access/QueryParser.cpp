@@ -58,7 +58,7 @@ void QueryParser::setInputs(
     const Json::Value &planOperationSpec) const {
   //  TODO: input implies table input at this moment
   for (unsigned j = 0; j < planOperationSpec["input"].size(); ++j) {
-    planOperation->addInput(StorageManager::getInstance()->getTable(
+    planOperation->addInput(StorageManager::getInstance()->getTableSnapshot(
         planOperationSpec["input"][j].asString()));
   }
 }
@@ -81,7 +81,7 @@ void RadixCluster::executeClustering() {
     auto ipair = getDataVector(p->getActualTable());
     const auto &ivec = ipair.first;
 
-    const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
+    const auto &dict = std::dynamic_pointer_cast<BaseDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
     const auto &offset = p->getTableColumnForColumn(field) + ipair.second;
 
     auto hasher = std::hash<T>();
@@ -98,7 +98,7 @@ void RadixCluster::executeClustering() {
   } else {
     auto ipair = getDataVector(tab);
     const auto &ivec = ipair.first;
-    const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(field));
+    const auto &dict = std::dynamic_pointer_cast<BaseDictionary<T>>(tab->dictionaryAt(field));
     const auto &offset = field + ipair.second;
 
     std::hash<T> hasher;
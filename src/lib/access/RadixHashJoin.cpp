@@ -0,0 +1,265 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/RadixHashJoin.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "access/QueryParser.h"
+
+#include "helper/HwlocHelper.h"
+
+#include "storage/BaseDictionary.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerPlanOperation<RadixHashJoin>("RadixHashJoin");
+
+  // Upper bound of the fanout of the single partitioning pass, the write
+  // combining buffers of all partitions (64 bytes each) still fit into L2
+  const uint32_t MAX_RADIX_BITS = 12;
+  // Assumed L2 size if the topology does not report one
+  const size_t DEFAULT_CACHE_SIZE = 256 * 1024;
+
+  struct radix_entry_t {
+    size_t hash;
+    pos_t row;
+  };
+
+  // Entries per write combining buffer, one cache line
+  const size_t BUFFER_ENTRIES = 64 / sizeof(radix_entry_t);
+
+  const uint32_t NO_ENTRY = ~0u;
+
+  inline size_t mix(size_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+  }
+
+  /// Join keys of one input, decoded once, and their hashes
+  template <typename T>
+  struct JoinInput {
+    std::vector<T> values;
+    std::vector<size_t> hashes;
+    /// entries grouped by partition, partition p owns [offsets[p], offsets[p + 1])
+    std::vector<radix_entry_t> entries;
+    std::vector<size_t> offsets;
+
+    void materialize(const storage::c_atable_ptr_t &table, const field_t field, const size_t morselSize) {
+      values.resize(table->size());
+      hashes.resize(table->size());
+      executeMorsels(table->size(), [&](size_t, size_t start, size_t stop) {
+          ValueIdList valueIds(VALUE_ID_BATCH_SIZE);
+          std::shared_ptr<BaseDictionary<T> > dictionary;
+          table_id_t dictionaryTable = 0;
+          std::hash<T> hasher;
+          for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+            const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+            table->getValueIds(field, batch, batch + count, valueIds.data());
+            for (size_t i = 0; i < count; ++i) {
+              const ValueId &vid = valueIds[i];
+              if (!dictionary || vid.table != dictionaryTable) {
+                dictionary = std::static_pointer_cast<BaseDictionary<T> >(table->dictionaryByTableId(field, vid.table));
+                dictionaryTable = vid.table;
+              }
+              values[batch + i] = dictionary->getValueForValueId(vid.valueId);
+              hashes[batch + i] = mix(hasher(values[batch + i]));
+            }
+          }
+        }, morselSize);
+    }
+
+    /// Scatters all rows into 2^bits partitions by the low bits of their
+    /// hash. Every morsel first counts its rows per partition, so that
+    /// all morsels can write to disjoint ranges without synchronization.
+    void partition(const uint32_t bits, const size_t morselSize) {
+      const size_t size = hashes.size();
+      const size_t fanout = size_t(1) << bits;
+      const size_t mask = fanout - 1;
+      const size_t morsels = morselCount(size, morselSize);
+
+      std::vector<size_t> cursors(morsels * fanout, 0);
+      executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+          size_t *histogram = &cursors[morsel * fanout];
+          for (size_t row = start; row < stop; ++row)
+            ++histogram[hashes[row] & mask];
+        }, morselSize);
+
+      offsets.assign(fanout + 1, 0);
+      size_t sum = 0;
+      for (size_t p = 0; p < fanout; ++p) {
+        offsets[p] = sum;
+        for (size_t morsel = 0; morsel < morsels; ++morsel) {
+          const size_t count = cursors[morsel * fanout + p];
+          cursors[morsel * fanout + p] = sum;
+          sum += count;
+        }
+      }
+      offsets[fanout] = sum;
+
+      entries.resize(size);
+      executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+          size_t *cursor = &cursors[morsel * fanout];
+          std::vector<radix_entry_t> buffers(fanout * BUFFER_ENTRIES);
+          std::vector<size_t> fill(fanout, 0);
+          for (size_t row = start; row < stop; ++row) {
+            const size_t p = hashes[row] & mask;
+            radix_entry_t *buffer = &buffers[p * BUFFER_ENTRIES];
+            buffer[fill[p]].hash = hashes[row];
+            buffer[fill[p]].row = row;
+            if (++fill[p] == BUFFER_ENTRIES) {
+              std::copy(buffer, buffer + BUFFER_ENTRIES, entries.data() + cursor[p]);
+              cursor[p] += BUFFER_ENTRIES;
+              fill[p] = 0;
+            }
+          }
+          for (size_t p = 0; p < fanout; ++p)
+            std::copy(buffers.data() + p * BUFFER_ENTRIES, buffers.data() + p * BUFFER_ENTRIES + fill[p], entries.data() + cursor[p]);
+        }, morselSize);
+    }
+  };
+}
+
+RadixHashJoin::RadixHashJoin() : _fixedBits(false), _bits(0), _morselSize(DEFAULT_MORSEL_SIZE) {
+}
+
+RadixHashJoin::~RadixHashJoin() {
+}
+
+void RadixHashJoin::executePlanOperation() {
+  if (_field_definition.size() != 2 || input.numberOfTables() != 2)
+    throw std::runtime_error("RadixHashJoin needs two input tables and one join field of each");
+
+  const DataType type = getInputTable(0)->typeOfColumn(_field_definition[0]);
+  if (type != getInputTable(1)->typeOfColumn(_field_definition[1]))
+    throw std::runtime_error("RadixHashJoin fields must have the same type");
+
+  switch (type) {
+    case IntegerType:
+      return executeJoin<hyrise_int_t>();
+    case FloatType:
+      return executeJoin<hyrise_float_t>();
+    case StringType:
+      return executeJoin<hyrise_string_t>();
+  }
+}
+
+template <typename T>
+void RadixHashJoin::executeJoin() {
+  JoinInput<T> inputs[2];
+  inputs[0].materialize(getInputTable(0), _field_definition[0], _morselSize);
+  inputs[1].materialize(getInputTable(1), _field_definition[1], _morselSize);
+
+  // build on the smaller input
+  const size_t buildSide = inputs[1].values.size() < inputs[0].values.size() ? 1 : 0;
+  const JoinInput<T> &build = inputs[buildSide];
+  const JoinInput<T> &probe = inputs[1 - buildSide];
+
+  const uint32_t bits = _fixedBits ? _bits : radixBits(build.values.size());
+  inputs[0].partition(bits, _morselSize);
+  inputs[1].partition(bits, _morselSize);
+
+  const size_t fanout = size_t(1) << bits;
+  std::vector<pos_list_t> buildRows(fanout), probeRows(fanout);
+  executeMorsels(fanout, [&](size_t p, size_t, size_t) {
+      const radix_entry_t *buildEntries = build.entries.data() + build.offsets[p];
+      const size_t buildCount = build.offsets[p + 1] - build.offsets[p];
+      if (buildCount == 0 || probe.offsets[p + 1] == probe.offsets[p])
+        return;
+
+      // chained hash table on the hash bits above the radix bits
+      size_t buckets = 1;
+      while (buckets < buildCount)
+        buckets <<= 1;
+      std::vector<uint32_t> heads(buckets, NO_ENTRY);
+      std::vector<uint32_t> next(buildCount);
+      for (size_t i = 0; i < buildCount; ++i) {
+        const size_t bucket = (buildEntries[i].hash >> bits) & (buckets - 1);
+        next[i] = heads[bucket];
+        heads[bucket] = i;
+      }
+
+      for (size_t e = probe.offsets[p]; e < probe.offsets[p + 1]; ++e) {
+        const radix_entry_t &entry = probe.entries[e];
+        const T &value = probe.values[entry.row];
+        for (uint32_t i = heads[(entry.hash >> bits) & (buckets - 1)]; i != NO_ENTRY; i = next[i]) {
+          if (buildEntries[i].hash == entry.hash && build.values[buildEntries[i].row] == value) {
+            buildRows[p].push_back(buildEntries[i].row);
+            probeRows[p].push_back(entry.row);
+          }
+        }
+      }
+    }, 1);
+
+  size_t matches = 0;
+  for (const auto &rows : buildRows)
+    matches += rows.size();
+
+  auto leftRows = new pos_list_t;
+  auto rightRows = new pos_list_t;
+  leftRows->reserve(matches);
+  rightRows->reserve(matches);
+  for (size_t p = 0; p < fanout; ++p) {
+    const pos_list_t &left = buildSide == 0 ? buildRows[p] : probeRows[p];
+    const pos_list_t &right = buildSide == 0 ? probeRows[p] : buildRows[p];
+    leftRows->insert(leftRows->end(), left.begin(), left.end());
+    rightRows->insert(rightRows->end(), right.begin(), right.end());
+  }
+
+  std::vector<storage::atable_ptr_t> parts;
+  parts.push_back(PointerCalculatorFactory::createPointerCalculatorNonRef(getInputTable(0), nullptr, leftRows));
+  parts.push_back(PointerCalculatorFactory::createPointerCalculatorNonRef(getInputTable(1), nullptr, rightRows));
+  addResult(std::make_shared<MutableVerticalTable>(parts));
+}
+
+uint32_t RadixHashJoin::radixBits(const size_t buildSize) {
+  static const size_t reportedCacheSize = getCacheSizeOnSystem(2);
+  const size_t cacheSize = reportedCacheSize ? reportedCacheSize : DEFAULT_CACHE_SIZE;
+  // a partition entry plus its bucket head and chain link
+  const size_t bytesPerRow = sizeof(radix_entry_t) + 2 * sizeof(uint32_t);
+
+  uint32_t bits = 0;
+  while (bits < MAX_RADIX_BITS && ((buildSize * bytesPerRow) >> bits) > cacheSize / 2)
+    ++bits;
+  return bits;
+}
+
+std::shared_ptr<_PlanOperation> RadixHashJoin::parse(Json::Value &data) {
+  std::shared_ptr<RadixHashJoin> instance = std::make_shared<RadixHashJoin>();
+  if (data.isMember("fields")) {
+    for (unsigned i = 0; i < data["fields"].size(); ++i) {
+      instance->addField(data["fields"][i]);
+    }
+  }
+  if (data.isMember("bits"))
+    instance->setBits(data["bits"].asUInt());
+  return instance;
+}
+
+const std::string RadixHashJoin::vname() {
+  return "RadixHashJoin";
+}
+
+void RadixHashJoin::setBits(const uint32_t bits) {
+  if (bits > MAX_RADIX_BITS)
+    throw std::runtime_error("RadixHashJoin supports at most " + std::to_string(MAX_RADIX_BITS) + " radix bits");
+  _fixedBits = true;
+  _bits = bits;
+}
+
+void RadixHashJoin::setMorselSize(const size_t morselSize) {
+  _morselSize = morselSize;
+}
+
+}
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_RADIXHASHJOIN_H_
+#define SRC_LIB_ACCESS_RADIXHASHJOIN_H_
+
+#include "access/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Parallel partitioned hash equi-join of two tables on one field each.
+///
+/// Both inputs are radix partitioned on the hash of their join key in a
+/// single parallel pass over morsels, writing through software
+/// write-combining buffers of one cache line per partition. The number
+/// of radix bits is chosen so that a partition of the smaller input and
+/// its hash table fit into half of the L2 cache. Each pair of partitions
+/// is then joined by an independent task.
+///
+/// The result holds the matching rows of the first input followed by
+/// the matching rows of the second input.
+class RadixHashJoin : public _PlanOperation {
+public:
+  RadixHashJoin();
+  virtual ~RadixHashJoin();
+
+  void executePlanOperation();
+  /// {
+  ///     "operators": {
+  ///         "0": {
+  ///             "type": "TableLoad",
+  ///             "table": "table1",
+  ///             "filename": "..."
+  ///         },
+  ///         "1": {
+  ///             "type": "TableLoad",
+  ///             "table": "table2",
+  ///             "filename": "..."
+  ///         },
+  ///         "2": {
+  ///             "type": "RadixHashJoin",
+  ///             "fields" : [0, 1]
+  ///         }
+  ///     },
+  ///     "edges": [["0", "2"], ["1", "2"]]
+  /// }
+  /// fields holds the join field of the first and of the second input,
+  /// the optional "bits" overrides the number of radix bits, values above
+  /// the supported fanout are rejected.
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
+  const std::string vname();
+  void setBits(uint32_t bits);
+  void setMorselSize(size_t morselSize);
+  /// Radix bits for a build input of the given number of rows
+  static uint32_t radixBits(size_t buildSize);
+
+private:
+  template <typename T>
+  void executeJoin();
+
+  bool _fixedBits;
+  uint32_t _bits;
+  size_t _morselSize;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_RADIXHASHJOIN_H_
@@ -0,0 +1,119 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/SemiJoin.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include "access/QueryParser.h"
+
+#include "storage/AbstractHashTable.h"
+#include "storage/BitVector.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+#include "storage/ValueIdHashTable.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _semi = QueryParser::registerPlanOperation<SemiJoin>("SemiJoin");
+  auto _anti = QueryParser::registerPlanOperation<AntiJoin>("AntiJoin");
+}
+
+SemiJoin::SemiJoin() : _anti(false) {
+}
+
+SemiJoin::~SemiJoin() {
+}
+
+void SemiJoin::executePlanOperation() {
+  const auto &probe = getInputTable(0);
+  const auto &hash_table = getInputHashTable(0);
+  const size_t size = probe->size();
+  std::vector<pos_list_t> parts(morselCount(size));
+
+  const auto &value_id_hash_table = std::dynamic_pointer_cast<const ValueIdHashTable>(hash_table);
+  if (value_id_hash_table) {
+    if (_field_definition.size() != 1)
+      throw std::runtime_error("SemiJoin on value ids needs exactly one probe field");
+    const field_t field = _field_definition[0];
+
+    // matching value ids per probe dictionary, marked by the first
+    // morsel that needs them
+    std::map<table_id_t, std::shared_ptr<const BitVector>> matching;
+    std::mutex matching_mutex;
+
+    executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+        ValueIdList value_ids(VALUE_ID_BATCH_SIZE);
+        std::shared_ptr<const BitVector> current;
+        table_id_t current_table = 0;
+        for (pos_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+          const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+          probe->getValueIds(field, batch, batch + count, value_ids.data());
+          for (size_t i = 0; i < count; ++i) {
+            const ValueId &value_id = value_ids[i];
+            if (!current || current_table != value_id.table) {
+              std::lock_guard<std::mutex> lock(matching_mutex);
+              auto &bits = matching[value_id.table];
+              if (!bits)
+                bits = std::make_shared<BitVector>(value_id_hash_table->matchingValueIds(probe, field, value_id.table));
+              current = bits;
+              current_table = value_id.table;
+            }
+            if (current->get(value_id.valueId) != _anti)
+              parts[morsel].push_back(batch + i);
+          }
+        }
+      });
+  } else {
+    executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+        for (pos_t row = start; row < stop; ++row) {
+          if (hash_table->contains(probe, _field_definition, row) != _anti)
+            parts[morsel].push_back(row);
+        }
+      });
+  }
+
+  auto positions = new pos_list_t;
+  for (const auto &part : parts)
+    positions->insert(positions->end(), part.begin(), part.end());
+  addResult(PointerCalculatorFactory::createPointerCalculatorNonRef(probe, nullptr, positions));
+}
+
+std::shared_ptr<_PlanOperation> SemiJoin::parse(Json::Value &data) {
+  std::shared_ptr<SemiJoin> instance = std::make_shared<SemiJoin>();
+  for (unsigned i = 0; i < data["fields"].size(); ++i)
+    instance->addField(data["fields"][i]);
+  instance->setAnti(data["anti"].asBool());
+  return instance;
+}
+
+const std::string SemiJoin::vname() {
+  return "SemiJoin";
+}
+
+void SemiJoin::setAnti(const bool anti) {
+  _anti = anti;
+}
+
+AntiJoin::AntiJoin() {
+  setAnti(true);
+}
+
+std::shared_ptr<_PlanOperation> AntiJoin::parse(Json::Value &data) {
+  std::shared_ptr<AntiJoin> instance = std::make_shared<AntiJoin>();
+  for (unsigned i = 0; i < data["fields"].size(); ++i)
+    instance->addField(data["fields"][i]);
+  return instance;
+}
+
+const std::string AntiJoin::vname() {
+  return "AntiJoin";
+}
+
+}
+}
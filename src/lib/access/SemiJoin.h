@@ -0,0 +1,52 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SEMIJOIN_H_
+#define SRC_LIB_ACCESS_SEMIJOIN_H_
+
+#include "access/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Returns the rows of the probe table that have a match in the hash
+/// table of the build side, or with "anti" set, the rows without one,
+/// as for EXISTS, IN and NOT EXISTS. Probing a row stops at its first
+/// match and no build positions are collected, every probe row is
+/// returned at most once. A ValueIdHashTable is not probed per row at
+/// all: the value ids of each probe dictionary that have a build row are
+/// marked in a bit vector once, afterwards every row tests one bit.
+///
+/// Parameters: "fields" are the probe fields; "anti" returns the rows
+/// without a match.
+/// Query graph inputs:
+/// 1. hash table of the build table (HashBuild)
+/// 2. probe table
+/// Query graph output:
+/// - positions of the probe table
+class SemiJoin : public _PlanOperation {
+public:
+  SemiJoin();
+  virtual ~SemiJoin();
+
+  void executePlanOperation();
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
+  const std::string vname();
+
+  void setAnti(const bool anti);
+
+private:
+  bool _anti;
+};
+
+/// SemiJoin returning the probe rows without a match
+class AntiJoin : public SemiJoin {
+public:
+  AntiJoin();
+
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
+  const std::string vname();
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_SEMIJOIN_H_
@@ -1,8 +1,11 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/SimpleTableScan.h"
 
+#include "access/JoinFilterExpression.h"
 #include "access/pred_buildExpression.h"
 
+#include "storage/AbstractHashTable.h"
+#include "storage/ChunkedTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/PointerCalculatorFactory.h"
 
@@ -22,52 +25,55 @@ SimpleTableScan::~SimpleTableScan() {
 }
 
 void SimpleTableScan::setupPlanOperation() {
-  _comparator->walk(input.getTables());
+  if (_comparator)
+    _comparator->walk(input.getTables());
+
+  if (!_join_filter_fields.empty() && input.numberOfHashTables() > 0)
+    _join_filter = input.getHashTable(0)->getJoinFilter();
+  if (!_comparator && !_join_filter)
+    throw std::runtime_error("SimpleTableScan needs predicates or a join filter");
 }
 
 void SimpleTableScan::executePlanOperation() {
-  storage::pos_list_t *pos_list = nullptr;
-  storage::atable_ptr_t result_table;
-
+  const auto &table = input.getTable(0);
+
+  // Predicates choose the fastest way to produce positions themselves,
+  // e.g. by scanning the attribute vector directly, the input is split
+  // into morsels that are matched in parallel, chunked tables into
+  // their chunks
+  const size_t morselSize = ChunkedTable::morselSizeFor(table);
+  std::unique_ptr<JoinFilterExpression> filtered;
+  if (_join_filter)
+    filtered.reset(new JoinFilterExpression(_comparator, *_join_filter, table, _join_filter_fields));
+  AbstractExpression &expression = filtered ? static_cast<AbstractExpression &>(*filtered) : *_comparator;
+
+  // Positions are stored as range or bitmap if that is smaller
   if (producesPositions) {
-    pos_list = new pos_list_t();
-  } else {
-    result_table = input.getTable(0)->copy_structure_modifiable();
-  }
-
-  // Iterate over the data
-  size_t input_size = input.getTable(0)->size();
-  size_t target_row = 0;
-
-  for (size_t row = 0; row < input_size; ++row) {
-    // Execute the predicate on the list
-    if ((*_comparator)(row)) {
-      if (producesPositions) {
-        pos_list->push_back(row);
-      } else {
-        // TODO materializing result set will make the allocation the boundary
-        result_table->resize(target_row + 1);
-        result_table->copyRowFrom(input.getTable(0),
-                                  row,
-                                  target_row++,
-                                  true /* Copy Value*/,
-                                  false /* Use Memcpy */);
-      }
+    auto positions = matchMorselsToPointerCalculator(expression, table, morselSize);
+    if (positions->size() > 0) {
+      addResult(positions);
+    } else {
+      addResult(table->copy_structure_modifiable());
     }
+    return;
   }
 
-  storage::atable_ptr_t result;
-
-  // In case we are creating positions copy the pos_list
-  if (producesPositions) {
-    if (!pos_list->empty()) {
-      result = PointerCalculatorFactory::createPointerCalculatorNonRef(input.getTable(), nullptr, pos_list);
-    } else {
-      result = input.getTable()->copy_structure_modifiable();
+  storage::pos_list_t *pos_list = matchMorsels(expression, table->size(), morselSize);
+  storage::atable_ptr_t result = table->copy_structure_modifiable();
+
+  // Materialize the matching rows, the result is allocated only once
+  if (!pos_list->empty()) {
+    result->resize(pos_list->size());
+    size_t target_row = 0;
+    for (const auto& row : *pos_list) {
+      result->copyRowFrom(table,
+                          row,
+                          target_row++,
+                          true /* Copy Value*/,
+                          false /* Use Memcpy */);
     }
-  } else {
-    result = result_table;
   }
+  delete pos_list;
   addResult(result);
 }
 
@@ -77,10 +83,16 @@ std::shared_ptr<_PlanOperation> SimpleTableScan::parse(Json::Value &data) {
   if (data.isMember("materializing"))
     pop->setProducesPositions(!data["materializing"].asBool());
 
-  if (!data.isMember("predicates")) {
+  if (data.isMember("join_filter_fields")) {
+    field_list_t fields;
+    for (unsigned i = 0; i < data["join_filter_fields"].size(); ++i)
+      fields.push_back(data["join_filter_fields"][i].asUInt());
+    pop->setJoinFilterFields(fields);
+  } else if (!data.isMember("predicates")) {
     throw std::runtime_error("There is no reason for a Selection without predicates");
   }
-  pop->setPredicate(buildExpression(data["predicates"]));
+  if (data.isMember("predicates"))
+    pop->setPredicate(buildExpression(data["predicates"]));
 
   return pop;
 }
@@ -93,5 +105,9 @@ void SimpleTableScan::setPredicate(SimpleExpression *c) {
   _comparator = c;
 }
 
+void SimpleTableScan::setJoinFilterFields(const field_list_t &fields) {
+  _join_filter_fields = fields;
+}
+
 }
 }
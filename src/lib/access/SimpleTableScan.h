@@ -5,6 +5,8 @@
 #include "access/PlanOperation.h"
 #include "access/pred_SimpleExpression.h"
 
+class JoinFilter;
+
 namespace hyrise {
 namespace access {
 
@@ -15,12 +17,19 @@ public:
 
   void setupPlanOperation();
   void executePlanOperation();
+  /// Besides the predicates, accepts "join_filter_fields": the join
+  /// fields of the scanned table if it is the probe input of a hash
+  /// join. The JoinFilter of a hash table input built with "filter" is
+  /// then applied to these fields and the predicates become optional.
   static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
   const std::string vname();
   void setPredicate(SimpleExpression *c);
+  void setJoinFilterFields(const field_list_t &fields);
 
 private:
   SimpleExpression *_comparator;
+  field_list_t _join_filter_fields;
+  std::shared_ptr<const JoinFilter> _join_filter;
 };
 
 }
@@ -0,0 +1,366 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/SortKey.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "storage/AbstractTable.h"
+#include "storage/BaseDictionary.h"
+#include "storage/ChunkedTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/meta_storage.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+// Bits of a key sorted per pass of the radix sort
+const size_t RADIX_BITS = 8;
+const size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+
+// Whether the value ids of table can be looked up per table id
+bool hasDictionaries(const storage::c_atable_ptr_t &table, bool &single) {
+  auto actual = table;
+  if (const auto pc = std::dynamic_pointer_cast<const PointerCalculator>(table))
+    actual = pc->getActualTable();
+
+  single = std::dynamic_pointer_cast<const Table<>>(actual) ||
+           std::dynamic_pointer_cast<const MutableVerticalTable>(actual) ||
+           std::dynamic_pointer_cast<const ChunkedTable>(actual);
+  return single || std::dynamic_pointer_cast<const Store>(actual);
+}
+
+table_id_t subtables(const storage::c_atable_ptr_t &table) {
+  if (const auto pc = std::dynamic_pointer_cast<const PointerCalculator>(table))
+    return pc->getActualTable()->subtableCount();
+  return table->subtableCount();
+}
+
+/*
+ * Ranks the values of field in each of tables in one domain, equal
+ * values get the same rank no matter which table or dictionary they are
+ * from.
+ *
+ * The largest ordered dictionary, usually a main, is the anchor: its
+ * values are only binary searched and its value ids are the ranks unless
+ * other dictionaries add values, then they are shifted in one linear
+ * pass. The other dictionaries are sorted lists of values already if
+ * they are ordered; unordered ones, e.g. of a delta, are sorted. Tables
+ * without dictionaries per table id rank the distinct values of their
+ * rows the same way. All lists are merged linearly.
+ */
+struct RankValues {
+  typedef void value_type;
+
+  const std::vector<storage::c_atable_ptr_t> &tables;
+  std::vector<SortKey> &keys;
+
+  template <typename T>
+  struct sorted_values_t {
+    // distinct values in ascending order and the index of each one in ranks
+    std::vector<std::pair<T, value_id_t>> values;
+    std::vector<value_id_t> *ranks;
+  };
+
+  template <typename T>
+  void operator()() {
+    typedef std::shared_ptr<BaseDictionary<T>> dictionary_ptr_t;
+
+    dictionary_ptr_t anchor;
+    std::vector<value_id_t> *anchor_ranks = nullptr;
+    std::vector<std::tuple<dictionary_ptr_t, std::vector<value_id_t> *>> dictionaries;
+    for (size_t i = 0; i < tables.size(); ++i) {
+      bool single;
+      if (!hasDictionaries(tables[i], single))
+        continue;
+      auto &key = keys[i];
+      key.ranks.resize(subtables(tables[i]));
+      for (table_id_t table_id = 0; table_id < key.ranks.size(); ++table_id) {
+        auto dictionary = std::dynamic_pointer_cast<BaseDictionary<T>>(tables[i]->dictionaryByTableId(key.field, table_id));
+        dictionaries.push_back(std::make_tuple(dictionary, &key.ranks[table_id]));
+        if (dictionary->isOrdered() && (!anchor || dictionary->size() > anchor->size())) {
+          anchor = dictionary;
+          anchor_ranks = &key.ranks[table_id];
+        }
+      }
+    }
+
+    std::vector<sorted_values_t<T>> others;
+    for (const auto &entry : dictionaries) {
+      const auto &dictionary = std::get<0>(entry);
+      if (dictionary == anchor && std::get<1>(entry) == anchor_ranks)
+        continue;
+      const size_t size = dictionary->size();
+      sorted_values_t<T> sorted {{}, std::get<1>(entry)};
+      sorted.ranks->resize(size);
+      sorted.values.reserve(size);
+      for (value_id_t value_id = 0; value_id < size; ++value_id)
+        sorted.values.push_back(std::make_pair(dictionary->getValueForValueId(value_id), value_id));
+      if (!dictionary->isOrdered())
+        std::sort(sorted.values.begin(), sorted.values.end());
+      others.push_back(std::move(sorted));
+    }
+
+    // rows of tables without dictionaries rank their distinct values,
+    // row_ranks hold the index of the row's value first
+    std::vector<std::vector<value_id_t>> distinct_ranks(tables.size());
+    for (size_t i = 0; i < tables.size(); ++i) {
+      bool single;
+      if (hasDictionaries(tables[i], single))
+        continue;
+      auto &key = keys[i];
+      const size_t rows = tables[i]->size();
+      key.row_ranks.resize(rows);
+      std::unordered_map<T, value_id_t> distinct;
+      sorted_values_t<T> sorted {{}, &distinct_ranks[i]};
+      for (pos_t row = 0; row < rows; ++row) {
+        const T value = tables[i]->getValue<T>(key.field, row);
+        const auto inserted = distinct.insert(std::make_pair(value, static_cast<value_id_t>(distinct.size())));
+        if (inserted.second)
+          sorted.values.push_back(std::make_pair(value, inserted.first->second));
+        key.row_ranks[row] = inserted.first->second;
+      }
+      std::sort(sorted.values.begin(), sorted.values.end());
+      sorted.ranks->resize(sorted.values.size());
+      others.push_back(std::move(sorted));
+    }
+
+    // merges the other lists, each distinct value gets the number of
+    // anchor values below it plus the number of values missing in the
+    // anchor before it as rank
+    const value_id_t anchor_size = anchor ? anchor->size() : 0;
+    typedef std::pair<T, size_t> cursor_t;
+    std::priority_queue<cursor_t, std::vector<cursor_t>, std::greater<cursor_t>> heads;
+    std::vector<size_t> positions(others.size(), 0);
+    for (size_t list = 0; list < others.size(); ++list)
+      if (!others[list].values.empty())
+        heads.push(cursor_t(others[list].values[0].first, list));
+
+    std::vector<value_id_t> missing_at;
+    value_id_t below = 0;
+    while (!heads.empty()) {
+      const T value = heads.top().first;
+      if (anchor)
+        below = lowerBound(*anchor, value, below);
+      const bool in_anchor = below < anchor_size && !(value < anchor->getValueForValueId(below));
+      const value_id_t rank = below + missing_at.size();
+      if (!in_anchor)
+        missing_at.push_back(below);
+
+      while (!heads.empty() && !(value < heads.top().first)) {
+        const size_t list = heads.top().second;
+        heads.pop();
+        auto &sorted = others[list];
+        (*sorted.ranks)[sorted.values[positions[list]].second] = rank;
+        if (++positions[list] < sorted.values.size())
+          heads.push(cursor_t(sorted.values[positions[list]].first, list));
+      }
+    }
+
+    // the anchor's value ids are ranks unless values were inserted below them
+    if (anchor && !missing_at.empty()) {
+      anchor_ranks->resize(anchor_size);
+      size_t missing = 0;
+      for (value_id_t value_id = 0; value_id < anchor_size; ++value_id) {
+        while (missing < missing_at.size() && missing_at[missing] <= value_id)
+          ++missing;
+        (*anchor_ranks)[value_id] = value_id + missing;
+      }
+    }
+
+    for (size_t i = 0; i < tables.size(); ++i)
+      for (auto &row_rank : keys[i].row_ranks)
+        row_rank = distinct_ranks[i][row_rank];
+
+    const size_t total = anchor_size + missing_at.size();
+    for (auto &key : keys)
+      key.max = total > 0 ? total - 1 : 0;
+  }
+
+  // First value id from start on whose value is not less than value
+  template <typename T>
+  static value_id_t lowerBound(BaseDictionary<T> &dictionary, const T &value, value_id_t start) {
+    value_id_t stop = dictionary.size();
+    while (start < stop) {
+      const value_id_t middle = start + (stop - start) / 2;
+      if (dictionary.getValueForValueId(middle) < value) {
+        start = middle + 1;
+      } else {
+        stop = middle;
+      }
+    }
+    return start;
+  }
+};
+
+}
+
+SortKey::SortKey(const field_t field, const bool ascending) :
+  field(field), ascending(ascending), max(0) {
+}
+
+SortKey::SortKey(const storage::c_atable_ptr_t &table, const sort_field_t &sort_field) :
+  field(sort_field.field), ascending(sort_field.ascending), max(0) {
+  bool single;
+  hasDictionaries(table, single);
+  const auto &dictionary = table->dictionaryByTableId(field, 0);
+
+  if (single && dictionary->isOrdered()) {
+    max = dictionary->size() > 0 ? dictionary->size() - 1 : 0;
+  } else {
+    const std::vector<storage::c_atable_ptr_t> tables {table};
+    std::vector<SortKey> keys {SortKey(field, ascending)};
+    RankValues rank {tables, keys};
+    storage::type_switch<hyrise_basic_types> ts;
+    ts(table->typeOfColumn(field), rank);
+    *this = std::move(keys[0]);
+  }
+}
+
+std::vector<SortKey> SortKey::common(const std::vector<storage::c_atable_ptr_t> &tables, const std::vector<field_t> &fields) {
+  std::vector<SortKey> keys;
+  for (const auto &field : fields)
+    keys.push_back(SortKey(field, true));
+
+  // one ordered dictionary shared by all tables is a common domain already
+  bool shared = true;
+  for (size_t i = 0; i < tables.size() && shared; ++i) {
+    bool single;
+    const auto &dictionary = tables[i]->dictionaryByTableId(fields[i], 0);
+    shared = hasDictionaries(tables[i], single) && single && dictionary->isOrdered() &&
+             dictionary == tables[0]->dictionaryByTableId(fields[0], 0);
+  }
+
+  if (shared) {
+    const size_t size = tables[0]->dictionaryByTableId(fields[0], 0)->size();
+    for (auto &key : keys)
+      key.max = size > 0 ? size - 1 : 0;
+  } else {
+    for (size_t i = 1; i < tables.size(); ++i)
+      if (tables[i]->typeOfColumn(fields[i]) != tables[0]->typeOfColumn(fields[0]))
+        throw std::runtime_error("Keys of different types have no common domain");
+    RankValues rank {tables, keys};
+    storage::type_switch<hyrise_basic_types> ts;
+    ts(tables[0]->typeOfColumn(fields[0]), rank);
+  }
+  return keys;
+}
+
+std::vector<std::vector<size_t>> SortKey::segments(const std::vector<SortKey> &keys) {
+  std::vector<std::vector<size_t>> result;
+  size_t segment_bits = 0;
+  for (size_t i = keys.size(); i-- > 0;) {
+    const size_t bits = keys[i].bits();
+    if (result.empty() || segment_bits + bits > 64) {
+      result.push_back({});
+      segment_bits = 0;
+    }
+    result.back().push_back(i);
+    segment_bits += bits;
+  }
+  return result;
+}
+
+void SortKey::pack(const storage::c_atable_ptr_t &table,
+                   const std::vector<SortKey> &keys,
+                   const std::vector<size_t> &segment,
+                   const pos_t *rows,
+                   const size_t start,
+                   const size_t count,
+                   uint64_t *packed) {
+  ValueIdList value_ids(count);
+  std::fill(packed, packed + count, 0);
+
+  size_t shift = 0;
+  for (const auto &index : segment) {
+    const auto &sort_key = keys[index];
+    if (sort_key.needsValueIds()) {
+      if (rows == nullptr) {
+        table->getValueIds(sort_key.field, start, start + count, value_ids.data());
+      } else {
+        table->gatherValueIds(sort_key.field, rows + start, count, value_ids.data());
+      }
+    }
+    for (size_t i = 0; i < count; ++i)
+      packed[i] |= sort_key.key(value_ids[i], rows ? rows[start + i] : start + i) << shift;
+    shift += sort_key.bits();
+  }
+}
+
+std::vector<uint64_t> SortKey::keysOf(const storage::c_atable_ptr_t &table,
+                                     const std::vector<SortKey> &keys,
+                                     const size_t index) {
+  const std::vector<size_t> segment {index};
+  std::vector<uint64_t> result(table->size());
+  executeMorsels(result.size(), [&](size_t, size_t start, size_t stop) {
+      for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+        const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+        pack(table, keys, segment, nullptr, batch, count, result.data() + batch);
+      }
+    });
+  return result;
+}
+
+/*
+ * Sorts rows stably by the lowest bits of keys, where keys[i] is the key
+ * of rows[i]. Each pass sorts by RADIX_BITS bits: every morsel counts its
+ * keys per bucket, the prefix sums over buckets and then morsels give
+ * each morsel its own range per bucket to scatter into.
+ */
+void radixSort(std::vector<uint64_t> &keys, std::vector<pos_t> &rows, const size_t bits) {
+  const size_t size = keys.size();
+  std::vector<uint64_t> sorted_keys(size);
+  std::vector<pos_t> sorted_rows(size);
+  std::vector<std::array<size_t, RADIX_BUCKETS>> offsets(morselCount(size));
+
+  for (size_t shift = 0; shift < bits; shift += RADIX_BITS) {
+    executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+        auto &histogram = offsets[morsel];
+        histogram.fill(0);
+        for (size_t i = start; i < stop; ++i)
+          ++histogram[(keys[i] >> shift) & (RADIX_BUCKETS - 1)];
+      });
+
+    size_t offset = 0;
+    bool single_bucket = false;
+    for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+      const size_t bucket_start = offset;
+      for (auto &histogram : offsets) {
+        const size_t count = histogram[bucket];
+        histogram[bucket] = offset;
+        offset += count;
+      }
+      single_bucket |= offset - bucket_start == size;
+    }
+
+    // all keys share these bits, the order stays the same
+    if (single_bucket)
+      continue;
+
+    executeMorsels(size, [&](size_t morsel, size_t start, size_t stop) {
+        auto &offset = offsets[morsel];
+        for (size_t i = start; i < stop; ++i) {
+          const size_t target = offset[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+          sorted_keys[target] = keys[i];
+          sorted_rows[target] = rows[i];
+        }
+      });
+    keys.swap(sorted_keys);
+    rows.swap(sorted_rows);
+  }
+}
+
+}
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SORTKEY_H_
+#define SRC_LIB_ACCESS_SORTKEY_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace access {
+
+/// Field and direction of a sort key
+struct sort_field_t {
+  field_t field;
+  bool ascending;
+};
+
+/// Translates the value ids of a sort field into integer keys that
+/// compare like the values: value ids of a single ordered dictionary
+/// are the keys already, the value ids of other dictionaries are mapped
+/// to the rank of their value among the values of all dictionaries of
+/// the field. The value ids of the largest ordered dictionary stay the
+/// keys where no other dictionary adds values, the others, e.g. of a
+/// delta, are ranked against it. Tables without dictionaries per table
+/// id rank each row by its value. Descending fields invert their keys.
+class SortKey {
+ public:
+  field_t field;
+  bool ascending;
+
+  // largest key of the field
+  uint64_t max;
+
+  // rank of each value id per table id, empty for value ids as keys
+  // of all or of single table ids
+  std::vector<std::vector<value_id_t>> ranks;
+
+  // rank of each row for tables ranked by value
+  std::vector<value_id_t> row_ranks;
+
+  SortKey(const storage::c_atable_ptr_t &table, const sort_field_t &sort_field);
+
+  /// Ascending keys of fields[i] of tables[i] that compare across all
+  /// tables, e.g. to join them; the fields need to be of the same type.
+  /// Ordered dictionaries are mapped into the common domain by merging
+  /// them, only unordered ones are sorted first.
+  static std::vector<SortKey> common(const std::vector<storage::c_atable_ptr_t> &tables,
+                                     const std::vector<field_t> &fields);
+
+  /// Whether key() needs the value id of the row
+  bool needsValueIds() const {
+    return row_ranks.empty();
+  }
+
+  /// Bits needed to store the keys of the field
+  size_t bits() const {
+    return max == 0 ? 0 : 64 - __builtin_clzll(max);
+  }
+
+  inline uint64_t key(const ValueId &value_id, const pos_t row) const {
+    uint64_t result;
+    if (!row_ranks.empty()) {
+      result = row_ranks[row];
+    } else if (!ranks.empty() && !ranks[value_id.table].empty()) {
+      result = ranks[value_id.table][value_id.valueId];
+    } else {
+      result = value_id.valueId;
+    }
+    return ascending ? result : max - result;
+  }
+
+  /// Groups the keys into segments that fit into 64 bits together,
+  /// starting with the last, least significant key; each segment lists
+  /// its keys from the least significant one
+  static std::vector<std::vector<size_t>> segments(const std::vector<SortKey> &keys);
+
+  /// Packs the keys of segment for count rows into packed, these are
+  /// rows[start] to rows[start + count - 1] or, without rows, the rows
+  /// [start, start + count) of table
+  static void pack(const storage::c_atable_ptr_t &table,
+                   const std::vector<SortKey> &keys,
+                   const std::vector<size_t> &segment,
+                   const pos_t *rows,
+                   const size_t start,
+                   const size_t count,
+                   uint64_t *packed);
+
+  /// Keys of keys[index] for all rows of table, computed in parallel
+  static std::vector<uint64_t> keysOf(const storage::c_atable_ptr_t &table,
+                                      const std::vector<SortKey> &keys,
+                                      const size_t index);
+
+ private:
+  SortKey(const field_t field, const bool ascending);
+};
+
+/// Sorts rows stably by the lowest bits of keys in parallel, keys[i] is
+/// the key of rows[i]
+void radixSort(std::vector<uint64_t> &keys, std::vector<pos_t> &rows, const size_t bits);
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_SORTKEY_H_
@@ -4,71 +4,17 @@
 #include <algorithm>
 
 #include "access/QueryParser.h"
+#include "access/SortKey.h"
 
 #include "storage/AbstractTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/PointerCalculatorFactory.h"
-#include "storage/Table.h"
+
+#include "taskscheduler/MorselTask.h"
 
 namespace hyrise {
 namespace access {
 
-template <typename T>
-struct ExtractValue {
-  static inline T extractValue(const storage::c_atable_ptr_t &table,
-                               const size_t &col,
-                               const size_t &row) {
-    return table->getValue<T>(col, row);
-  }
-};
-
-template <typename T>
-struct ExtractValueId {
-  static inline ValueId extractValue(const storage::c_atable_ptr_t &table,
-                                     const size_t &col,
-                                     const size_t &row) {
-    return table->getValueId(col, row);
-  }
-};
-
-template <typename T, template<typename T> class ExtractFunctor>
-class ColumnSorter {
-  typedef struct pair {
-      T value;
-      size_t row;
-  } pair_t;
-
-  const storage::c_atable_ptr_t &_t;
-  field_t _f;
-
-public:
-  ColumnSorter(const storage::c_atable_ptr_t &t,
-               const field_t f):
-               _t(t),
-               _f(f) {
-  }
-
-  std::vector<pos_t>* sort() const {
-    std::vector<pair_t> result;
-
-    for (size_t row = 0; row < _t->size(); ++row) {
-      result.push_back({ExtractFunctor<T>::extractValue(_t, _f, row), row});
-    }
-
-    std::stable_sort(result.begin(),
-                     result.end(),
-                     [](const pair_t& left, const pair_t& right)
-                     { return left.value < right.value; });
-
-    auto r = new std::vector<pos_t>;
-    r->reserve(result.size());
-    for (const pair_t& p: result)
-      r->push_back(p.row);
-
-    return r;
-  }
-};
-
 namespace {
   auto _ = QueryParser::registerPlanOperation<SortScan>("SortScan");
 }
@@ -78,31 +24,42 @@ SortScan::~SortScan() {
 
 void SortScan::executePlanOperation() {
   const auto& table = input.getTable(0);
-  // Sorted Position List
-  std::vector<pos_t> *sorted_pos;
-
-  // When table is not only a table but also using an ordered dictionary on sort field,
-  // we can just sort by value_id
-  // TODO: fix Table<> template
-  auto base_table = std::dynamic_pointer_cast<const Table<>>(table);
-  if ((table->dictionaryAt(_sort_field)->isOrdered()) && (base_table)) {
-    sorted_pos = ColumnSorter<ValueId, ExtractValueId>(table, _sort_field).sort();
-  } else {
-    switch (table->metadataAt(_sort_field)->getType()) {
-      case IntegerType:
-        sorted_pos = ColumnSorter<hyrise_int_t, ExtractValue>(table, _sort_field).sort();
-        break;
-      case FloatType:
-        sorted_pos = ColumnSorter<hyrise_float_t, ExtractValue>(table, _sort_field).sort();
-        break;
-      case StringType:
-        sorted_pos = ColumnSorter<hyrise_string_t, ExtractValue>(table, _sort_field).sort();
-        break;
-      default:
-        throw std::runtime_error("Datatype not supported");
-    }
+  const size_t size = table->size();
+
+  std::vector<SortKey> sort_keys;
+  for (const auto &sort_field : _sort_fields)
+    sort_keys.emplace_back(table, sort_field);
+
+  // Keys of several fields are packed into one 64 bit key as long as they
+  // fit, the last fields are the least significant. The radix sort is
+  // stable, so sorting by the less significant keys first sorts by all.
+  const auto segments = SortKey::segments(sort_keys);
+
+  std::vector<pos_t> rows(size);
+  for (pos_t row = 0; row < size; ++row)
+    rows[row] = row;
+
+  std::vector<uint64_t> keys(size);
+  for (size_t segment = 0; segment < segments.size(); ++segment) {
+    size_t bits = 0;
+    for (const auto &index : segments[segment])
+      bits += sort_keys[index].bits();
+    if (bits == 0)
+      continue;
+
+    executeMorsels(size, [&](size_t, size_t start, size_t stop) {
+        for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+          const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+          SortKey::pack(table, sort_keys, segments[segment], segment == 0 ? nullptr : rows.data(), batch, count, keys.data() + batch);
+        }
+      });
+
+    radixSort(keys, rows, bits);
   }
 
+  std::vector<pos_t> *sorted_pos = new std::vector<pos_t>;
+  sorted_pos->swap(rows);
+
   storage::atable_ptr_t result;
 
   if (producesPositions) {
@@ -120,15 +77,24 @@ void SortScan::executePlanOperation() {
 
 std::shared_ptr<_PlanOperation> SortScan::parse(Json::Value &data) {
   std::shared_ptr<SortScan> s = std::make_shared<SortScan>();
-  s->setSortField(data["fields"][0u].asUInt());
+  for (unsigned i = 0; i < data["fields"].size(); ++i) {
+    const bool ascending = !data.isMember("order") || data["order"][i].asString() != "DESC";
+    s->addSortField(data["fields"][i].asUInt(), ascending);
+  }
   return s;
 }
 
 const std::string SortScan::vname() {
   return "SortScan";
 }
+
 void SortScan::setSortField(const unsigned s) {
-  _sort_field = s;
+  _sort_fields.clear();
+  addSortField(s);
+}
+
+void SortScan::addSortField(const unsigned field, const bool ascending) {
+  _sort_fields.push_back({field, ascending});
 }
 
 }
@@ -2,11 +2,22 @@
 #ifndef SRC_LIB_ACCESS_SORTSCAN_H_
 #define SRC_LIB_ACCESS_SORTSCAN_H_
 
+#include <vector>
+
 #include <access/PlanOperation.h>
+#include "access/SortKey.h"
 
 namespace hyrise {
 namespace access {
 
+/// Sorts the input stably by one or more fields, each ascending or
+/// descending. The rows are radix sorted in parallel on keys packed
+/// from the value ids of the fields; value ids of a single ordered
+/// dictionary are used as they are, other dictionaries are ranked by
+/// their values first.
+///
+/// Parameters: "fields" lists the sort fields, the first one takes
+/// precedence; the optional "order" lists "ASC" or "DESC" per field.
 class SortScan : public _PlanOperation {
 public:
   virtual ~SortScan();
@@ -14,10 +25,15 @@ public:
   void executePlanOperation();
   static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
   const std::string vname();
+
+  /// Sorts ascending by field s only
   void setSortField(const unsigned s);
 
+  /// Appends field to the sort fields
+  void addSortField(const unsigned field, const bool ascending = true);
+
 private:
-  unsigned _sort_field;
+  std::vector<sort_field_t> _sort_fields;
 };
 
 }
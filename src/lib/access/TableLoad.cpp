@@ -20,7 +20,8 @@ namespace {
 TableLoad::TableLoad(): _hasDelimiter(false),
                         _binary(false),
                         _unsafe(false),
-                        _raw(false) {
+                        _raw(false),
+                        _chunk_size(0) {
 }
 
 TableLoad::~TableLoad() {
@@ -40,12 +41,21 @@ void TableLoad::executePlanOperation() {
     } else if (!_header_string.empty()) {
       // Load based on header string
       Loader::params p = Loader::shortcuts::loadWithStringHeaderParams(_file_name, _header_string);
+      p.setChunkSize(_chunk_size);
       sm->loadTable(_table_name, p);
 
-    } else if (_header_file_name.empty()) {
+    } else if (_header_file_name.empty() && _chunk_size == 0) {
       // Load only with single file
       sm->loadTableFile(_table_name, _file_name);
 
+    } else if (_header_file_name.empty()) {
+      // Load a single file into a chunked table
+      Loader::params p;
+      p.setHeader(CSVHeader(_file_name));
+      p.setInput(CSVInput(_file_name));
+      p.setChunkSize(_chunk_size);
+      sm->loadTable(_table_name, p);
+
     } else if ((!_table_name.empty()) && (!_file_name.empty()) && (!_header_file_name.empty())) {
       // Load with dedicated header file
       Loader::params p;
@@ -55,6 +65,7 @@ void TableLoad::executePlanOperation() {
       if (_hasDelimiter)
         params.setCSVParams(csv::params().setDelimiter(_delimiter.at(0)));
       p.setInput(CSVInput(_file_name, params));
+      p.setChunkSize(_chunk_size);
       sm->loadTable(_table_name, p);
     }
 
@@ -63,7 +74,7 @@ void TableLoad::executePlanOperation() {
   } else {
     sm->getTable(_table_name);
   }
-  auto _table = sm->getTable(_table_name);
+  auto _table = sm->getTableSnapshot(_table_name);
   LOG4CXX_DEBUG(logger, "Loaded Table Size" << _table->size());
   addResult(_table);
 }
@@ -79,6 +90,9 @@ std::shared_ptr<_PlanOperation> TableLoad::parse(Json::Value &data) {
   if (data.isMember("delimiter")) {
     s->setDelimiter(data["delimiter"].asString());
   }
+  if (data.isMember("chunk_size")) {
+    s->setChunkSize(data["chunk_size"].asUInt());
+  }
   return s;
 }
 
@@ -119,5 +133,9 @@ void TableLoad::setDelimiter(const std::string &d) {
   _hasDelimiter = true;
 }
 
+void TableLoad::setChunkSize(const size_t chunkSize) {
+  _chunk_size = chunkSize;
+}
+
 }
 }
@@ -29,6 +29,7 @@ public:
   void setUnsafe(const bool unsafe);
   void setRaw(const bool raw);
   void setDelimiter(const std::string &d);
+  void setChunkSize(const size_t chunkSize);
 
 private:
   std::string _table_name;
@@ -40,6 +41,7 @@ private:
   bool _binary;
   bool _unsafe;
   bool _raw;
+  size_t _chunk_size;
 };
 
 }
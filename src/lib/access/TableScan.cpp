@@ -4,7 +4,10 @@
 #include "access/ExampleExpression.h"
 #include "access/pred_SimpleExpression.h"
 #include "access/ExpressionRegistration.h"
+#include "access/JoinFilterExpression.h"
+#include "storage/AbstractHashTable.h"
 #include "storage/AbstractTable.h"
+#include "storage/ChunkedTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/PointerCalculatorFactory.h"
 #include "helper/types.h"
@@ -18,15 +21,33 @@ TableScan::TableScan(std::unique_ptr<AbstractExpression> expr) : _expr(std::move
 void TableScan::setupPlanOperation() {
   const auto& table = getInputTable();
   _expr->walk({table});
+  if (!_join_filter_fields.empty() && input.numberOfHashTables() > 0)
+    _join_filter = input.getHashTable(0)->getJoinFilter();
 }
 
 void TableScan::executePlanOperation() {
-  pos_list_t* positions = _expr->match(0, getInputTable()->size());
-  addResult(PointerCalculatorFactory::createPointerCalculatorNonRef(getInputTable(), nullptr, positions));
+  const size_t morselSize = ChunkedTable::morselSizeFor(getInputTable());
+  if (_join_filter) {
+    JoinFilterExpression filtered(_expr.get(), *_join_filter, getInputTable(), _join_filter_fields);
+    addResult(matchMorselsToPointerCalculator(filtered, getInputTable(), morselSize));
+  } else {
+    addResult(matchMorselsToPointerCalculator(*_expr, getInputTable(), morselSize));
+  }
 }
 
 std::shared_ptr<_PlanOperation> TableScan::parse(Json::Value& data) {
-  return std::make_shared<TableScan>(Expressions::parse(data["expression"].asString(), data));
+  auto scan = std::make_shared<TableScan>(Expressions::parse(data["expression"].asString(), data));
+  if (data.isMember("join_filter_fields")) {
+    field_list_t fields;
+    for (unsigned i = 0; i < data["join_filter_fields"].size(); ++i)
+      fields.push_back(data["join_filter_fields"][i].asUInt());
+    scan->setJoinFilterFields(fields);
+  }
+  return scan;
+}
+
+void TableScan::setJoinFilterFields(const field_list_t &fields) {
+  _join_filter_fields = fields;
 }
 
 }}
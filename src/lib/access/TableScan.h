@@ -5,6 +5,8 @@
 #include <memory>
 #include "access/PlanOperation.h"
 
+class JoinFilter;
+
 namespace hyrise { namespace access {
 
 class AbstractExpression;
@@ -18,11 +20,15 @@ class TableScan : public _PlanOperation {
   /// Parse TableScan from 
   static std::shared_ptr<_PlanOperation> parse(Json::Value& data);
   const std::string vname() { return "me"; }
+  /// Join fields of the scanned table, see SimpleTableScan
+  void setJoinFilterFields(const field_list_t &fields);
  protected:
   void setupPlanOperation();
   void executePlanOperation();
  private:
   std::unique_ptr<AbstractExpression> _expr;
+  field_list_t _join_filter_fields;
+  std::shared_ptr<const JoinFilter> _join_filter;
 };
 
 }}
@@ -0,0 +1,124 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/TopK.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "access/QueryParser.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/PointerCalculatorFactory.h"
+
+#include "taskscheduler/MorselTask.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+auto _ = QueryParser::registerPlanOperation<TopK>("TopK");
+
+// A candidate row with its packed keys, the most significant first
+struct candidate_t {
+  std::vector<uint64_t> keys;
+  pos_t row;
+};
+
+// Compares the keys of two rows, the row breaks ties to keep the
+// input order of rows with equal keys
+bool lessThan(const uint64_t *keys, const pos_t row, const candidate_t &other) {
+  for (size_t i = 0; i < other.keys.size(); ++i) {
+    if (keys[i] != other.keys[i])
+      return keys[i] < other.keys[i];
+  }
+  return row < other.row;
+}
+
+bool operator<(const candidate_t &left, const candidate_t &right) {
+  return lessThan(left.keys.data(), left.row, right);
+}
+
+}
+
+TopK::~TopK() {
+}
+
+void TopK::executePlanOperation() {
+  const auto& table = input.getTable(0);
+  const size_t size = table->size();
+
+  if (_limit == 0)
+    throw std::runtime_error("TopK needs a limit");
+  if (_sort_fields.empty())
+    throw std::runtime_error("TopK needs at least one sort field");
+  const size_t k = std::min<size_t>(_limit, size);
+
+  std::vector<SortKey> sort_keys;
+  for (const auto &sort_field : _sort_fields)
+    sort_keys.emplace_back(table, sort_field);
+  const auto segments = SortKey::segments(sort_keys);
+
+  // Max heap per participant, the worst of its best k rows on top
+  std::vector<std::vector<candidate_t>> heaps(morselParticipants(size));
+  executeMorselsPerParticipant(size, [&](size_t participant, size_t, size_t start, size_t stop) {
+      auto &heap = heaps[participant];
+      std::vector<uint64_t> packed(segments.size() * VALUE_ID_BATCH_SIZE);
+      std::vector<uint64_t> keys(segments.size());
+
+      for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+        const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+        for (size_t segment = 0; segment < segments.size(); ++segment)
+          SortKey::pack(table, sort_keys, segments[segment], nullptr, batch, count, packed.data() + segment * VALUE_ID_BATCH_SIZE);
+
+        for (size_t i = 0; i < count; ++i) {
+          // segments are listed from the least significant one
+          for (size_t segment = 0; segment < segments.size(); ++segment)
+            keys[segments.size() - 1 - segment] = packed[segment * VALUE_ID_BATCH_SIZE + i];
+
+          const pos_t row = batch + i;
+          if (heap.size() < k) {
+            heap.push_back({keys, row});
+            std::push_heap(heap.begin(), heap.end());
+          } else if (lessThan(keys.data(), row, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back().keys = keys;
+            heap.back().row = row;
+            std::push_heap(heap.begin(), heap.end());
+          }
+        }
+      }
+    });
+
+  std::vector<candidate_t> candidates;
+  for (auto &heap : heaps)
+    std::move(heap.begin(), heap.end(), std::back_inserter(candidates));
+  std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+
+  auto positions = new pos_list_t;
+  positions->reserve(k);
+  for (size_t i = 0; i < k; ++i)
+    positions->push_back(candidates[i].row);
+  addResult(PointerCalculatorFactory::createPointerCalculatorNonRef(table, nullptr, positions));
+}
+
+std::shared_ptr<_PlanOperation> TopK::parse(Json::Value &data) {
+  std::shared_ptr<TopK> s = std::make_shared<TopK>();
+  for (unsigned i = 0; i < data["fields"].size(); ++i) {
+    const bool ascending = !data.isMember("order") || data["order"][i].asString() != "DESC";
+    s->addSortField(data["fields"][i].asUInt(), ascending);
+  }
+  s->setLimit(data["limit"].asUInt64());
+  return s;
+}
+
+const std::string TopK::vname() {
+  return "TopK";
+}
+
+void TopK::addSortField(const unsigned field, const bool ascending) {
+  _sort_fields.push_back({field, ascending});
+}
+
+}
+}
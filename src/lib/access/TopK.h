@@ -0,0 +1,42 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_TOPK_H_
+#define SRC_LIB_ACCESS_TOPK_H_
+
+#include <vector>
+
+#include "access/PlanOperation.h"
+#include "access/SortKey.h"
+
+namespace hyrise {
+namespace access {
+
+/// Returns the first rows of the input in the order of one or more
+/// fields, like a SortScan whose result is cut after "limit" rows, but
+/// without sorting the whole input: every worker keeps a bounded heap of
+/// its best rows on the keys SortScan sorts by, the heaps are merged at
+/// the end. Rows with equal keys keep their input order.
+///
+/// Parameters: "fields" lists the sort fields, the first one takes
+/// precedence; the optional "order" lists "ASC" or "DESC" per field;
+/// "limit" is the number of rows to return.
+/// Query graph output:
+/// - positions of the first rows, in order
+class TopK : public _PlanOperation {
+public:
+  virtual ~TopK();
+
+  void executePlanOperation();
+  static std::shared_ptr<_PlanOperation> parse(Json::Value &data);
+  const std::string vname();
+
+  /// Appends field to the sort fields
+  void addSortField(const unsigned field, const bool ascending = true);
+
+private:
+  std::vector<sort_field_t> _sort_fields;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_TOPK_H_
@@ -0,0 +1,30 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/UnitePositions.h"
+
+#include "storage/PointerCalculator.h"
+
+namespace hyrise {
+namespace access {
+
+namespace { auto _ = QueryParser::registerPlanOperation<UnitePositions>("UnitePositions"); }
+
+std::shared_ptr<_PlanOperation> UnitePositions::parse(Json::Value&) {
+  return std::make_shared<UnitePositions>();
+}
+
+void UnitePositions::executePlanOperation() {
+  const auto& pc1 = std::dynamic_pointer_cast<const PointerCalculator>(getInputTable(0));
+  const auto& pc2 = std::dynamic_pointer_cast<const PointerCalculator>(getInputTable(1));
+
+  if (pc1 == nullptr) { throw std::runtime_error("Passed input 0 is not a PC!"); }
+  if (pc2 == nullptr) { throw std::runtime_error("Passed input 1 is not a PC!"); }
+
+  addResult(pc1->unite(pc2));
+}
+
+const std::string UnitePositions::vname() {
+  return "UnitePositions";
+}
+
+}
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_UNITEPOSITIONS_H_
+#define SRC_LIB_ACCESS_UNITEPOSITIONS_H_
+
+#include "access/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Unites positions from two incoming pointercalculators on the same
+/// table, each row is contained once; unlike UnionScan the rows of both
+/// inputs are combined as sets, e.g. for OR predicates
+class UnitePositions: public _PlanOperation {
+ public:
+
+  /// Allowed parameters
+  /// Parameters: none
+  /// Query graph inputs:
+  /// 1. positions on a table
+  /// 2. positions on the same table
+  /// Query graph output:
+  /// - positions contained in any of both inputs
+  static std::shared_ptr<_PlanOperation> parse(Json::Value& data);
+  void executePlanOperation();
+  virtual const std::string vname();
+};
+
+}
+}
+
+#endif
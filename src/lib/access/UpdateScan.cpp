@@ -51,7 +51,11 @@ void UpdateScan::executePlanOperation() {
     throw std::runtime_error("Updates not supported for non delta structures");
   }
 
-  size_t delta_row = s->getDeltaTable()->size();
+  // rows are read from the input, updated rows go to the live delta
+  const auto live = s->liveStore();
+  auto deltaLock = live->lockDelta();
+  const auto &delta = live->getDeltaTable();
+  size_t delta_row = delta->size();
 
   for (size_t row = 0; row < input_size; ++row) {
     // Execute the predicate on the list
@@ -59,14 +63,17 @@ void UpdateScan::executePlanOperation() {
       if (_func != nullptr) {
         _func->updateRow(row);
       } else {
+        // the delta grows before the updated row is written to it
+        delta->resize(delta_row + 1);
+        delta->copyRowFrom(s, row, delta_row, true);
         for (it = mapping.begin(); it != mapping.end(); it++) {
           int src = (*it).first;
           int tgt = (*it).second;
 
           // Update the delta
-          s->getDeltaTable()->copyRowFrom(s, row, delta_row, true);
-          s->getDeltaTable()->copyValueFrom(_data, src, 0, tgt, delta_row++);
+          delta->copyValueFrom(_data, src, 0, tgt, delta_row);
         }
+        ++delta_row;
       }
     }
   }
@@ -47,7 +47,7 @@ struct MergeDictFunctor {
 
   template<typename R>
   result operator()() {
-    auto dict = std::dynamic_pointer_cast<OrderPreservingDictionary<R>>(_main->dictionaryAt(_column));
+    auto dict = std::dynamic_pointer_cast<BaseDictionary<R>>(_main->dictionaryAt(_column));
     assert(dict && "Dict shouldn't be NULL, cast failed");
     std::set<R> values;
 
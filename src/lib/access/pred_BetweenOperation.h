@@ -15,6 +15,7 @@ class BetweenExpression : public SimpleFieldExpression {
   std::shared_ptr<BaseDictionary<T>> valueIdMap;
   bool lower_value_exists;
   bool upper_value_exists;
+  bool by_value;
  public:
 
   BetweenExpression(size_t i, field_t f, T _lower_value, T _upper_value):
@@ -33,6 +34,11 @@ class BetweenExpression : public SimpleFieldExpression {
     SimpleFieldExpression::walk(l);
 
     valueIdMap = std::dynamic_pointer_cast<BaseDictionary<T>>(table->dictionaryAt(field));
+    // value ids of an order indifferent dictionary are compared by value
+    by_value = !valueIdMap->isOrdered();
+    if (by_value) {
+      return;
+    }
 
     lower_bound.table = 0;
     lower_bound.valueId = valueIdMap->getValueIdForValue(lower_value);
@@ -46,9 +52,42 @@ class BetweenExpression : public SimpleFieldExpression {
   virtual ~BetweenExpression() {}
 
   inline virtual bool operator()(size_t row) {
-    ValueId valueId = table->getValueId(field, row);
+    return matchesValueId(table->getValueId(field, row), row);
+  }
+
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    ValueIdList value_ids;
+    valueIdsForBlock(start, stop, value_ids);
+    matches.resize(value_ids.size());
+    for (size_t i = 0; i < value_ids.size(); ++i) {
+      matches[i] = matchesValueId(value_ids[i], start + i);
+    }
+  }
+
+  virtual bool valueIdRange(const AbstractTable::SharedDictionaryPtr &dictionary,
+                            value_id_t &low, value_id_t &high, bool &empty) const {
+    const auto values = std::dynamic_pointer_cast<BaseDictionary<T>>(dictionary);
+    if (!values || !values->isOrdered()) {
+      return false;
+    }
+
+    // First value id not smaller than the lower value, one past the last
+    // value id not greater than the upper value
+    low = values->getValueIdForValue(lower_value);
+    const value_id_t high_end = values->getValueIdForValueGreater(upper_value);
+    high = high_end - 1;
+    empty = high_end <= low;
+    return true;
+  }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    return matchValueIdRange(start, stop);
+  }
+
+ private:
 
-    if ((valueId.table == lower_bound.table) && (valueId.table == upper_bound.table)) {
+  inline bool matchesValueId(const ValueId &valueId, const size_t row) const {
+    if (!by_value && (valueId.table == lower_bound.table) && (valueId.table == upper_bound.table)) {
       if ((valueId.valueId <= upper_bound.valueId) && (valueId.valueId >= lower_bound.valueId)) {
         return true;
       }
@@ -61,6 +61,51 @@ class CompoundExpression : public SimpleExpression {
     }
   }
 
+  /*
+   * Evaluates the left child for the whole block first and only asks
+   * the right child if its result can still change the outcome of the
+   * block.
+   */
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    lhs->matchBlock(start, stop, matches);
+
+    switch (type) {
+      case AND: {
+        if (std::find(matches.begin(), matches.end(), 1) == matches.end()) {
+          return;
+        }
+        match_block_t rhs_matches;
+        rhs->matchBlock(start, stop, rhs_matches);
+        for (size_t i = 0; i < matches.size(); ++i) {
+          matches[i] &= rhs_matches[i];
+        }
+        break;
+      }
+
+      case OR: {
+        if (std::find(matches.begin(), matches.end(), 0) == matches.end()) {
+          return;
+        }
+        match_block_t rhs_matches;
+        rhs->matchBlock(start, stop, rhs_matches);
+        for (size_t i = 0; i < matches.size(); ++i) {
+          matches[i] |= rhs_matches[i];
+        }
+        break;
+      }
+
+      case NOT:
+        for (size_t i = 0; i < matches.size(); ++i) {
+          matches[i] = !matches[i];
+        }
+        break;
+
+      default:
+        throw std::runtime_error("Unknown Expression Type");
+        break;
+    }
+  }
+
   inline void add(SimpleExpression *e) {
     if (!lhs) lhs = e;
     else if (!rhs) rhs = e;
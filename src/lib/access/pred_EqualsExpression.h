@@ -48,6 +48,37 @@ class EqualsExpression : public SimpleFieldExpression {
   inline virtual bool operator()(size_t row) {
     return value_exists && table->getValueId(field, row) == lower_bound;
   }
+
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    matches.assign(stop - start, 0);
+    if (!value_exists) {
+      return;
+    }
+
+    ValueIdList value_ids;
+    valueIdsForBlock(start, stop, value_ids);
+    for (size_t i = 0; i < value_ids.size(); ++i) {
+      matches[i] = (value_ids[i].valueId == lower_bound.valueId) && (value_ids[i].table == lower_bound.table);
+    }
+  }
+
+  virtual bool valueIdRange(const AbstractTable::SharedDictionaryPtr &dictionary,
+                            value_id_t &low, value_id_t &high, bool &empty) const {
+    const auto values = std::dynamic_pointer_cast<BaseDictionary<T>>(dictionary);
+    if (!values) {
+      return false;
+    }
+
+    empty = !values->valueExists(value);
+    if (!empty) {
+      low = high = values->getValueIdForValue(value);
+    }
+    return true;
+  }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    return matchValueIdRange(start, stop);
+  }
 };
 
 /**
@@ -11,6 +11,7 @@ class GreaterThanExpression : public SimpleFieldExpression {
   T value;
   std::shared_ptr<BaseDictionary<T>> valueIdMap;
   bool value_exists;
+  bool by_value;
 
  public:
 
@@ -31,6 +32,11 @@ class GreaterThanExpression : public SimpleFieldExpression {
     SimpleFieldExpression::walk(l);
 
     valueIdMap = std::dynamic_pointer_cast<BaseDictionary<T>>(table->dictionaryAt(field));
+    // value ids of an order indifferent dictionary are compared by value
+    by_value = !valueIdMap->isOrdered();
+    if (by_value) {
+      return;
+    }
     lower_bound.table = 0;
     lower_bound.valueId = valueIdMap->getValueIdForValue(value);
     value_exists = valueIdMap->isValueIdValid(lower_bound.valueId) &&
@@ -38,9 +44,39 @@ class GreaterThanExpression : public SimpleFieldExpression {
   }
 
   inline virtual bool operator()(size_t row) {
-    ValueId valueId = table->getValueId(field, row);
+    return matchesValueId(table->getValueId(field, row), row);
+  }
+
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    ValueIdList value_ids;
+    valueIdsForBlock(start, stop, value_ids);
+    matches.resize(value_ids.size());
+    for (size_t i = 0; i < value_ids.size(); ++i) {
+      matches[i] = matchesValueId(value_ids[i], start + i);
+    }
+  }
+
+  virtual bool valueIdRange(const AbstractTable::SharedDictionaryPtr &dictionary,
+                            value_id_t &low, value_id_t &high, bool &empty) const {
+    const auto values = std::dynamic_pointer_cast<BaseDictionary<T>>(dictionary);
+    if (!values || !values->isOrdered()) {
+      return false;
+    }
+
+    low = values->getValueIdForValueGreater(value);
+    high = std::numeric_limits<value_id_t>::max();
+    empty = low >= values->size();
+    return true;
+  }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    return matchValueIdRange(start, stop);
+  }
+
+ private:
 
-    if (valueId.table == lower_bound.table) {
+  inline bool matchesValueId(const ValueId &valueId, const size_t row) const {
+    if (!by_value && valueId.table == lower_bound.table) {
       if (valueId.valueId > lower_bound.valueId) {
         return true;
       }
@@ -11,6 +11,7 @@ class LessThanExpression : public SimpleFieldExpression {
   T value;
   std::shared_ptr<BaseDictionary<T>> valueIdMap;
   bool value_exists;
+  bool by_value;
 
  public:
 
@@ -30,6 +31,12 @@ class LessThanExpression : public SimpleFieldExpression {
 
     SimpleFieldExpression::walk(l);
     valueIdMap = std::dynamic_pointer_cast<BaseDictionary<T>>(table->dictionaryAt(field));
+    // value ids of an order indifferent dictionary, e.g. the shared one
+    // of a chunked table, say nothing about the order of their values
+    by_value = !valueIdMap->isOrdered();
+    if (by_value) {
+      return;
+    }
     lower_bound.table = 0;
     lower_bound.valueId = valueIdMap->getValueIdForValue(value);
     value_exists = valueIdMap->isValueIdValid(lower_bound.valueId) && value == valueIdMap->getValueForValueId(lower_bound.valueId);
@@ -38,11 +45,47 @@ class LessThanExpression : public SimpleFieldExpression {
   virtual ~LessThanExpression() { }
 
   inline virtual bool operator()(size_t row) {
-    ValueId valueId = table->getValueId(field, row);
-    if (valueId.valueId < lower_bound.valueId) {
-      return true;
-    } else
+    return matchesValueId(table->getValueId(field, row), row);
+  }
+
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    ValueIdList value_ids;
+    valueIdsForBlock(start, stop, value_ids);
+    matches.resize(value_ids.size());
+    for (size_t i = 0; i < value_ids.size(); ++i) {
+      matches[i] = matchesValueId(value_ids[i], start + i);
+    }
+  }
+
+  virtual bool valueIdRange(const AbstractTable::SharedDictionaryPtr &dictionary,
+                            value_id_t &low, value_id_t &high, bool &empty) const {
+    const auto values = std::dynamic_pointer_cast<BaseDictionary<T>>(dictionary);
+    if (!values || !values->isOrdered()) {
       return false;
+    }
+
+    // first value id not smaller than the value
+    const value_id_t end = values->getValueIdForValue(value);
+    low = 0;
+    high = end - 1;
+    empty = end == 0;
+    return true;
+  }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    return matchValueIdRange(start, stop);
+  }
+
+ private:
+
+  // Value ids of other partitions, e.g. the delta, belong to another
+  // dictionary and are compared by value
+  inline bool matchesValueId(const ValueId &valueId, const size_t row) const {
+    if (!by_value && valueId.table == lower_bound.table) {
+      return valueId.valueId < lower_bound.valueId;
+    }
+
+    return table->getValue<T>(field, row) < value;
   }
 };
 
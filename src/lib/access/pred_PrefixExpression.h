@@ -0,0 +1,82 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_PRED_PREFIXEXPRESSION_H_
+#define SRC_LIB_ACCESS_PRED_PREFIXEXPRESSION_H_
+
+#include <stdexcept>
+
+#include "pred_common.h"
+
+#include "storage/FrontCodedDictionary.h"
+
+/*
+ * Matches the rows of a string column whose value starts with prefix.
+ * On front coded dictionaries the prefix is a value id range and the
+ * scan compares value ids only, other partitions compare the values.
+ */
+class PrefixExpression : public SimpleFieldExpression {
+ private:
+  hyrise_string_t prefix;
+
+  inline bool matchesValue(const hyrise_string_t &value) const {
+    return value.compare(0, prefix.size(), prefix) == 0;
+  }
+
+ public:
+
+  PrefixExpression(size_t i, field_t f, hyrise_string_t p):
+      SimpleFieldExpression(i, f), prefix(p)
+  {}
+
+  PrefixExpression(size_t i, field_name_t f, hyrise_string_t p):
+      SimpleFieldExpression(i, f), prefix(p)
+  {}
+
+  PrefixExpression(hyrise::storage::c_atable_ptr_t _table, field_t _field, hyrise_string_t _prefix) :
+      SimpleFieldExpression(_table, _field), prefix(_prefix)
+  {}
+
+  virtual ~PrefixExpression() { }
+
+  inline virtual bool operator()(size_t row) {
+    return matchesValue(table->getValue<hyrise_string_t>(field, row));
+  }
+
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    matches.resize(stop - start);
+    for (size_t row = start; row < stop; ++row) {
+      matches[row - start] = matchesValue(table->getValue<hyrise_string_t>(field, row));
+    }
+  }
+
+  virtual bool valueIdRange(const AbstractTable::SharedDictionaryPtr &dictionary,
+                            value_id_t &low, value_id_t &high, bool &empty) const {
+    const auto values = std::dynamic_pointer_cast<FrontCodedDictionary>(dictionary);
+    if (!values) {
+      return false;
+    }
+
+    value_id_t end;
+    values->getValueIdRangeForPrefix(prefix, low, end);
+    empty = low >= end;
+    high = end - 1;
+    return true;
+  }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    return matchValueIdRange(start, stop);
+  }
+};
+
+// Prefix predicates only exist for strings, see expression_factory
+template <typename T>
+SimpleFieldExpression *buildPrefixExpression(size_t input, field_t field, const field_name_t &field_name, const T &prefix) {
+  throw std::runtime_error("Prefix predicates need a string value");
+}
+
+inline SimpleFieldExpression *buildPrefixExpression(size_t input, field_t field, const field_name_t &field_name, const hyrise_string_t &prefix) {
+  if (field_name.size() > 0)
+    return new PrefixExpression(input, field_name, prefix);
+  return new PrefixExpression(input, field, prefix);
+}
+
+#endif  // SRC_LIB_ACCESS_PRED_PREFIXEXPRESSION_H_
@@ -2,24 +2,52 @@
 #ifndef SRC_LIB_ACCESS_PRED_SIMPLEEXPRESSION_H_
 #define SRC_LIB_ACCESS_PRED_SIMPLEEXPRESSION_H_
 
+#include <algorithm>
+#include <vector>
+
 #include "storage/storage_types.h"
 #include "helper/types.h"
 #include "access/AbstractExpression.h"
 
+// Number of rows a predicate evaluates at once in block mode
+#define PREDICATE_BLOCK_SIZE 1024
+
+// Match flags of one evaluated block, entry i belongs to row start + i
+typedef std::vector<unsigned char> match_block_t;
+
 class SimpleExpression : public hyrise::access::AbstractExpression {
  public:
   virtual void walk(const std::vector<hyrise::storage::c_atable_ptr_t> &l) = 0;
 
   virtual pos_list_t* match(const size_t start, const size_t stop) {
     auto pl = new pos_list_t;
-    for(size_t row=0; row < stop; ++row) {
-      if (operator()(row)) {
-        pl->push_back(row);
+    match_block_t matches;
+    for (size_t block_start = start; block_start < stop; block_start += PREDICATE_BLOCK_SIZE) {
+      const size_t block_stop = std::min(block_start + PREDICATE_BLOCK_SIZE, stop);
+      matchBlock(block_start, block_stop, matches);
+      for (size_t row = block_start; row < block_stop; ++row) {
+        if (matches[row - block_start]) {
+          pl->push_back(row);
+        }
       }
     }
     return pl;
   }
 
+  /*
+   * Evaluates the predicate for all rows in [start, stop) and stores
+   * one match flag per row in matches. The default falls back to
+   * operator(), subclasses override it to evaluate the whole block
+   * without a virtual call per row. Implementations must not keep
+   * per-call state in members, blocks may be evaluated concurrently.
+   */
+  virtual void matchBlock(const size_t start, const size_t stop, match_block_t &matches) {
+    matches.resize(stop - start);
+    for (size_t row = start; row < stop; ++row) {
+      matches[row - start] = operator()(row);
+    }
+  }
+
   inline virtual bool operator()(size_t row) {
     throw std::runtime_error("Cannot call base class");
   }
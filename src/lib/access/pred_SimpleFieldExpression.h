@@ -2,9 +2,18 @@
 #ifndef SRC_LIB_ACCESS_PRED_SIMPLEFIELDEXPRESSION_H_
 #define SRC_LIB_ACCESS_PRED_SIMPLEFIELDEXPRESSION_H_
 
+#include <algorithm>
+#include <mutex>
+
 #include "helper/types.h"
 #include "pred_common.h"
 
+#include "storage/ChunkedTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/ZoneMap.h"
+
 class SimpleFieldExpression : public SimpleExpression {
  protected:
   hyrise::storage::c_atable_ptr_t table;
@@ -40,11 +49,244 @@ class SimpleFieldExpression : public SimpleExpression {
     if ((field == 0) && (field_name.size() > 0)) {
       field = table->numberOfColumn(field_name);
     }
+
+    // the input may have changed since the last scan
+    std::lock_guard<std::mutex> lock(partitions_mutex);
+    partitions_valid = false;
+    partitions.clear();
   }
 
   inline virtual bool operator()(size_t row) {
     throw std::runtime_error("Cannot call base class");
   }
+
+ protected:
+
+  // Fetches the value ids of the rows [start, stop) of the predicate column
+  inline void valueIdsForBlock(const size_t start, const size_t stop, ValueIdList &value_ids) const {
+    value_ids.resize(stop - start);
+    table->getValueIds(field, start, stop, value_ids.data());
+  }
+
+  /*
+   * Translates the predicate into the value ids [low, high] of dictionary
+   * of the predicate column, sets empty if no value id matches. Returns
+   * false if the predicate cannot be expressed as such a range, e.g. a
+   * range predicate on an order indifferent dictionary. Predicates that
+   * call matchValueIdRange implement this.
+   */
+  virtual bool valueIdRange(const AbstractTable::SharedDictionaryPtr &dictionary,
+                            value_id_t &low, value_id_t &high, bool &empty) const {
+    return false;
+  }
+
+  // Part of the input with a single dictionary for the predicate column,
+  // rows [offset, offset + rows) of the input are its rows [0, rows)
+  struct partition_t {
+    hyrise::storage::atable_ptr_t table;
+    size_t offset;
+    AbstractTable::SharedDictionaryPtr dictionary;
+    std::shared_ptr<const ZoneMap> zone_map;
+    // set if the column is stored in a single plain attribute vector
+    std::shared_ptr<BaseAttributeVector<value_id_t>> vector;
+    size_t column_in_vector;
+  };
+
+  // Collects the leading partitions of the input that use one dictionary
+  // each for the predicate column, i.e. the main tables of a store or
+  // the chunks of a chunked table or the input itself if it is a plain
+  // table
+  static void valueIdPartitions(const hyrise::storage::c_atable_ptr_t &input,
+                                const field_t column,
+                                std::vector<partition_t> &partitions) {
+    std::vector<hyrise::storage::atable_ptr_t> tables;
+    std::vector<std::shared_ptr<const ZoneMap>> zone_maps;
+    if (const auto store = std::dynamic_pointer_cast<const Store>(input)) {
+      tables = store->getMainTables(zone_maps);
+    } else if (const auto chunked = std::dynamic_pointer_cast<const ChunkedTable>(input)) {
+      tables = chunked->getChunks(zone_maps);
+    } else if (std::dynamic_pointer_cast<const Table<>>(input) ||
+               std::dynamic_pointer_cast<const MutableVerticalTable>(input)) {
+      tables.push_back(std::const_pointer_cast<AbstractTable>(input));
+      zone_maps.push_back(nullptr);
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < tables.size(); ++i) {
+      const auto &part = tables[i];
+      partition_t partition{part, offset, part->dictionaryAt(column), zone_maps[i], nullptr, 0};
+
+      // a zone map describes the table at the time it was built
+      if (partition.zone_map && partition.zone_map->rows() != part->size()) {
+        partition.zone_map = nullptr;
+      }
+
+      if (std::dynamic_pointer_cast<const Table<>>(part) || std::dynamic_pointer_cast<const MutableVerticalTable>(part)) {
+        const auto &avs = part->getAttributeVectors(column);
+        if (avs.size() == 1) {
+          partition.vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t>>(avs[0].attribute_vector);
+          partition.column_in_vector = avs[0].attribute_offset;
+        }
+      }
+      partitions.push_back(partition);
+      offset += part->size();
+    }
+  }
+
+  // Partitions of the input, collected once per scan instead of per morsel
+  const std::vector<partition_t> &valueIdPartitions() {
+    std::lock_guard<std::mutex> lock(partitions_mutex);
+    if (!partitions_valid) {
+      valueIdPartitions(table, field, partitions);
+      partitions_valid = true;
+    }
+    return partitions;
+  }
+
+  // Appends the rows [start, stop) of partition with value ids in [low, high]
+  inline void scanPartition(const partition_t &partition, const size_t start, const size_t stop,
+                            const value_id_t low, const value_id_t high, pos_list_t &positions) const {
+    if (partition.vector) {
+      partition.vector->scanRange(partition.column_in_vector, start, stop, low, high, positions, partition.offset);
+      return;
+    }
+
+    ValueIdList value_ids(VALUE_ID_BATCH_SIZE);
+    for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+      const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+      partition.table->getValueIds(field, batch, batch + count, value_ids.data());
+      for (size_t i = 0; i < count; ++i) {
+        if (value_ids[i].valueId >= low && value_ids[i].valueId <= high) {
+          positions.push_back(partition.offset + batch + i);
+        }
+      }
+    }
+  }
+
+  // Matches the value ids of the predicate in each partition of the input,
+  // preferably directly on its attribute vector, and skips all blocks
+  // whose zone map rules out a match; partitions without a value id range,
+  // e.g. a chunk written after it was sealed, and the remaining rows,
+  // e.g. those of the delta, are evaluated block-wise
+  inline pos_list_t* matchValueIdRange(const size_t start, const size_t stop) {
+    const auto &parts = valueIdPartitions();
+
+    auto pl = new pos_list_t;
+    std::vector<row_range_t> ranges;
+    size_t row = start;
+    // only the partitions from the one containing start on overlap
+    auto first = std::upper_bound(parts.begin(), parts.end(), start, [](const size_t row, const partition_t &partition) {
+        return row < partition.offset;
+      });
+    if (first != parts.begin()) {
+      --first;
+    }
+    for (auto it = first; it != parts.end(); ++it) {
+      const auto &partition = *it;
+      const size_t partition_stop = partition.offset + partition.table->size();
+      if (row >= stop) {
+        break;
+      }
+      if (row >= partition_stop) {
+        continue;
+      }
+
+      const size_t local_start = row - partition.offset;
+      const size_t local_stop = std::min(stop, partition_stop) - partition.offset;
+      value_id_t low, high;
+      bool empty;
+      if (!valueIdRange(partition.dictionary, low, high, empty)) {
+        pos_list_t *rows = SimpleExpression::match(row, partition.offset + local_stop);
+        pl->insert(pl->end(), rows->begin(), rows->end());
+        delete rows;
+      } else if (!empty) {
+        ranges.clear();
+        if (partition.zone_map) {
+          partition.zone_map->candidateRanges(field, local_start, local_stop, low, high, ranges);
+        } else {
+          ranges.push_back(row_range_t(local_start, local_stop));
+        }
+        for (const auto &range : ranges) {
+          scanPartition(partition, range.first, range.second, low, high, *pl);
+        }
+      }
+      row = partition.offset + local_stop;
+    }
+
+    if (row < stop) {
+      pos_list_t *rest = SimpleExpression::match(row, stop);
+      pl->insert(pl->end(), rest->begin(), rest->end());
+      delete rest;
+    }
+    return pl;
+  }
+
+ public:
+
+  // Matches like matchValueIdRange if every partition overlapping [start,
+  // stop) has a value id range and stores runs of rows, e.g. a run length
+  // encoded main, and appends whole runs as ranges
+  virtual bool matchRanges(const size_t start, const size_t stop, std::vector<row_range_t> &ranges) {
+    const auto &parts = valueIdPartitions();
+    const size_t initial = ranges.size();
+
+    std::vector<row_range_t> candidates;
+    size_t row = start;
+    auto first = std::upper_bound(parts.begin(), parts.end(), start, [](const size_t row, const partition_t &partition) {
+        return row < partition.offset;
+      });
+    if (first != parts.begin()) {
+      --first;
+    }
+    for (auto it = first; it != parts.end(); ++it) {
+      const auto &partition = *it;
+      const size_t partition_stop = partition.offset + partition.table->size();
+      if (row >= stop) {
+        break;
+      }
+      if (row >= partition_stop) {
+        continue;
+      }
+
+      value_id_t low, high;
+      bool empty;
+      if (!partition.vector || !valueIdRange(partition.dictionary, low, high, empty)) {
+        break;
+      }
+
+      const size_t local_start = row - partition.offset;
+      const size_t local_stop = std::min(stop, partition_stop) - partition.offset;
+      if (!empty) {
+        candidates.clear();
+        if (partition.zone_map) {
+          partition.zone_map->candidateRanges(field, local_start, local_stop, low, high, candidates);
+        } else {
+          candidates.push_back(row_range_t(local_start, local_stop));
+        }
+        for (const auto &candidate : candidates) {
+          if (!partition.vector->scanRanges(partition.column_in_vector, candidate.first, candidate.second,
+                                            low, high, ranges, partition.offset)) {
+            ranges.resize(initial);
+            return false;
+          }
+        }
+      }
+      row = partition.offset + local_stop;
+    }
+
+    // rows outside of the partitions, e.g. those of the delta, are
+    // matched row by row
+    if (row < stop) {
+      ranges.resize(initial);
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  std::mutex partitions_mutex;
+  bool partitions_valid = false;
+  std::vector<partition_t> partitions;
 };
 
 #endif  // SRC_LIB_ACCESS_PRED_SIMPLEFIELDEXPRESSION_H_
@@ -60,6 +60,8 @@ struct expression_factory {
       GENERATE_EXPRESSION(MultiTableEqualsExpression);
       GENERATE_EXPRESSION(MultiTableLessThanExpression);
       GENERATE_EXPRESSION(MultiTableGreaterThanExpression);
+      case PredicateType::PrefixExpression:
+        return buildPrefixExpression(_input_index, _field, _field_name, json_converter::convert<ValueType>(_value));
       default:
         throw std::runtime_error("Expression Type not supported");
     }
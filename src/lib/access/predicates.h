@@ -12,6 +12,7 @@
 #include "pred_MultiTableGreaterThanExpression.h"
 #include "pred_MultiTableLessThanExpression.h"
 #include "pred_PredicateBuilder.h"
+#include "pred_PrefixExpression.h"
 #include "pred_SimpleExpression.h"
 #include "pred_SimpleFieldExpression.h"
 
@@ -24,3 +24,18 @@ hwloc_topology_t getHWTopology(){
   return topology;
 }
 
+size_t getCacheSizeOnSystem(unsigned level){
+  hwloc_topology_t topology = getHWTopology();
+  hwloc_obj_t cache = nullptr;
+#if HWLOC_API_VERSION >= 0x00020000
+  static const hwloc_obj_type_t types[] = {HWLOC_OBJ_L1CACHE, HWLOC_OBJ_L2CACHE, HWLOC_OBJ_L3CACHE};
+  if (level >= 1 && level <= 3)
+    cache = hwloc_get_next_obj_by_type(topology, types[level - 1], nullptr);
+#else
+  while ((cache = hwloc_get_next_obj_by_type(topology, HWLOC_OBJ_CACHE, cache)) != nullptr) {
+    if (cache->attr->cache.depth == level && cache->attr->cache.type != HWLOC_OBJ_CACHE_INSTRUCTION)
+      break;
+  }
+#endif
+  return cache == nullptr ? 0 : cache->attr->cache.size;
+}
@@ -15,5 +15,9 @@ int getNumberOfCoresOnSystem();
 
 hwloc_topology_t getHWTopology();
 
+// Size in bytes of the first data or unified cache of the given level
+// (1 to 3) or 0 if the topology does not report one
+size_t getCacheSizeOnSystem(unsigned level);
+
 
 #endif /* HWLOCHELPER_H_ */
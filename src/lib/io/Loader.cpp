@@ -7,6 +7,7 @@
 #include "io/LoaderException.h"
 #include "io/ValidityTableGeneration.h"
 #include "storage/AbstractTable.h"
+#include "storage/ChunkedTable.h"
 #include "storage/LogarithmicMergeStrategy.h"
 #include "storage/SequentialHeapMerger.h"
 #include "storage/SimpleStore.h"
@@ -26,6 +27,7 @@ param_member_impl(Loader::params, bool, ModifiableMutableVerticalTable)
 param_member_impl(Loader::params, bool, ReturnsMutableVerticalTable)
 param_member_impl(Loader::params, bool, Compressed)
 param_member_impl(Loader::params, hyrise::storage::c_atable_ptr_t, ReferenceTable)
+param_member_impl(Loader::params, size_t, ChunkSize)
 
 Loader::params::params() :
   Input(nullptr),
@@ -36,7 +38,8 @@ Loader::params::params() :
   ModifiableMutableVerticalTable(false),
   ReturnsMutableVerticalTable(false),
   Compressed(false),
-  ReferenceTable()
+  ReferenceTable(),
+  ChunkSize(0)
 {}
 
 Loader::params::params(const Loader::params &other) :
@@ -45,7 +48,8 @@ Loader::params::params(const Loader::params &other) :
   InsertOnly(other.getInsertOnly()),
   ModifiableMutableVerticalTable(other.getModifiableMutableVerticalTable()),
   ReturnsMutableVerticalTable(other.getReturnsMutableVerticalTable()),
-  Compressed(other.getCompressed()) {
+  Compressed(other.getCompressed()),
+  ChunkSize(other.getChunkSize()) {
   if (other.Input != nullptr) Input = other.Input->clone();
   if (other.Header != nullptr) Header = other.Header->clone();
   if (other.ReferenceTable != nullptr) ReferenceTable = other.ReferenceTable;
@@ -64,6 +68,7 @@ Loader::params &Loader::params::operator= (const Loader::params &other) {
     setModifiableMutableVerticalTable(other.getModifiableMutableVerticalTable());
     setCompressed(other.getCompressed());
     setReferenceTable(other.getReferenceTable());
+    setChunkSize(other.getChunkSize());
   }
   // by convention, always return *this
   return *this;
@@ -80,6 +85,7 @@ Loader::params *Loader::params::clone() const {
   p->setModifiableMutableVerticalTable(ModifiableMutableVerticalTable);
   p->setReferenceTable(ReferenceTable);
   p->setCompressed(Compressed);
+  p->setChunkSize(ChunkSize);
   return p;
 }
 
@@ -142,7 +148,10 @@ std::shared_ptr<AbstractTable> Loader::load(const params &args) {
 
   LOG4CXX_DEBUG(logger, "Data done");
 
-  if (!args.getModifiableMutableVerticalTable() && input->needs_store_wrap()) {
+  const bool chunked = args.getChunkSize() > 0 && !args.getInsertOnly().InsertOnly && !args.getReturnsMutableVerticalTable();
+  if (!args.getModifiableMutableVerticalTable() && input->needs_store_wrap() && chunked) {
+    result = ChunkedTable::fromTable(result, args.getChunkSize());
+  } else if (!args.getModifiableMutableVerticalTable() && input->needs_store_wrap()) {
     std::shared_ptr<Store> s = std::make_shared<Store>(result);
     TableMerger *merger = new TableMerger(new LogarithmicMergeStrategy(0), new SequentialHeapMerger(), args.getCompressed());
     s->setMerger(merger);
@@ -41,6 +41,9 @@ private:
   param_member(bool, Compressed);
   /// Reference table used for type detection
   param_member(hyrise::storage::c_atable_ptr_t , ReferenceTable);
+  /// Return a sealed ChunkedTable with chunks of this many rows instead
+  /// of a Store, 0 for a Store
+  param_member(size_t, ChunkSize);
 public:
   params();
   ~params();
@@ -0,0 +1,177 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/MergeDaemon.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <log4cxx/logger.h>
+
+#include "io/StorageManager.h"
+#include "storage/LogarithmicMergeStrategy.h"
+#include "storage/SequentialHeapMerger.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace io {
+
+namespace {
+
+log4cxx::LoggerPtr logger(log4cxx::Logger::getLogger("hyrise.io.MergeDaemon"));
+
+struct merge_candidate_t {
+  double urgency;
+  std::string name;
+  std::shared_ptr<Store> store;
+};
+
+}
+
+MergePolicy::MergePolicy() :
+  minDeltaRows(1000),
+  maxDeltaRows(1 << 20),
+  maxDeltaDictionarySize(1 << 20),
+  maxScanPenalty(0.2),
+  deltaRowScanCost(4.0),
+  maxGenerations(0),
+  cpuBudget(0.25),
+  interval(1000) {
+}
+
+DeltaStatistics DeltaStatistics::of(const Store &store, const MergePolicy &policy) {
+  DeltaStatistics statistics;
+  statistics.mainRows = 0;
+  for (const auto &main : store.getMainTables())
+    statistics.mainRows += main->size();
+
+  const auto &delta = store.getDeltaTable();
+  statistics.deltaRows = delta->size();
+  statistics.deltaDictionarySize = 0;
+  for (size_t column = 0; column < delta->columnCount(); ++column)
+    statistics.deltaDictionarySize += delta->dictionaryAt(column)->size();
+
+  const size_t rows = statistics.mainRows + statistics.deltaRows;
+  statistics.scanPenalty = rows == 0 ? 0.0 : statistics.deltaRows * (policy.deltaRowScanCost - 1.0) / rows;
+  return statistics;
+}
+
+MergeDaemon::MergeDaemon(const MergePolicy &policy) : _policy(policy), _running(false), _nextMerge(0), _mergeStart(0) {
+  if (_policy.cpuBudget <= 0.0 || _policy.cpuBudget > 1.0)
+    throw std::runtime_error("MergeDaemon needs a cpu budget in (0, 1]");
+}
+
+MergeDaemon::~MergeDaemon() {
+  stop();
+}
+
+void MergeDaemon::start() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_running)
+    return;
+  _running = true;
+  _thread = std::thread(&MergeDaemon::run, this);
+}
+
+void MergeDaemon::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_running)
+      return;
+    _running = false;
+  }
+  _wakeup.notify_all();
+  _thread.join();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_merging) {
+    _merging->waitForMerge();
+    finishMerge();
+  }
+}
+
+void MergeDaemon::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (_running) {
+    lock.unlock();
+    try {
+      tick();
+    } catch (const std::exception &e) {
+      LOG4CXX_ERROR(logger, "Merge failed: " << e.what());
+    }
+    lock.lock();
+    _wakeup.wait_for(lock, _policy.interval, [this]() { return !_running; });
+  }
+}
+
+bool MergeDaemon::needsMerge(const DeltaStatistics &statistics, const MergePolicy &policy) {
+  return statistics.deltaRows >= policy.minDeltaRows && urgency(statistics, policy) >= 1.0;
+}
+
+double MergeDaemon::urgency(const DeltaStatistics &statistics, const MergePolicy &policy) {
+  return std::max(std::max(double(statistics.deltaRows) / policy.maxDeltaRows,
+                           double(statistics.deltaDictionarySize) / policy.maxDeltaDictionarySize),
+                  statistics.scanPenalty / policy.maxScanPenalty);
+}
+
+void MergeDaemon::startMerge(const std::string &name, const std::shared_ptr<Store> &store) {
+  if (!store->hasMerger())
+    store->setMerger(new TableMerger(new LogarithmicMergeStrategy(_policy.maxGenerations), new SequentialHeapMerger()));
+  LOG4CXX_DEBUG(logger, "Merging " << name);
+  _mergeStart = get_epoch_nanoseconds();
+  store->startMerge();
+  _merging = store;
+  _mergingName = name;
+}
+
+bool MergeDaemon::finishMerge() {
+  if (!_merging)
+    return true;
+  if (_merging->isMerging())
+    return false;
+
+  auto store = _merging;
+  _merging = nullptr;
+  // the merge published its tables already, this only releases its task
+  store->waitForMerge();
+
+  const epoch_t duration = get_epoch_nanoseconds() - _mergeStart;
+  LOG4CXX_DEBUG(logger, "Merged " << _mergingName << " in " << duration << "ns");
+  _nextMerge = _mergeStart + duration + epoch_t(duration * (1.0 - _policy.cpuBudget) / _policy.cpuBudget);
+  return true;
+}
+
+size_t MergeDaemon::tick() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!finishMerge())
+    return 0;
+
+  std::vector<merge_candidate_t> candidates;
+  for (const auto &kv : StorageManager::getInstance()->getLoadedTables()) {
+    auto store = std::dynamic_pointer_cast<Store>(kv.second);
+    if (!store)
+      continue;
+    const DeltaStatistics statistics = DeltaStatistics::of(*store, _policy);
+    if (needsMerge(statistics, _policy))
+      candidates.push_back(merge_candidate_t{urgency(statistics, _policy), kv.first, store});
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const merge_candidate_t &a, const merge_candidate_t &b) {
+      return a.urgency > b.urgency;
+    });
+
+  // without a scheduler merges complete in startMerge, so several of
+  // them may fit into one check
+  size_t started = 0;
+  for (const auto &candidate : candidates) {
+    if (get_epoch_nanoseconds() < _nextMerge)
+      break;
+    startMerge(candidate.name, candidate.store);
+    ++started;
+    if (!finishMerge())
+      break;
+  }
+  return started;
+}
+
+}
+}  // namespace hyrise::io
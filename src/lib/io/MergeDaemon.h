@@ -0,0 +1,115 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_IO_MERGEDAEMON_H_
+#define SRC_LIB_IO_MERGEDAEMON_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "helper/epoch.h"
+#include "helper/types.h"
+
+class Store;
+
+namespace hyrise {
+namespace io {
+
+/// Thresholds of the MergeDaemon, a store is merged once its delta
+/// exceeds any of them
+struct MergePolicy {
+  MergePolicy();
+
+  /// Deltas with fewer rows are never merged
+  size_t minDeltaRows;
+  /// Merge once the delta holds this many rows
+  size_t maxDeltaRows;
+  /// Merge once the delta dictionaries of all columns together hold this
+  /// many values
+  size_t maxDeltaDictionarySize;
+  /// Merge once scans spend this fraction of additional time on the
+  /// delta, see DeltaStatistics::scanPenalty
+  double maxScanPenalty;
+  /// Scan time of a delta row relative to a main row. This is a fixed
+  /// model constant, not a measurement: a main row is compared by value
+  /// id, a delta row is decoded through its unordered dictionary and
+  /// compared by value. Tune it to the ratio observed on the target
+  /// hardware.
+  double deltaRowScanCost;
+  /// Generations a LogarithmicMergeStrategy keeps for stores that have
+  /// no merger yet, 0 merges everything into one main
+  size_t maxGenerations;
+  /// Fraction of the daemon's wall time that merges may take
+  double cpuBudget;
+  /// Time between two checks of all stores
+  std::chrono::milliseconds interval;
+};
+
+/// State of a store's delta the MergeDaemon decides on
+struct DeltaStatistics {
+  size_t mainRows;
+  size_t deltaRows;
+  size_t deltaDictionarySize;
+  /// Estimated additional scan time caused by the delta relative to a
+  /// scan of the same rows in the main, deltaRows * (deltaRowScanCost -
+  /// 1) / (mainRows + deltaRows)
+  double scanPenalty;
+
+  static DeltaStatistics of(const Store &store, const MergePolicy &policy);
+};
+
+/// Merges the stores of the StorageManager in the background as soon as
+/// their deltas exceed the thresholds of a MergePolicy.
+///
+/// Stores are checked periodically, the most urgent ones first. Merges
+/// run one at a time via the non-blocking Store::startMerge, a check
+/// skips all stores while the last merge is still running. After a merge
+/// that took t the daemon pauses t * (1 - cpuBudget) / cpuBudget before
+/// the next one. Queries read stores through snapshots, see
+/// StorageManager::getTableSnapshot, so a merge published while they run
+/// does not renumber the partitions their value ids refer to.
+class MergeDaemon {
+ public:
+  explicit MergeDaemon(const MergePolicy &policy = MergePolicy());
+  ~MergeDaemon();
+
+  /// Starts checking the stores periodically on a background thread
+  void start();
+  /// Stops the background thread after the running merge
+  void stop();
+
+  /// Checks all loaded stores once and starts merges of those over the
+  /// thresholds as far as the budget allows; returns the number of
+  /// started merges
+  size_t tick();
+
+  static bool needsMerge(const DeltaStatistics &statistics, const MergePolicy &policy);
+  /// How far the delta exceeds the policy, > 1 if it needs a merge
+  static double urgency(const DeltaStatistics &statistics, const MergePolicy &policy);
+
+ private:
+  void run();
+  /// Starts merging store, _mutex must be held
+  void startMerge(const std::string &name, const std::shared_ptr<Store> &store);
+  /// Collects the last merge if it is done, returns whether it was;
+  /// _mutex must be held
+  bool finishMerge();
+
+  const MergePolicy _policy;
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _wakeup;
+  bool _running;
+  epoch_t _nextMerge;
+  /// Store of the merge started last until the daemon collected it
+  std::shared_ptr<Store> _merging;
+  std::string _mergingName;
+  epoch_t _mergeStart;
+};
+
+}
+}  // namespace hyrise::io
+
+#endif  // SRC_LIB_IO_MERGEDAEMON_H_
@@ -15,6 +15,7 @@
 #include "helper/stringhelpers.h"
 #include "io/CSVLoader.h"
 #include "storage/AbstractTable.h"
+#include "storage/Store.h"
 #include "storage/TableBuilder.h"
 
 namespace hyrise {
@@ -178,6 +179,14 @@ std::shared_ptr<AbstractTable> StorageManager::getTable(std::string name) {
   return _schema[name].getTable();
 }
 
+std::shared_ptr<AbstractTable> StorageManager::getTableSnapshot(std::string name) {
+  const auto table = getTable(name);
+  if (const auto store = std::dynamic_pointer_cast<Store>(table)) {
+    return store->snapshot();
+  }
+  return table;
+}
+
 bool StorageManager::exists(std::string name) const {
   return _schema.count(name) == 1;
  }
@@ -211,6 +220,15 @@ std::vector<std::string> StorageManager::getTableNames() const {
   return ret;
 }
 
+std::map<std::string, std::shared_ptr<AbstractTable> > StorageManager::getLoadedTables() {
+  std::lock_guard<std::mutex> lock(_schema_mutex);
+  std::map<std::string, std::shared_ptr<AbstractTable> > ret;
+  for (const auto & kv : _schema)
+    if (kv.second.isLoaded())
+      ret[kv.first] = kv.second.getTable();
+  return ret;
+}
+
 const std::string SYSTEM_PREFIX = "sys:";
 
 bool is_not_sys_table(StorageManager::schema_map_t::value_type i) {
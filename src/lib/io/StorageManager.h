@@ -141,6 +141,12 @@ class StorageManager {
   /// @param[in] name Table name
   std::shared_ptr<AbstractTable> getTable(std::string name);
 
+  /// Get a table for reading in a query, a store is pinned to its
+  /// current main tables and delta so that merges published while the
+  /// query runs do not change it, see Store::snapshot()
+  /// @param[in] name Table name
+  std::shared_ptr<AbstractTable> getTableSnapshot(std::string name);
+
   /// saves the inverted index using the name table_name.
   void addInvertedIndex(std::string table_name, std::shared_ptr<AbstractIndex> _index);
 
@@ -157,6 +163,8 @@ class StorageManager {
 
   /// Retrieve all table names
   std::vector<std::string> getTableNames() const;
+  /// Retrieve all tables that are loaded, without loading any others
+  std::map<std::string, std::shared_ptr<AbstractTable> > getLoadedTables();
   /// Retrieve number of tables
   size_t size() const;
 
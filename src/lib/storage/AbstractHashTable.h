@@ -11,6 +11,7 @@
 #include "storage/storage_types.h"
 
 class AbstractTable;
+class JoinFilter;
 
 /// HashTable that maps table cells' hashed values of arbitrary columns to their rows.
 class AbstractHashTable : public AbstractResource {
@@ -27,6 +28,14 @@ public:
                          const field_list_t &columns,
                          const pos_t row) const = 0;
 
+  /// Whether any row matches the values in the table cells of given row
+  /// and columns; unlike get() stops at the first match
+  virtual bool contains(const hyrise::storage::c_atable_ptr_t& table,
+                        const field_list_t &columns,
+                        const pos_t row) const {
+    return !get(table, columns, row).empty();
+  }
+
   virtual hyrise::storage::c_atable_ptr_t getTable() const = 0;
 
   virtual field_list_t getFields() const = 0;
@@ -34,6 +43,19 @@ public:
   virtual size_t getFieldCount() const = 0;
 
   virtual uint64_t numKeys() const = 0;
+
+  /// Summary of the hashed keys that scans on the probe input may apply,
+  /// nullptr if none was built
+  std::shared_ptr<const JoinFilter> getJoinFilter() const {
+    return _joinFilter;
+  }
+
+  void setJoinFilter(const std::shared_ptr<const JoinFilter> &filter) {
+    _joinFilter = filter;
+  }
+
+private:
+  std::shared_ptr<const JoinFilter> _joinFilter;
 };
 
 #endif  // SRC_LIB_STORAGE_ABSTRACTHASHTABLE_H_
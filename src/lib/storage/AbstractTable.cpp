@@ -2,6 +2,7 @@
 #include <memory/NumaStrategy.h>
 #include <memory/MemalignStrategy.h>
 #include <storage/AbstractTable.h>
+#include <storage/ConcurrentDeltaDictionary.h>
 
 #include <storage/MutableVerticalTable.h>
 #include <storage/Table.h>
@@ -56,12 +57,12 @@ hyrise::storage::atable_ptr_t AbstractTable::copy_structure_modifiable(const fie
   if (fields != nullptr) {
 for (const field_t & field: *fields) {
       metadata.push_back(metadataAt(field));
-      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<OrderIndifferentDictionary> >(metadataAt(field)->getType()));
+      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<ConcurrentDeltaDictionary> >(metadataAt(field)->getType()));
     }
   } else {
     for (size_t i = 0; i < columnCount(); ++i) {
       metadata.push_back(metadataAt(i));
-      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<OrderIndifferentDictionary> >(metadataAt(i)->getType()));
+      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<ConcurrentDeltaDictionary> >(metadataAt(i)->getType()));
     }
   }
 
@@ -81,6 +82,18 @@ std::vector<AbstractTable::SharedDictionaryPtr> *AbstractTable::dictionaries() c
   return result;
 }
 
+void AbstractTable::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  for (size_t row = start; row < stop; ++row) {
+    value_ids[row - start] = getValueId(column, row);
+  }
+}
+
+void AbstractTable::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  for (size_t i = 0; i < count; ++i) {
+    value_ids[i] = getValueId(column, rows[i]);
+  }
+}
+
 ValueIdList AbstractTable::copyValueIds(const size_t row, const field_list_t *fields) const {
   ValueIdList valueIdList;
 
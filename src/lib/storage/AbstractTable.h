@@ -158,14 +158,15 @@ public:
   metadata_vec_t metadata() const;
 
   /**
-   * Get the dictionary for a certain column.
+   * Get the dictionary for a certain column. The dictionary is returned
+   * by value, it stays valid if a merge replaces the table it belongs to.
    * @note Must be implemented by any derived class!
    *
    * @param column   Column from which to extract the dictionary.
    * @param row      Row in that column (default=0).
    * @param table_id ID of the table from which to extract (default=0).
    */
-  virtual const SharedDictionaryPtr& dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const = 0;
+  virtual SharedDictionaryPtr dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const = 0;
 
 
   /**
@@ -175,7 +176,7 @@ public:
    * @param column   Column from which to extract the dictionary.
    * @param table_id ID of the table from which to extract.
    */
-  virtual const SharedDictionaryPtr& dictionaryByTableId(const size_t column, const table_id_t table_id) const = 0;
+  virtual SharedDictionaryPtr dictionaryByTableId(const size_t column, const table_id_t table_id) const = 0;
 
 
   /**
@@ -244,6 +245,31 @@ public:
   virtual ValueId getValueId(const size_t column, const size_t row) const = 0;
 
 
+  /**
+   * Decodes the value-IDs of the rows [start, stop) of a column into a
+   * caller-provided buffer. The default implementation calls getValueId()
+   * per row, derived classes decode directly on their storage.
+   *
+   * @param column    Column number of the cells.
+   * @param start     First row to decode.
+   * @param stop      Row after the last row to decode.
+   * @param value_ids Buffer with room for stop - start value-IDs.
+   */
+  virtual void getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const;
+
+
+  /**
+   * Gathers the value-IDs of a column for a list of rows into a
+   * caller-provided buffer.
+   *
+   * @param column    Column number of the cells.
+   * @param rows      Row numbers to gather.
+   * @param count     Number of rows.
+   * @param value_ids Buffer with room for count value-IDs.
+   */
+  virtual void gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const;
+
+
   /**
    * Sets the value ID of a cell.
    * @note Should be implemented in derived classes or throws runtime error!
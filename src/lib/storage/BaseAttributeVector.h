@@ -5,6 +5,7 @@
 #include <memory>
 #include <stdexcept>
 #include <storage/AbstractAttributeVector.h>
+#include <storage/storage_types.h>
 
 
 /*
@@ -53,6 +54,58 @@ public:
 
   virtual void rewriteColumn(const size_t column, const size_t bits) = 0;
 
+  /*
+   * Returns the address of the first value of row for vectors that keep
+   * the values of a row next to each other. Defaults to the row major
+   * layout of data() with the given number of columns.
+   */
+  virtual T *rowData(size_t row, size_t columns) {
+    return static_cast<T *>(this->data()) + row * columns;
+  }
+
+  /*
+   * Decodes the values of the rows [start, stop) of column into the
+   * caller-provided buffer values, which holds stop - start entries.
+   */
+  virtual void decode(size_t column, size_t start, size_t stop, T *values) const {
+    for (size_t row = start; row < stop; ++row) {
+      values[row - start] = get(column, row);
+    }
+  }
+
+  /*
+   * Gathers the values of column for count rows into values.
+   */
+  virtual void gather(size_t column, const pos_t *rows, size_t count, T *values) const {
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = get(column, rows[i]);
+    }
+  }
+
+  /*
+   * Appends offset + row to positions for every row in [start, stop)
+   * whose value in column lies within [low, high]. Vectors that can
+   * compare without decoding single values override this.
+   */
+  virtual void scanRange(size_t column, size_t start, size_t stop, T low, T high, pos_list_t &positions, size_t offset = 0) const {
+    for (size_t row = start; row < stop; ++row) {
+      T value = get(column, row);
+      if (value >= low && value <= high) {
+        positions.push_back(offset + row);
+      }
+    }
+  }
+
+  /*
+   * Like scanRange, but appends the matching rows shifted by offset as
+   * ascending row ranges. Returns false without appending anything if
+   * the vector does not store runs of rows, the caller then scans for
+   * positions instead.
+   */
+  virtual bool scanRanges(size_t column, size_t start, size_t stop, T low, T high, std::vector<row_range_t> &ranges, size_t offset = 0) const {
+    return false;
+  }
+
 };
 
 #endif  // SRC_LIB_STORAGE_BASEATTRIBUTEVECTOR_H_
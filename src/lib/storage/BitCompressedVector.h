@@ -6,12 +6,14 @@
 #include <stdint.h>
 #include <cstring>
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <stdexcept>
 
 #include <storage/AbstractAttributeVector.h>
 #include <storage/BaseAttributeVector.h>
+#include <storage/scan_kernels.h>
 
 #ifndef WORD_LENGTH
 #define WORD_LENGTH 64
@@ -121,6 +123,65 @@ public:
     }
   }
 
+  /*
+    Decodes the rows [start, stop) of a column by advancing a running
+    bit offset, which avoids the per-row divisions of get()
+   */
+  void decode(size_t column, size_t start, size_t stop, T *values) const {
+    const uint64_t width = _tupleWidth();
+    const uint64_t bits = _bits[column];
+    uint64_t bit = width * start + _offsetForColumn(column);
+
+    for (size_t row = start; row < stop; ++row, bit += width) {
+      values[row - start] = _extract(bit, bits);
+    }
+  }
+
+  void gather(size_t column, const pos_t *rows, size_t count, T *values) const {
+    const uint64_t width = _tupleWidth();
+    const uint64_t bits = _bits[column];
+    const uint64_t colOffset = _offsetForColumn(column);
+
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = _extract(width * rows[i] + colOffset, bits);
+    }
+  }
+
+  /*
+    Scans a column without calling get() per row. The packed values are
+    unpacked with shifts and masks and compared in registers by the
+    packed range kernel; only the last rows, whose 64 bit load would
+    read past the data, are extracted one by one.
+   */
+  void scanRange(size_t column, size_t start, size_t stop, T low, T high, pos_list_t &positions, size_t offset = 0) const {
+    static_assert(sizeof(T) <= sizeof(uint32_t), "scan kernel only supports 32 bit value ids");
+    if (start >= stop) {
+      return;
+    }
+
+    const uint64_t width = _tupleWidth();
+    const uint64_t bits = _bits[column];
+    const uint64_t first = width * start + _offsetForColumn(column);
+
+    // rows whose first byte leaves 8 readable bytes
+    const uint64_t bytes = _allocatedBlocks * sizeof(storage_t);
+    size_t loadable = 0;
+    if (bytes >= sizeof(storage_t) && width > 0) {
+      const uint64_t last_bit = (bytes - sizeof(storage_t)) * 8 + 7;
+      loadable = last_bit < first ? 0 : std::min<uint64_t>(stop - start, (last_bit - first) / width + 1);
+    }
+
+    hyrise::storage::appendPackedPositionsInRange(_data, first, width, bits, loadable, low, high, positions, offset + start);
+
+    uint64_t bit = first + loadable * width;
+    for (size_t row = start + loadable; row < stop; ++row, bit += width) {
+      const uint64_t value = _extract(bit, bits);
+      if (value >= low && value <= high) {
+        positions.push_back(offset + row);
+      }
+    }
+  }
+
   /*
     Reserve memory for the given number of rows. memory will only be
     allocated if the number of rows requires a larger number of blocks
@@ -211,6 +272,20 @@ private:
     return offset;
   }
 
+  /*
+    Extracts the value of the given width starting at an absolute bit
+    position, the value may span two storage words
+   */
+  inline uint64_t _extract(const uint64_t bit, const uint64_t bits) const {
+    const uint64_t word = bit / _bit_width;
+    const uint64_t shift = bit % _bit_width;
+    uint64_t value = _data[word] >> shift;
+    if (shift + bits > _bit_width) {
+      value |= _data[word + 1] << (_bit_width - shift);
+    }
+    return value & ((1ull << bits) - 1ull);
+  }
+
   /*
     Calculates the starting block for the row
    */
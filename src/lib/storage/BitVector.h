@@ -2,81 +2,171 @@
 #ifndef SRC_LIB_STORAGE_BITVECTOR_H_
 #define SRC_LIB_STORAGE_BITVECTOR_H_
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 /*
 
   USAGE:
 
-  BitVector vector;
-
-  vector.reserve(10);
+  BitVector vector(10);
 
   vector.set(4, true);
+  vector.set(7, true);
 
   std::cout << vector.get(4) << std::endl;
   std::cout << vector.get(5) << std::endl;
 
-  return 0;
+  vector.buildRankIndex();
+  std::cout << vector.select(1) << std::endl;
 
   // prints:
 
   1
   0
+  7
 
 */
 
-#ifndef BITS_PER_BYTE
-#define BITS_PER_BYTE 8
-#endif
-
+/*
+  Fixed size vector of bits, stored in 64 bit words. Besides single bits
+  it combines whole vectors word by word and finds the n-th set bit
+  (select), which needs a rank index that has to be rebuilt after the
+  bits were changed. Bits past size() are always zero.
+*/
 class BitVector {
  public:
-  unsigned char *_values;
-  size_t _allocated_bytes;
+  typedef uint64_t word_t;
+
+  static const size_t bits_per_word = 64;
+
+  // set bits before each block of words, used by select
+  static const size_t words_per_rank = 8;
+
+ private:
+  std::vector<word_t> _words;
+  std::vector<size_t> _ranks;
+  size_t _size;
+
+  static size_t wordCount(size_t bits) {
+    return (bits + bits_per_word - 1) / bits_per_word;
+  }
+
+  static size_t popcount(word_t word) {
+    return __builtin_popcountll(word);
+  }
+
+  static size_t lowestBit(word_t word) {
+    return __builtin_ctzll(word);
+  }
 
  public:
-  BitVector();
-  bool get(size_t index);
-  void set(size_t index, bool value);
-  void reserve(size_t bytes);
-};
+  explicit BitVector(size_t bits = 0) : _words(wordCount(bits), 0), _size(bits) {
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool get(size_t index) const {
+    return (_words[index / bits_per_word] >> (index % bits_per_word)) & 1;
+  }
 
-BitVector::BitVector() {
-  _values = nullptr;
-  _allocated_bytes = 0;
-}
+  void set(size_t index, bool value) {
+    const word_t mask = word_t(1) << (index % bits_per_word);
+    if (value) {
+      _words[index / bits_per_word] |= mask;
+    } else {
+      _words[index / bits_per_word] &= ~mask;
+    }
+  }
 
-bool BitVector::get(size_t index) {
-  size_t byte_offset = index / BITS_PER_BYTE;
-  size_t bit_offset  = index % BITS_PER_BYTE;
+  // Sets the bits [start, stop)
+  void setRange(size_t start, size_t stop) {
+    for (size_t index = start; index < stop;) {
+      const size_t word = index / bits_per_word;
+      const size_t offset = index % bits_per_word;
+      const size_t bits = std::min(bits_per_word - offset, stop - index);
+      const word_t mask = bits == bits_per_word ? ~word_t(0) : ((word_t(1) << bits) - 1) << offset;
+      _words[word] |= mask;
+      index += bits;
+    }
+  }
 
-  return _values[byte_offset] & (1 << (7 - bit_offset));
-}
+  // Number of set bits
+  size_t count() const {
+    size_t result = 0;
+    for (const auto &word : _words)
+      result += popcount(word);
+    return result;
+  }
 
-void BitVector::set(size_t index, bool value) {
-  size_t byte_offset = index / BITS_PER_BYTE;
-  size_t bit_offset  = index % BITS_PER_BYTE;
+  // First set bit at or after index, size() if there is none
+  size_t nextSetBit(size_t index) const {
+    if (index >= _size)
+      return _size;
+    size_t word = index / bits_per_word;
+    word_t bits = _words[word] & (~word_t(0) << (index % bits_per_word));
+    while (bits == 0) {
+      if (++word == _words.size())
+        return _size;
+      bits = _words[word];
+    }
+    return word * bits_per_word + lowestBit(bits);
+  }
 
-  if (value) {
-    _values[byte_offset] |= 1 << (7 - bit_offset);
-  } else {
-    _values[byte_offset] &= ~(1 << (7 - bit_offset));
+  // Calls function with the index of every set bit in ascending order
+  template <typename F>
+  void forEachSetBit(F function) const {
+    for (size_t word = 0; word < _words.size(); ++word) {
+      for (word_t bits = _words[word]; bits != 0; bits &= bits - 1)
+        function(word * bits_per_word + lowestBit(bits));
+    }
   }
-}
 
-void BitVector::reserve(size_t bytes) {
-  void *new_values = realloc(_values, bytes);
+  BitVector &operator&=(const BitVector &other) {
+    if (other._size != _size)
+      throw std::runtime_error("Bit vectors differ in size");
+    for (size_t word = 0; word < _words.size(); ++word)
+      _words[word] &= other._words[word];
+    return *this;
+  }
 
-  if (new_values == nullptr) {
-    free(_values);
-    throw std::bad_alloc();
+  BitVector &operator|=(const BitVector &other) {
+    if (other._size != _size)
+      throw std::runtime_error("Bit vectors differ in size");
+    for (size_t word = 0; word < _words.size(); ++word)
+      _words[word] |= other._words[word];
+    return *this;
   }
 
-  if (bytes > _allocated_bytes) {
-    memset(new_values + _allocated_bytes, 0, bytes - _allocated_bytes);
+  // Counts the set bits before each block of words_per_rank words
+  void buildRankIndex() {
+    _ranks.clear();
+    size_t rank = 0;
+    for (size_t word = 0; word < _words.size(); ++word) {
+      if (word % words_per_rank == 0)
+        _ranks.push_back(rank);
+      rank += popcount(_words[word]);
+    }
   }
 
-  _values = (unsigned char *) new_values;
-  _allocated_bytes = bytes;
-}
+  // Index of the set bit with rank n, i.e. the n + 1-th set bit
+  size_t select(size_t n) const {
+    const size_t block = std::upper_bound(_ranks.begin(), _ranks.end(), n) - _ranks.begin() - 1;
+    size_t rank = _ranks[block];
+    size_t word = block * words_per_rank;
+    while (rank + popcount(_words[word]) <= n)
+      rank += popcount(_words[word++]);
+
+    word_t bits = _words[word];
+    for (; rank < n; ++rank)
+      bits &= bits - 1;
+    return word * bits_per_word + lowestBit(bits);
+  }
+};
 
 #endif  // SRC_LIB_STORAGE_BITVECTOR_H_
@@ -0,0 +1,325 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ChunkedTable.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "storage/BaseDictionary.h"
+#include "storage/ConcurrentDeltaDictionary.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/OrderPreservingDictionary.h"
+#include "storage/TableUtils.h"
+#include "storage/ZoneMap.h"
+#include "storage/meta_storage.h"
+
+namespace {
+  // Re-encodes a column of a chunk that uses the shared dictionary with an
+  // order preserving dictionary of the values occurring in the chunk,
+  // shared_ids receives the shared value id of every new value id
+  struct EncodeOrdered {
+    typedef void value_type;
+
+    const std::shared_ptr<ChunkedTable::chunk_t> &chunk;
+    const size_t column;
+    std::vector<value_id_t> &shared_ids;
+
+    template <typename T>
+    void operator()() {
+      const auto shared = std::dynamic_pointer_cast<BaseDictionary<T>>(chunk->dictionaryAt(column));
+      const size_t rows = chunk->size();
+      ValueIdList value_ids(rows);
+      chunk->getValueIds(column, 0, rows, value_ids.data());
+
+      std::vector<value_id_t> distinct(rows);
+      for (size_t row = 0; row < rows; ++row)
+        distinct[row] = value_ids[row].valueId;
+      std::sort(distinct.begin(), distinct.end());
+      distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+      std::vector<std::pair<T, value_id_t>> values;
+      values.reserve(distinct.size());
+      for (const auto &value_id : distinct)
+        values.push_back(std::make_pair(shared->getValueForValueId(value_id), value_id));
+      std::sort(values.begin(), values.end());
+
+      // local[i] is the new value id of the shared value id distinct[i]
+      auto dictionary = std::make_shared<OrderPreservingDictionary<T>>(values.size());
+      std::vector<value_id_t> local(distinct.size());
+      shared_ids.clear();
+      for (const auto &value : values) {
+        const size_t position = std::lower_bound(distinct.begin(), distinct.end(), value.second) - distinct.begin();
+        local[position] = dictionary->addValue(value.first);
+        shared_ids.push_back(value.second);
+      }
+
+      for (size_t row = 0; row < rows; ++row) {
+        const size_t position = std::lower_bound(distinct.begin(), distinct.end(), value_ids[row].valueId) - distinct.begin();
+        chunk->setValueId(column, row, ValueId(local[position], 0));
+      }
+      chunk->setDictionaryAt(dictionary, column);
+    }
+  };
+}
+
+ChunkedTable::ChunkedTable(const std::vector<const ColumnMetadata *> &metadata,
+                           const std::vector<SharedDictionaryPtr> *dictionaries,
+                           size_t chunkSize) :
+  _chunkSize(chunkSize),
+  _size(0) {
+  if (_chunkSize == 0)
+    throw std::runtime_error("Chunk size must not be zero");
+
+  for (const auto *column : metadata)
+    _metadata.push_back(*column);
+
+  if (dictionaries) {
+    if (dictionaries->size() != metadata.size())
+      throw std::runtime_error("Need one dictionary per column");
+    _dictionaries = *dictionaries;
+  } else {
+    // all chunks insert into the same dictionaries, possibly at once
+    for (const auto &column : _metadata)
+      _dictionaries.push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<ConcurrentDeltaDictionary> >(column.getType()));
+  }
+}
+
+ChunkedTable::~ChunkedTable() {
+}
+
+std::shared_ptr<ChunkedTable> ChunkedTable::fromTable(const hyrise::storage::c_atable_ptr_t &table, size_t chunkSize) {
+  std::vector<const ColumnMetadata *> metadata;
+  for (size_t column = 0; column < table->columnCount(); ++column)
+    metadata.push_back(table->metadataAt(column));
+
+  auto result = std::make_shared<ChunkedTable>(metadata, nullptr, chunkSize);
+  result->resize(table->size());
+  for (size_t row = 0; row < table->size(); ++row)
+    result->copyRowFrom(table, row, row);
+  result->seal();
+  return result;
+}
+
+std::shared_ptr<ChunkedTable::chunk_t> ChunkedTable::newChunk() const {
+  std::vector<const ColumnMetadata *> metadata;
+  for (const auto &column : _metadata)
+    metadata.push_back(&column);
+  auto dictionaries = _dictionaries;
+  return std::make_shared<chunk_t>(&metadata, &dictionaries, _chunkSize, false,
+                                   STORAGE_ALIGNMENT_SIZE, STORAGE_ALIGNMENT_SIZE, false);
+}
+
+const std::shared_ptr<ChunkedTable::chunk_t> &ChunkedTable::firstChunk() const {
+  if (_chunks.empty())
+    throw std::runtime_error("Chunked table has no rows");
+  return _chunks.front();
+}
+
+std::vector<hyrise::storage::atable_ptr_t> ChunkedTable::getChunks(std::vector<std::shared_ptr<const ZoneMap>> &zone_maps) const {
+  zone_maps = _zoneMaps;
+  return std::vector<hyrise::storage::atable_ptr_t>(_chunks.begin(), _chunks.end());
+}
+
+size_t ChunkedTable::seal() {
+  std::vector<size_t> unsealed;
+  for (size_t index = 0; index < _chunks.size(); ++index)
+    if (_sharedIds[index].empty() && _chunks[index]->size() == _chunkSize)
+      unsealed.push_back(index);
+
+  executeMorsels(unsealed.size(), [&](size_t, size_t first, size_t last) {
+      hyrise::storage::type_switch<hyrise_basic_types> ts;
+      for (size_t i = first; i < last; ++i) {
+        const size_t index = unsealed[i];
+        const auto &chunk = _chunks[index];
+        std::vector<std::vector<value_id_t>> shared_ids(columnCount());
+        for (size_t column = 0; column < columnCount(); ++column) {
+          EncodeOrdered encode {chunk, column, shared_ids[column]};
+          ts(_metadata[column].getType(), encode);
+        }
+        _sharedIds[index] = std::move(shared_ids);
+        hyrise::storage::runLengthEncodeWhereSmaller(chunk);
+        _zoneMaps[index] = std::make_shared<ZoneMap>(chunk);
+      }
+    }, 1);
+  return unsealed.size();
+}
+
+void ChunkedTable::unseal(size_t index) {
+  const auto &chunk = _chunks[index];
+  const size_t rows = chunk->size();
+  auto vector = std::make_shared<FixedLengthVector<value_id_t>>(columnCount(), _chunkSize);
+  vector->resize(rows);
+
+  ValueIdList value_ids(rows);
+  for (size_t column = 0; column < columnCount(); ++column) {
+    chunk->getValueIds(column, 0, rows, value_ids.data());
+    for (size_t row = 0; row < rows; ++row)
+      vector->set(column, row, sharedValueId(index, column, value_ids[row].valueId));
+  }
+
+  chunk->setAttributes(vector);
+  for (size_t column = 0; column < columnCount(); ++column)
+    chunk->setDictionaryAt(_dictionaries[column], column);
+  _sharedIds[index].clear();
+  _zoneMaps[index] = nullptr;
+}
+
+size_t ChunkedTable::morselSizeFor(const hyrise::storage::c_atable_ptr_t &table) {
+  if (const auto chunked = std::dynamic_pointer_cast<const ChunkedTable>(table))
+    return chunked->chunkSize();
+  return DEFAULT_MORSEL_SIZE;
+}
+
+const ColumnMetadata *ChunkedTable::metadataAt(const size_t column, const size_t row, const table_id_t table_id) const {
+  return &_metadata.at(column);
+}
+
+AbstractTable::SharedDictionaryPtr ChunkedTable::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
+  return _dictionaries[column];
+}
+
+AbstractTable::SharedDictionaryPtr ChunkedTable::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
+  return _dictionaries[column];
+}
+
+// The dictionary is shared, so it is replaced in every chunk, sealed
+// chunks are encoded with the shared dictionaries first
+void ChunkedTable::setDictionaryAt(SharedDictionaryPtr dict, const size_t column, const size_t row, const table_id_t table_id) {
+  for (size_t index = 0; index < _chunks.size(); ++index) {
+    if (!_sharedIds[index].empty())
+      unseal(index);
+  }
+  _dictionaries[column] = dict;
+  for (const auto &chunk : _chunks)
+    chunk->setDictionaryAt(dict, column);
+}
+
+size_t ChunkedTable::size() const {
+  return _size;
+}
+
+size_t ChunkedTable::columnCount() const {
+  return _metadata.size();
+}
+
+void ChunkedTable::toSharedValueIds(size_t index, size_t column, ValueId *value_ids, size_t count) const {
+  if (_sharedIds[index].empty())
+    return;
+  const auto &shared_ids = _sharedIds[index][column];
+  for (size_t i = 0; i < count; ++i)
+    value_ids[i].valueId = shared_ids[value_ids[i].valueId];
+}
+
+ValueId ChunkedTable::getValueId(const size_t column, const size_t row) const {
+  const size_t index = row / _chunkSize;
+  ValueId value_id = _chunks[index]->getValueId(column, row % _chunkSize);
+  toSharedValueIds(index, column, &value_id, 1);
+  return value_id;
+}
+
+// Splits the range at chunk boundaries
+void ChunkedTable::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  for (size_t first = start; first < stop;) {
+    const size_t index = first / _chunkSize;
+    const size_t last = std::min(stop, (index + 1) * _chunkSize);
+    _chunks[index]->getValueIds(column, first - index * _chunkSize, last - index * _chunkSize, value_ids + (first - start));
+    toSharedValueIds(index, column, value_ids + (first - start), last - first);
+    first = last;
+  }
+}
+
+// Consecutive rows located in the same chunk are gathered together
+void ChunkedTable::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  pos_list_t local_rows;
+  size_t i = 0;
+  while (i < count) {
+    const size_t index = rows[i] / _chunkSize;
+    const size_t offset = index * _chunkSize;
+
+    local_rows.clear();
+    size_t run_end = i;
+    while (run_end < count && rows[run_end] / _chunkSize == index) {
+      local_rows.push_back(rows[run_end] - offset);
+      ++run_end;
+    }
+
+    _chunks[index]->gatherValueIds(column, local_rows.data(), local_rows.size(), value_ids + i);
+    toSharedValueIds(index, column, value_ids + i, run_end - i);
+    i = run_end;
+  }
+}
+
+// A sealed chunk is encoded with the shared dictionaries before it is
+// written
+void ChunkedTable::setValueId(const size_t column, const size_t row, const ValueId valueId) {
+  const size_t index = row / _chunkSize;
+  if (!_sharedIds[index].empty())
+    unseal(index);
+  _chunks[index]->setValueId(column, row % _chunkSize, valueId);
+}
+
+// Chunks are allocated at their full size, there is nothing to reserve
+void ChunkedTable::reserve(const size_t nr_of_values) {
+}
+
+// Fills up the last chunk and appends new chunks, existing rows stay
+// where they are
+void ChunkedTable::resize(const size_t rows) {
+  if (rows < _size)
+    throw std::runtime_error("Chunked tables can't shrink");
+
+  const size_t chunks = (rows + _chunkSize - 1) / _chunkSize;
+  while (_chunks.size() < chunks) {
+    if (!_chunks.empty())
+      _chunks.back()->resize(_chunkSize);
+    _chunks.push_back(newChunk());
+    _zoneMaps.push_back(nullptr);
+    _sharedIds.push_back({});
+  }
+  if (!_chunks.empty())
+    _chunks.back()->resize(rows - (chunks - 1) * _chunkSize);
+  _size = rows;
+}
+
+unsigned ChunkedTable::sliceCount() const {
+  return firstChunk()->sliceCount();
+}
+
+void *ChunkedTable::atSlice(const size_t slice, const size_t row) const {
+  return _chunks[row / _chunkSize]->atSlice(slice, row % _chunkSize);
+}
+
+size_t ChunkedTable::getSliceWidth(const size_t slice) const {
+  return firstChunk()->getSliceWidth(slice);
+}
+
+size_t ChunkedTable::getSliceForColumn(const size_t column) const {
+  return firstChunk()->getSliceForColumn(column);
+}
+
+size_t ChunkedTable::getOffsetInSlice(const size_t column) const {
+  return firstChunk()->getOffsetInSlice(column);
+}
+
+hyrise::storage::atable_ptr_t ChunkedTable::copy() const {
+  std::vector<const ColumnMetadata *> metadata;
+  std::vector<SharedDictionaryPtr> dictionaries;
+  for (size_t column = 0; column < columnCount(); ++column) {
+    metadata.push_back(&_metadata[column]);
+    dictionaries.push_back(_dictionaries[column]->copy());
+  }
+
+  auto result = std::make_shared<ChunkedTable>(metadata, &dictionaries, _chunkSize);
+  result->resize(_size);
+
+  std::vector<ValueId> value_ids(_chunkSize);
+  for (size_t index = 0; index < _chunks.size(); ++index) {
+    const size_t rows = _chunks[index]->size();
+    for (size_t column = 0; column < columnCount(); ++column) {
+      _chunks[index]->getValueIds(column, 0, rows, value_ids.data());
+      for (size_t row = 0; row < rows; ++row)
+        result->_chunks[index]->setValueId(column, row, ValueId(sharedValueId(index, column, value_ids[row].valueId), 0));
+    }
+  }
+  return result;
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+/** @file ChunkedTable.h
+ *
+ * Contains the class definition of ChunkedTable.
+ * For any undocumented method see AbstractTable.
+ * @see AbstractTable
+ */
+#ifndef SRC_LIB_STORAGE_CHUNKEDTABLE_H_
+#define SRC_LIB_STORAGE_CHUNKEDTABLE_H_
+
+#include <memory>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractTable.h"
+#include "storage/ColumnMetadata.h"
+#include "storage/Table.h"
+#include "taskscheduler/MorselTask.h"
+
+class ZoneMap;
+
+// Rows per chunk, matches the default morsel size so that parallel
+// operators process whole chunks
+#define CHUNK_SIZE DEFAULT_MORSEL_SIZE
+
+/**
+ * ChunkedTable stores its rows in horizontal chunks of a fixed number of
+ * rows. Every chunk is a Table with its own attribute vector. Chunks
+ * that are written insert into dictionaries shared by all of them.
+ *
+ * Growing the table adds chunks and never copies existing rows. Full
+ * chunks can be sealed, which re-encodes each of their columns with an
+ * order preserving dictionary of the values in the chunk, summarizes them
+ * in a zone map and run length encodes their columns where that is
+ * smaller. Scans split their input along the chunks and match sealed
+ * chunks by value id ranges of their own dictionaries, pruned by the
+ * zone maps, for equality and range predicates alike. Writing to a sealed
+ * chunk encodes it with the shared dictionaries again.
+ *
+ * The value ids the table returns and takes always belong to the shared
+ * dictionaries, those of sealed chunks are translated.
+ */
+class ChunkedTable : public AbstractTable {
+public:
+  typedef Table<> chunk_t;
+
+  explicit ChunkedTable(const std::vector<const ColumnMetadata *> &metadata,
+                        const std::vector<SharedDictionaryPtr> *dictionaries = nullptr,
+                        size_t chunkSize = CHUNK_SIZE);
+
+  virtual ~ChunkedTable();
+
+  /// Copies the rows of table into a new chunked table and seals its
+  /// full chunks
+  static std::shared_ptr<ChunkedTable> fromTable(const hyrise::storage::c_atable_ptr_t &table, size_t chunkSize = CHUNK_SIZE);
+
+  size_t chunkSize() const {
+    return _chunkSize;
+  }
+
+  size_t chunkCount() const {
+    return _chunks.size();
+  }
+
+  const std::shared_ptr<chunk_t> &chunk(size_t index) const {
+    return _chunks[index];
+  }
+
+  /// Returns the chunks and the zone map of each chunk, nullptr if the
+  /// chunk was not sealed or modified afterwards. Sealed chunks use
+  /// their own dictionaries.
+  std::vector<hyrise::storage::atable_ptr_t> getChunks(std::vector<std::shared_ptr<const ZoneMap>> &zone_maps) const;
+
+  /// Seals every full chunk that is not sealed yet, returns the number
+  /// of chunks sealed
+  size_t seal();
+
+  /// Morsel size to split table into, the chunk size for chunked tables
+  static size_t morselSizeFor(const hyrise::storage::c_atable_ptr_t &table);
+
+  const ColumnMetadata *metadataAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0) const;
+
+  SharedDictionaryPtr dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
+
+  SharedDictionaryPtr dictionaryByTableId(const size_t column, const table_id_t table_id) const;
+
+  void setDictionaryAt(SharedDictionaryPtr dict, const size_t column, const size_t row = 0, const table_id_t table_id = 0);
+
+  size_t size() const;
+
+  size_t columnCount() const;
+
+  ValueId getValueId(const size_t column, const size_t row) const;
+
+  void getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const;
+
+  void gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const;
+
+  void setValueId(const size_t column, const size_t row, const ValueId valueId);
+
+  void reserve(const size_t nr_of_values);
+
+  void resize(const size_t rows);
+
+  unsigned sliceCount() const;
+
+  void *atSlice(const size_t slice, const size_t row) const;
+
+  size_t getSliceWidth(const size_t slice) const;
+
+  size_t getSliceForColumn(const size_t column) const;
+
+  size_t getOffsetInSlice(const size_t column) const;
+
+  table_id_t subtableCount() const {
+    return 1;
+  }
+
+  hyrise::storage::atable_ptr_t copy() const;
+
+private:
+  std::shared_ptr<chunk_t> newChunk() const;
+
+  const std::shared_ptr<chunk_t> &firstChunk() const;
+
+  // Id in the shared dictionary of value_id of chunk index
+  value_id_t sharedValueId(size_t index, size_t column, value_id_t value_id) const {
+    return _sharedIds[index].empty() ? value_id : _sharedIds[index][column][value_id];
+  }
+
+  // Translates count value ids of chunk index to the shared dictionary
+  void toSharedValueIds(size_t index, size_t column, ValueId *value_ids, size_t count) const;
+
+  // Encodes the sealed chunk index with the shared dictionaries again
+  void unseal(size_t index);
+
+  std::vector<ColumnMetadata> _metadata;
+  std::vector<SharedDictionaryPtr> _dictionaries;
+  const size_t _chunkSize;
+  std::vector<std::shared_ptr<chunk_t>> _chunks;
+  std::vector<std::shared_ptr<const ZoneMap>> _zoneMaps;
+  // Id in the shared dictionary of every value id of each column of a
+  // sealed chunk, empty for chunks that are not sealed
+  std::vector<std::vector<std::vector<value_id_t>>> _sharedIds;
+  size_t _size;
+};
+
+#endif  // SRC_LIB_STORAGE_CHUNKEDTABLE_H_
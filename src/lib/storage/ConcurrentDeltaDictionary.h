@@ -0,0 +1,202 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_CONCURRENTDELTADICTIONARY_H_
+#define SRC_LIB_STORAGE_CONCURRENTDELTADICTIONARY_H_
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <storage/storage_types.h>
+#include <storage/AbstractDictionary.h>
+#include <storage/BaseDictionary.h>
+#include <storage/BaseIterator.h>
+#include <storage/DictionaryIterator.h>
+#include <storage/AbstractAllocatedDictionary.h>
+#include <storage/csb_index.h>
+
+template <typename T>
+class ConcurrentDeltaDictionaryIterator : public BaseIterator<T> {
+public:
+  typedef typename hyrise::index::CSBIndex<T, value_id_t>::iterator iterator_t;
+  iterator_t _it;
+
+  explicit ConcurrentDeltaDictionaryIterator(iterator_t it): _it(it) {}
+
+  void increment() {
+    ++_it;
+  }
+
+  bool equal(BaseIterator<T> *other) const {
+    return _it == ((ConcurrentDeltaDictionaryIterator<T> *) other)->_it;
+  }
+
+  T &dereference() const {
+    return const_cast<T &>(_it.key());
+  }
+
+  value_id_t getValueId() const {
+    return _it.value();
+  }
+
+  virtual BaseIterator<T> *clone() {
+    return new ConcurrentDeltaDictionaryIterator<T>(*this);
+  }
+};
+
+/*
+  Order indifferent dictionary for deltas that can be written by several
+  threads at once. Value ids are handed out in insertion order, a CSB+
+  tree over the values finds the value id of a value and iterates the
+  values in order for the merge.
+
+  Lookups and inserts of values that already exist only take a shared
+  lock, so writers only serialize on new values. Values are kept in
+  chunks that never move, reading the value of a value id needs no lock.
+  Iterating is not synchronized with inserts, the merge iterates frozen
+  deltas only.
+*/
+template < typename T,
+         class Strategy = MallocStrategy,
+         template <typename K, typename S> class Allocator = StrategizedAllocator
+         >
+class ConcurrentDeltaDictionary : public BaseAllocatedDictionary < T,
+  Strategy,
+  Allocator,
+    ConcurrentDeltaDictionary<T, Strategy, Allocator> > {
+
+  typedef hyrise::index::CSBIndex<T, value_id_t> index_type;
+
+  // chunk i holds first_chunk_size << i values
+  static const size_t first_chunk_bits = 10;
+  static const size_t first_chunk_size = 1 << first_chunk_bits;
+  static const size_t max_chunks = 64 - first_chunk_bits;
+
+  index_type _index;
+  mutable boost::shared_mutex _mutex;
+
+  std::unique_ptr<T[]> _chunks[max_chunks];
+  std::atomic<size_t> _size;
+
+  static size_t chunkOf(size_t value_id, size_t &offset) {
+    const size_t position = value_id + first_chunk_size;
+    const size_t chunk = 63 - __builtin_clzll(position) - first_chunk_bits;
+    offset = position - (first_chunk_size << chunk);
+    return chunk;
+  }
+
+public:
+
+  explicit ConcurrentDeltaDictionary(size_t s = 0) : _size(0) {
+  }
+
+  virtual ~ConcurrentDeltaDictionary() {
+  }
+
+  void shrink() {
+  }
+
+  bool isOrdered() {
+    return false;
+  }
+
+  size_t size() {
+    return _size.load(std::memory_order_acquire);
+  }
+
+  std::shared_ptr<AbstractDictionary> copy() {
+    auto result = std::make_shared<ConcurrentDeltaDictionary<T, Strategy, Allocator>>();
+    const size_t values = size();
+    for (size_t value_id = 0; value_id < values; ++value_id)
+      result->addValue(getValueForValueId(value_id));
+    return result;
+  }
+
+  void reserve(size_t s) {
+  }
+
+  virtual T getValueForValueId(value_id_t value_id) {
+    size_t offset;
+    const size_t chunk = chunkOf(value_id, offset);
+    return _chunks[chunk][offset];
+  }
+
+  /*
+    Returns the value id of value, values that are not in the dictionary
+    yet are appended. Several threads may add the same value at once,
+    they all get the same value id.
+   */
+  virtual value_id_t addValue(T value) {
+    {
+      boost::shared_lock<boost::shared_mutex> lock(_mutex);
+      const value_id_t *existing = _index.find(value);
+      if (existing)
+        return *existing;
+    }
+
+    boost::unique_lock<boost::shared_mutex> lock(_mutex);
+    const value_id_t *existing = _index.find(value);
+    if (existing)
+      return *existing;
+
+    const size_t value_id = _size.load(std::memory_order_relaxed);
+    size_t offset;
+    const size_t chunk = chunkOf(value_id, offset);
+    if (!_chunks[chunk])
+      _chunks[chunk].reset(new T[first_chunk_size << chunk]);
+    _chunks[chunk][offset] = value;
+    _index.insert(value, value_id);
+    _size.store(value_id + 1, std::memory_order_release);
+    return value_id;
+  }
+
+  virtual bool isValueIdValid(value_id_t value_id) {
+    return value_id < size();
+  }
+
+  virtual bool valueExists(const T &v) const {
+    boost::shared_lock<boost::shared_mutex> lock(_mutex);
+    return _index.find(v) != nullptr;
+  }
+
+  virtual value_id_t getValueIdForValue(const T &value) const {
+    boost::shared_lock<boost::shared_mutex> lock(_mutex);
+    const value_id_t *value_id = _index.find(value);
+    if (value_id)
+      return *value_id;
+
+    throw std::runtime_error("Value not found");
+  }
+
+  value_id_t getValueIdForValueSmaller(T other) {
+    throw std::runtime_error("This cannot be called since value ids have no ordered meaning");
+  }
+
+  value_id_t getValueIdForValueGreater(T other) {
+    throw std::runtime_error("This cannot be called since value ids have no ordered meaning");
+  }
+
+  const T getSmallestValue() {
+    throw std::runtime_error("This cannot be called in an unordered dictionary");
+  }
+
+  const T getGreatestValue() {
+    throw std::runtime_error("This cannot be called in an unordered dictionary");
+  }
+
+  typedef DictionaryIterator<T> iterator;
+
+  // returns an iterator over the values in ascending order
+  iterator begin() {
+    return iterator(new ConcurrentDeltaDictionaryIterator<T>(_index.begin()));
+  }
+
+  // returns an empty iterator that marks the end of the tree
+  iterator end() {
+    return iterator(new ConcurrentDeltaDictionaryIterator<T>(_index.end()));
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_CONCURRENTDELTADICTIONARY_H_
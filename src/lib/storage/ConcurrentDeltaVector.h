@@ -0,0 +1,164 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_CONCURRENTDELTAVECTOR_H_
+#define SRC_LIB_STORAGE_CONCURRENTDELTAVECTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include <storage/BaseAttributeVector.h>
+#include <storage/scan_kernels.h>
+
+/*
+  Uncompressed attribute vector for deltas that grow while other threads
+  read them. Rows are kept in chunks that never move, chunk i holds
+  first_chunk_rows << i rows, so growing the vector leaves the rows
+  readers already see in place. Readers only read the rows below a size
+  they observed; writers that grow the vector are serialized, e.g. by
+  the delta lock of a store.
+*/
+template <typename T>
+class ConcurrentDeltaVector : public BaseAttributeVector<T> {
+  static const size_t first_chunk_bits = 10;
+  static const size_t first_chunk_rows = 1 << first_chunk_bits;
+  static const size_t max_chunks = 64 - first_chunk_bits;
+
+  const size_t _columns;
+  std::unique_ptr<T[]> _chunks[max_chunks];
+  std::atomic<size_t> _rows;
+  // rows the allocated chunks hold, always the end of a chunk
+  size_t _capacity;
+
+  std::mutex _allocate_mtx;
+
+  static size_t chunkOf(size_t row, size_t &offset) {
+    const size_t position = row + first_chunk_rows;
+    const size_t chunk = 63 - __builtin_clzll(position) - first_chunk_bits;
+    offset = position - (first_chunk_rows << chunk);
+    return chunk;
+  }
+
+  inline T *at(size_t column, size_t row) const {
+    size_t offset;
+    const size_t chunk = chunkOf(row, offset);
+    return _chunks[chunk].get() + offset * _columns + column;
+  }
+
+public:
+  typedef T value_type;
+
+  ConcurrentDeltaVector(size_t columns, size_t rows) : _columns(columns), _rows(0), _capacity(0) {
+    reserve(rows);
+  }
+
+  virtual ~ConcurrentDeltaVector() {
+  }
+
+  // rows are not stored contiguously, use rowData() instead
+  void *data() {
+    throw std::runtime_error("ConcurrentDeltaVector does not store its rows contiguously");
+  }
+
+  T *rowData(size_t row, size_t columns) {
+    return at(0, row);
+  }
+
+  void setNumRows(size_t s) {
+    _rows.store(s, std::memory_order_release);
+  }
+
+  inline T get(size_t column, size_t row) const {
+    return *at(column, row);
+  }
+
+  inline void set(size_t column, size_t row, T value) {
+    *at(column, row) = value;
+  }
+
+  void reserve(size_t rows) {
+    std::lock_guard<std::mutex> guard(_allocate_mtx);
+    while (_capacity < rows) {
+      size_t offset;
+      const size_t chunk = chunkOf(_capacity, offset);
+      _chunks[chunk].reset(new T[(first_chunk_rows << chunk) * _columns]());
+      _capacity += first_chunk_rows << chunk;
+    }
+  }
+
+  // the chunks of new rows are allocated before the rows are published
+  void resize(size_t rows) {
+    reserve(rows);
+    _rows.store(rows, std::memory_order_release);
+  }
+
+  uint64_t capacity() {
+    return _capacity;
+  }
+
+  // must not run concurrently with readers
+  void clear() {
+    std::lock_guard<std::mutex> guard(_allocate_mtx);
+    for (auto &chunk : _chunks)
+      chunk.reset();
+    _capacity = 0;
+    _rows.store(0, std::memory_order_release);
+  }
+
+  size_t size() {
+    return _rows.load(std::memory_order_acquire);
+  }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() {
+    const size_t rows = size();
+    auto result = std::make_shared<ConcurrentDeltaVector<T>>(_columns, rows);
+    result->resize(rows);
+    for (size_t row = 0; row < rows;) {
+      size_t offset;
+      const size_t chunk = chunkOf(row, offset);
+      const size_t count = std::min(rows - row, (first_chunk_rows << chunk) - offset);
+      std::copy(at(0, row), at(0, row) + count * _columns, result->at(0, row));
+      row += count;
+    }
+    return result;
+  }
+
+  void rewriteColumn(const size_t column, const size_t bits) {}
+
+  void decode(size_t column, size_t start, size_t stop, T *values) const {
+    for (size_t row = start; row < stop;) {
+      size_t offset;
+      const size_t chunk = chunkOf(row, offset);
+      const size_t count = std::min(stop - row, (first_chunk_rows << chunk) - offset);
+      const T *source = at(column, row);
+      for (size_t i = 0; i < count; ++i) {
+        values[row - start + i] = source[i * _columns];
+      }
+      row += count;
+    }
+  }
+
+  // Single column chunks are compared in place with the SIMD range kernel
+  void scanRange(size_t column, size_t start, size_t stop, T low, T high, pos_list_t &positions, size_t offset = 0) const {
+    for (size_t row = start; row < stop;) {
+      size_t in_chunk;
+      const size_t chunk = chunkOf(row, in_chunk);
+      const size_t count = std::min(stop - row, (first_chunk_rows << chunk) - in_chunk);
+      const T *source = at(column, row);
+      if (_columns == 1 && sizeof(T) == sizeof(uint32_t)) {
+        hyrise::storage::appendPositionsInRange(reinterpret_cast<const uint32_t *>(source), count,
+                                                low, high, positions, offset + row);
+      } else {
+        for (size_t i = 0; i < count; ++i) {
+          if (source[i * _columns] >= low && source[i * _columns] <= high) {
+            positions.push_back(offset + row + i);
+          }
+        }
+      }
+      row += count;
+    }
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_CONCURRENTDELTAVECTOR_H_
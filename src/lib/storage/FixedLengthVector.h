@@ -2,6 +2,7 @@
 #ifndef SRC_LIB_STORAGE_FIXEDLENGTHVECTOR_H_
 #define SRC_LIB_STORAGE_FIXEDLENGTHVECTOR_H_
 
+#include <algorithm>
 #include <atomic>
 #include <errno.h>
 #include <math.h>
@@ -17,6 +18,7 @@
 #include <storage/AbstractAttributeVector.h>
 #include <storage/BaseAttributeVector.h>
 #include <storage/BaseAllocatedAttributeVector.h>
+#include <storage/scan_kernels.h>
 #include <memory/StrategizedAllocator.h>
 #include <memory/MallocStrategy.h>
 
@@ -62,6 +64,37 @@ public:
 
   void reserve(size_t rows);
 
+  void decode(size_t column, size_t start, size_t stop, T *values) const {
+    if (_columns == 1) {
+      std::copy(_values + start, _values + stop, values);
+      return;
+    }
+    for (size_t row = start; row < stop; ++row) {
+      values[row - start] = _values[row * _columns + column];
+    }
+  }
+
+  void gather(size_t column, const pos_t *rows, size_t count, T *values) const {
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = _values[rows[i] * _columns + column];
+    }
+  }
+
+  // Single column vectors are compared in place with the SIMD range kernel
+  void scanRange(size_t column, size_t start, size_t stop, T low, T high, pos_list_t &positions, size_t offset = 0) const {
+    if (_columns == 1 && sizeof(T) == sizeof(uint32_t)) {
+      hyrise::storage::appendPositionsInRange(reinterpret_cast<const uint32_t *>(_values) + start, stop - start,
+                                              low, high, positions, offset + start);
+      return;
+    }
+    for (size_t row = start; row < stop; ++row) {
+      const T &value = _values[row * _columns + column];
+      if (value >= low && value <= high) {
+        positions.push_back(offset + row);
+      }
+    }
+  }
+
   void clear();
 
   size_t size();
@@ -0,0 +1,173 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_FRAMEOFREFERENCEDICTIONARY_H_
+#define SRC_LIB_STORAGE_FRAMEOFREFERENCEDICTIONARY_H_
+
+#include <stdexcept>
+#include <memory>
+
+#include <storage/storage_types.h>
+#include <storage/BaseDictionary.h>
+#include <storage/BaseIterator.h>
+#include <storage/DictionaryIterator.h>
+#include <storage/OrderPreservingDictionary.h>
+
+template <typename T>
+class FrameOfReferenceDictionaryIterator;
+
+/*
+  Dictionary of a dense integer range that stores no values: value id i
+  stands for the value base + i. Attribute vectors of such columns hold
+  the bit packed offsets of the values from the base, all lookups are
+  plain arithmetic instead of random accesses into a value array.
+
+  Values in the range that do not occur in the column still get a value
+  id, so the dictionary is only worth it where the range needs no more
+  bits than the distinct values, e.g. for surrogate keys. The merge picks
+  it for those integer columns, later merges take over only the values
+  that occur in the attribute vector.
+ */
+template <typename T>
+class FrameOfReferenceDictionary : public BaseDictionary<T> {
+  T _base;
+  size_t _size;
+
+public:
+  FrameOfReferenceDictionary() : _base(T()), _size(0) {
+  }
+
+  FrameOfReferenceDictionary(T base, size_t size) : _base(base), _size(size) {
+  }
+
+  virtual ~FrameOfReferenceDictionary() {
+  }
+
+  T base() const {
+    return _base;
+  }
+
+  /*
+    Appends value, values between the last and the new value are added
+    implicitly
+   */
+  value_id_t addValue(T value) {
+    if (_size == 0) {
+      _base = value;
+    } else if (value < _base + static_cast<T>(_size)) {
+      throw std::runtime_error("Can't insert value smaller than last value");
+    }
+    _size = value - _base + 1;
+    return _size - 1;
+  }
+
+  T getValueForValueId(value_id_t value_id) {
+    return _base + static_cast<T>(value_id);
+  }
+
+  value_id_t getValueIdForValue(const T &value) const {
+    if (value < _base)
+      return 0;
+    if (value >= _base + static_cast<T>(_size))
+      return _size;
+    return value - _base;
+  }
+
+  value_id_t getValueIdForValueSmaller(T other) {
+    return getValueIdForValue(other) - 1;
+  }
+
+  value_id_t getValueIdForValueGreater(T other) {
+    if (other < _base)
+      return 0;
+    if (other >= _base + static_cast<T>(_size))
+      return _size;
+    return other - _base + 1;
+  }
+
+  const T getSmallestValue() {
+    return _base;
+  }
+
+  const T getGreatestValue() {
+    return _base + static_cast<T>(_size) - 1;
+  }
+
+  bool isValueIdValid(value_id_t value_id) {
+    return value_id < _size;
+  }
+
+  bool valueExists(const T &value) const {
+    return value >= _base && value < _base + static_cast<T>(_size);
+  }
+
+  void reserve(size_t size) {
+  }
+
+  size_t size() {
+    return _size;
+  }
+
+  void shrink() {
+  }
+
+  std::shared_ptr<AbstractDictionary> copy() {
+    return std::make_shared<FrameOfReferenceDictionary<T>>(_base, _size);
+  }
+
+  // Deltas need arbitrary values, they start with a regular dictionary
+  std::shared_ptr<AbstractDictionary> copy_empty() {
+    return std::make_shared<OrderPreservingDictionary<T>>();
+  }
+
+  bool isOrdered() {
+    return true;
+  }
+
+  typedef DictionaryIterator<T> iterator;
+
+  iterator begin() {
+    return iterator(new FrameOfReferenceDictionaryIterator<T>(_base, 0));
+  }
+
+  iterator end() {
+    return iterator(new FrameOfReferenceDictionaryIterator<T>(_base, _size));
+  }
+};
+
+template <typename T>
+class FrameOfReferenceDictionaryIterator : public BaseIterator<T> {
+  T _base;
+  size_t _index;
+  // dereference hands out a reference, the value only exists here
+  mutable T _value;
+
+public:
+  FrameOfReferenceDictionaryIterator(T base, size_t index) : _base(base), _index(index), _value(base) {
+  }
+
+  virtual ~FrameOfReferenceDictionaryIterator() {
+  }
+
+  void increment() {
+    ++_index;
+  }
+
+  bool equal(BaseIterator<T> *other) const {
+    auto *it = (FrameOfReferenceDictionaryIterator<T> *) other;
+    return _base == it->_base && _index == it->_index;
+  }
+
+  T &dereference() const {
+    _value = _base + static_cast<T>(_index);
+    return _value;
+  }
+
+  value_id_t getValueId() const {
+    return _index;
+  }
+
+  virtual BaseIterator<T> *clone() {
+    return new FrameOfReferenceDictionaryIterator<T>(*this);
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_FRAMEOFREFERENCEDICTIONARY_H_
@@ -0,0 +1,227 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/FrontCodedDictionary.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/OrderPreservingDictionary.h"
+
+namespace {
+
+// Lengths are stored with 7 bits per byte, the high bit marks that
+// another byte follows, so short prefixes and suffixes take one byte
+void appendLength(std::vector<char> &data, size_t length) {
+  while (length >= 0x80) {
+    data.push_back(static_cast<char>((length & 0x7f) | 0x80));
+    length >>= 7;
+  }
+  data.push_back(static_cast<char>(length));
+}
+
+size_t readLength(const std::vector<char> &data, size_t &position) {
+  size_t length = 0;
+  for (size_t shift = 0;; shift += 7) {
+    const unsigned char byte = data[position++];
+    length |= static_cast<size_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return length;
+  }
+}
+
+}
+
+FrontCodedDictionary::FrontCodedDictionary() : _values(std::make_shared<values_t>()) {
+  _values->size = 0;
+}
+
+FrontCodedDictionary::FrontCodedDictionary(size_t size) : _values(std::make_shared<values_t>()) {
+  _values->size = 0;
+  reserve(size);
+}
+
+size_t FrontCodedDictionary::decode(const values_t &values, size_t position, hyrise_string_t &value) {
+  const size_t prefix = readLength(values.data, position);
+  const size_t suffix = readLength(values.data, position);
+  value.resize(prefix);
+  value.append(&values.data[position], suffix);
+  return position + suffix;
+}
+
+value_id_t FrontCodedDictionary::addValue(hyrise_string_t value) {
+  auto &values = *_values;
+  if (values.size > 0 && value <= values.last)
+    throw std::runtime_error("Can't insert value smaller than last value");
+
+  size_t prefix = 0;
+  if (values.size % FRONT_CODING_BLOCK_SIZE == 0) {
+    values.blocks.push_back(values.data.size());
+  } else {
+    const size_t length = std::min(value.size(), values.last.size());
+    while (prefix < length && value[prefix] == values.last[prefix])
+      ++prefix;
+  }
+
+  appendLength(values.data, prefix);
+  appendLength(values.data, value.size() - prefix);
+  values.data.insert(values.data.end(), value.begin() + prefix, value.end());
+  values.last = value;
+  return values.size++;
+}
+
+hyrise_string_t FrontCodedDictionary::getValueForValueId(value_id_t value_id) {
+#ifdef EXPENSIVE_ASSERTIONS
+  if (value_id >= _values->size)
+    throw std::runtime_error("Trying to access value_id larger than available values");
+#endif
+  hyrise_string_t value;
+  size_t position = _values->blocks[value_id / FRONT_CODING_BLOCK_SIZE];
+  for (size_t i = 0; i <= value_id % FRONT_CODING_BLOCK_SIZE; ++i)
+    position = decode(*_values, position, value);
+  return value;
+}
+
+value_id_t FrontCodedDictionary::bound(const hyrise_string_t &value, bool upper) const {
+  const auto &values = *_values;
+
+  // block heads are stored in full, compare them in place
+  auto head = [&values](size_t block, const hyrise_string_t &other) {
+    size_t position = values.blocks[block];
+    readLength(values.data, position);
+    const size_t length = readLength(values.data, position);
+    return other.compare(0, hyrise_string_t::npos, &values.data[position], length);
+  };
+
+  // first block whose head is greater than value, or not less for lower bounds
+  size_t low = 0, high = values.blocks.size();
+  while (low < high) {
+    const size_t middle = (low + high) / 2;
+    const int comparison = head(middle, value);
+    if (comparison > 0 || (upper && comparison == 0))
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == 0)
+    return 0;
+
+  // the bound is in the preceding block or is the head found
+  const size_t block = low - 1;
+  const size_t first = block * FRONT_CODING_BLOCK_SIZE;
+  const size_t last = std::min(values.size, first + FRONT_CODING_BLOCK_SIZE);
+  hyrise_string_t current;
+  size_t position = values.blocks[block];
+  for (size_t id = first; id < last; ++id) {
+    position = decode(values, position, current);
+    if (upper ? current > value : current >= value)
+      return id;
+  }
+  return last;
+}
+
+value_id_t FrontCodedDictionary::getValueIdForValue(const hyrise_string_t &value) const {
+  return bound(value, false);
+}
+
+value_id_t FrontCodedDictionary::getValueIdForValueSmaller(hyrise_string_t other) {
+  return bound(other, false) - 1;
+}
+
+value_id_t FrontCodedDictionary::getValueIdForValueGreater(hyrise_string_t other) {
+  return bound(other, true);
+}
+
+void FrontCodedDictionary::getValueIdRangeForPrefix(const hyrise_string_t &prefix, value_id_t &low, value_id_t &high) const {
+  low = bound(prefix, false);
+
+  // the values starting with prefix end before its successor
+  hyrise_string_t successor = prefix;
+  while (!successor.empty() && static_cast<unsigned char>(successor.back()) == 0xff)
+    successor.erase(successor.size() - 1);
+  if (successor.empty()) {
+    high = _values->size;
+    return;
+  }
+  successor.back() = static_cast<char>(static_cast<unsigned char>(successor.back()) + 1);
+  high = bound(successor, false);
+}
+
+const hyrise_string_t FrontCodedDictionary::getSmallestValue() {
+  return getValueForValueId(0);
+}
+
+const hyrise_string_t FrontCodedDictionary::getGreatestValue() {
+  return _values->last;
+}
+
+bool FrontCodedDictionary::isValueIdValid(value_id_t value_id) {
+  return value_id < _values->size;
+}
+
+bool FrontCodedDictionary::valueExists(const hyrise_string_t &value) const {
+  const value_id_t id = bound(value, false);
+  return id < _values->size && const_cast<FrontCodedDictionary *>(this)->getValueForValueId(id) == value;
+}
+
+void FrontCodedDictionary::reserve(size_t size) {
+  _values->blocks.reserve(size / FRONT_CODING_BLOCK_SIZE + 1);
+}
+
+size_t FrontCodedDictionary::size() {
+  return _values->size;
+}
+
+void FrontCodedDictionary::shrink() {
+  _values->data.shrink_to_fit();
+  _values->blocks.shrink_to_fit();
+}
+
+size_t FrontCodedDictionary::encodedSize() const {
+  return _values->data.size() + _values->blocks.size() * sizeof(size_t);
+}
+
+std::shared_ptr<AbstractDictionary> FrontCodedDictionary::copy() {
+  auto result = std::make_shared<FrontCodedDictionary>();
+  *result->_values = *_values;
+  return result;
+}
+
+// Deltas need arbitrary inserts, they start with a regular dictionary
+std::shared_ptr<AbstractDictionary> FrontCodedDictionary::copy_empty() {
+  return std::make_shared<OrderPreservingDictionary<hyrise_string_t>>();
+}
+
+bool FrontCodedDictionary::isOrdered() {
+  return true;
+}
+
+FrontCodedDictionary::iterator FrontCodedDictionary::begin() {
+  return iterator(new FrontCodedDictionaryIterator(_values, 0));
+}
+
+FrontCodedDictionary::iterator FrontCodedDictionary::end() {
+  return iterator(new FrontCodedDictionaryIterator(_values, _values->size));
+}
+
+FrontCodedDictionaryIterator::FrontCodedDictionaryIterator(std::shared_ptr<FrontCodedDictionary::values_t> values, size_t index)
+  : _values(values), _index(index), _position(0) {
+  if (_index >= _values->size)
+    return;
+
+  _position = _values->blocks[_index / FRONT_CODING_BLOCK_SIZE];
+  for (size_t i = 0; i <= _index % FRONT_CODING_BLOCK_SIZE; ++i)
+    _position = FrontCodedDictionary::decode(*_values, _position, _value);
+}
+
+void FrontCodedDictionaryIterator::increment() {
+  if (++_index < _values->size)
+    _position = FrontCodedDictionary::decode(*_values, _position, _value);
+}
+
+bool FrontCodedDictionaryIterator::equal(BaseIterator<hyrise_string_t> *other) const {
+  auto *it = (FrontCodedDictionaryIterator *) other;
+  return _values.get() == it->_values.get() && _index == it->_index;
+}
+
+hyrise_string_t &FrontCodedDictionaryIterator::dereference() const {
+  return _value;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_FRONTCODEDDICTIONARY_H_
+#define SRC_LIB_STORAGE_FRONTCODEDDICTIONARY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <storage/storage_types.h>
+#include <storage/BaseDictionary.h>
+#include <storage/BaseIterator.h>
+#include <storage/DictionaryIterator.h>
+
+// Values per block, only the first value of a block is stored in full
+#define FRONT_CODING_BLOCK_SIZE 16
+
+class FrontCodedDictionaryIterator;
+
+/*
+  Order preserving string dictionary for main tables that keeps all
+  values in one contiguous buffer. Values are grouped into blocks of
+  FRONT_CODING_BLOCK_SIZE, every value is stored as the length of the
+  prefix it shares with its predecessor in the block followed by the
+  remaining suffix. The offsets of the block heads form a sampled index
+  that is binary searched, the values of one block are decoded
+  sequentially.
+
+  Values can only be appended in ascending order, as done by the merge.
+ */
+class FrontCodedDictionary : public BaseDictionary<hyrise_string_t> {
+public:
+  struct values_t {
+    std::vector<char> data;
+    // offset of the first value of each block in data
+    std::vector<size_t> blocks;
+    size_t size;
+    // last value appended, values are front coded against it
+    hyrise_string_t last;
+  };
+
+private:
+  std::shared_ptr<values_t> _values;
+
+  /// Value id of the first value >= value, or > value if upper is set
+  value_id_t bound(const hyrise_string_t &value, bool upper) const;
+
+public:
+  FrontCodedDictionary();
+  explicit FrontCodedDictionary(size_t size);
+
+  virtual ~FrontCodedDictionary() {
+  }
+
+  value_id_t addValue(hyrise_string_t value);
+
+  hyrise_string_t getValueForValueId(value_id_t value_id);
+  value_id_t getValueIdForValue(const hyrise_string_t &value) const;
+
+  value_id_t getValueIdForValueSmaller(hyrise_string_t other);
+  value_id_t getValueIdForValueGreater(hyrise_string_t other);
+
+  /// Sets [low, high) to the value ids of the values that start with prefix
+  void getValueIdRangeForPrefix(const hyrise_string_t &prefix, value_id_t &low, value_id_t &high) const;
+
+  const hyrise_string_t getSmallestValue();
+  const hyrise_string_t getGreatestValue();
+
+  bool isValueIdValid(value_id_t value_id);
+
+  bool valueExists(const hyrise_string_t &value) const;
+
+  void reserve(size_t size);
+  size_t size();
+  void shrink();
+
+  /// Bytes of the encoded values and the block index
+  size_t encodedSize() const;
+
+  std::shared_ptr<AbstractDictionary> copy();
+  std::shared_ptr<AbstractDictionary> copy_empty();
+
+  bool isOrdered();
+
+  typedef DictionaryIterator<hyrise_string_t> iterator;
+
+  iterator begin();
+  iterator end();
+
+  /// Decodes the value at position in data into value, which holds the
+  /// previous value of the block, returns the position of the next value
+  static size_t decode(const values_t &values, size_t position, hyrise_string_t &value);
+};
+
+class FrontCodedDictionaryIterator : public BaseIterator<hyrise_string_t> {
+  std::shared_ptr<FrontCodedDictionary::values_t> _values;
+  size_t _index;
+  // position of the next value in the buffer
+  size_t _position;
+  // dereference hands out a reference to the decoded value
+  mutable hyrise_string_t _value;
+
+public:
+  FrontCodedDictionaryIterator(std::shared_ptr<FrontCodedDictionary::values_t> values, size_t index);
+
+  virtual ~FrontCodedDictionaryIterator() {
+  }
+
+  void increment();
+
+  bool equal(BaseIterator<hyrise_string_t> *other) const;
+
+  hyrise_string_t &dereference() const;
+
+  value_id_t getValueId() const {
+    return _index;
+  }
+
+  virtual BaseIterator<hyrise_string_t> *clone() {
+    return new FrontCodedDictionaryIterator(*this);
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_FRONTCODEDDICTIONARY_H_
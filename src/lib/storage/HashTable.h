@@ -2,6 +2,7 @@
 #ifndef SRC_LIB_STORAGE_HASHTABLE_H_
 #define SRC_LIB_STORAGE_HASHTABLE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <set>
 #include <unordered_map>
@@ -13,6 +14,7 @@
 #include "storage/AbstractHashTable.h"
 #include "storage/AbstractTable.h"
 #include "storage/meta_storage.h"
+#include "storage/OpenAddressingMultimap.h"
 #include "storage/hash_functor.h"
 #include "storage/storage_types.h"
 
@@ -103,6 +105,23 @@ public:
       key.push_back(extract<T>(table, columns[i], value_list[i]));
     return key;
   }
+
+  // Builds the keys of the rows [start, stop) column by column from
+  // batch-decoded value ids
+  static void getGroupKeys(const hyrise::storage::c_atable_ptr_t &table,
+                           const field_list_t &columns,
+                           const size_t fieldCount,
+                           const pos_t start,
+                           const pos_t stop,
+                           ValueIdList &value_ids,
+                           std::vector<T> &keys) {
+    keys.assign(stop - start, T());
+    for (size_t i = 0; i < fieldCount; i++) {
+      table->getValueIds(columns[i], start, stop, value_ids.data());
+      for (size_t row = 0; row < stop - start; ++row)
+        keys[row].push_back(extract<T>(table, columns[i], value_ids[row]));
+    }
+  }
 };
 
 // Simple Hash Function for single values
@@ -120,15 +139,43 @@ public:
                        const pos_t row){
     return extractSingle<T>(table, columns[0], table->getValueId(columns[0], row));
   }
+
+  static void getGroupKeys(const hyrise::storage::c_atable_ptr_t &table,
+                           const field_list_t &columns,
+                           const size_t fieldCount,
+                           const pos_t start,
+                           const pos_t stop,
+                           ValueIdList &value_ids,
+                           std::vector<T> &keys) {
+    keys.resize(stop - start);
+    table->getValueIds(columns[0], start, stop, value_ids.data());
+    for (size_t row = 0; row < stop - start; ++row)
+      keys[row] = extractSingle<T>(table, columns[0], value_ids[row]);
+  }
 };
 
 // Multi Keys
-typedef std::unordered_multimap<aggregate_key_t, pos_t, GroupKeyHash<aggregate_key_t> > aggregate_hash_map_t;
-typedef std::unordered_multimap<join_key_t, pos_t, GroupKeyHash<join_key_t> > join_hash_map_t;
+typedef OpenAddressingMultimap<aggregate_key_t, GroupKeyHash<aggregate_key_t> > aggregate_hash_map_t;
+typedef OpenAddressingMultimap<join_key_t, GroupKeyHash<join_key_t> > join_hash_map_t;
 
 // Single Keys
-typedef std::unordered_multimap<aggregate_single_key_t, pos_t, SingleGroupKeyHash<aggregate_single_key_t> > aggregate_single_hash_map_t;
-typedef std::unordered_multimap<join_single_key_t, pos_t, SingleGroupKeyHash<join_single_key_t> > join_single_hash_map_t;
+typedef OpenAddressingMultimap<aggregate_single_key_t, SingleGroupKeyHash<aggregate_single_key_t> > aggregate_single_hash_map_t;
+typedef OpenAddressingMultimap<join_single_key_t, SingleGroupKeyHash<join_single_key_t> > join_single_hash_map_t;
+
+// Node based maps, only kept to compare against the open addressing maps
+typedef std::unordered_multimap<aggregate_key_t, pos_t, GroupKeyHash<aggregate_key_t> > aggregate_node_hash_map_t;
+typedef std::unordered_multimap<join_key_t, pos_t, GroupKeyHash<join_key_t> > join_node_hash_map_t;
+typedef std::unordered_multimap<aggregate_single_key_t, pos_t, SingleGroupKeyHash<aggregate_single_key_t> > aggregate_single_node_hash_map_t;
+typedef std::unordered_multimap<join_single_key_t, pos_t, SingleGroupKeyHash<join_single_key_t> > join_single_node_hash_map_t;
+
+// Open addressing maps need to group their entries once all are inserted
+template <class MAP>
+inline void finalizeMap(MAP &map) {}
+
+template <class KEY, class HASH>
+inline void finalizeMap(OpenAddressingMultimap<KEY, HASH> &map) {
+  map.finalize();
+}
 
 /// HashTable based on a map; key specifies the key for the given map
 template<class MAP, class KEY> class HashTable;
@@ -139,6 +186,12 @@ typedef HashTable<join_hash_map_t, join_key_t> JoinHashTable;
 typedef HashTable<aggregate_single_hash_map_t, aggregate_single_key_t> SingleAggregateHashTable;
 typedef HashTable<join_single_hash_map_t, join_single_key_t> SingleJoinHashTable;
 
+// HashTables on node based maps
+typedef HashTable<aggregate_node_hash_map_t, aggregate_key_t> NodeAggregateHashTable;
+typedef HashTable<join_node_hash_map_t, join_key_t> NodeJoinHashTable;
+typedef HashTable<aggregate_single_node_hash_map_t, aggregate_single_key_t> NodeSingleAggregateHashTable;
+typedef HashTable<join_single_node_hash_map_t, join_single_key_t> NodeSingleJoinHashTable;
+
 /// Uses valueIds of specified columns as key for an unordered_multimap
 template <class MAP, class KEY>
 class HashTable : public AbstractHashTable, public std::enable_shared_from_this<HashTable<MAP, KEY> > {
@@ -170,10 +223,16 @@ private:
     _dirty = true;
     size_t fieldSize = _fields.size();
     size_t tableSize = _table->size();
-    for (pos_t row = 0; row < tableSize; ++row) {
-      key_t key = MAP::hasher::getGroupKey(_table, _fields, fieldSize, row);
-      _map.insert(typename map_t::value_type(key, row + row_offset));
+    ValueIdList value_ids(VALUE_ID_BATCH_SIZE);
+    std::vector<key_t> keys;
+    for (pos_t start = 0; start < tableSize; start += VALUE_ID_BATCH_SIZE) {
+      pos_t stop = std::min<pos_t>(start + VALUE_ID_BATCH_SIZE, tableSize);
+      MAP::hasher::getGroupKeys(_table, _fields, fieldSize, start, stop, value_ids, keys);
+      for (pos_t row = start; row < stop; ++row) {
+        _map.insert(typename map_t::value_type(keys[row - start], row + row_offset));
+      }
     }
+    finalizeMap(_map);
   }
 
   pos_list_t constructPositions(const map_const_range_t &range) const {
@@ -181,11 +240,9 @@ private:
   }
 
   pos_list_t constructPositions(const map_const_iterator_t &begin,  const map_const_iterator_t &end) const {
-    pos_list_t positions(std::distance(begin, end));
-    // decltype(*range.first) returns the type of iterator elements
-    std::transform(begin, end, positions.begin(), [&](decltype(*begin)& value) {
-      return value.second;
-    });
+    pos_list_t positions;
+    for (map_const_iterator_t it = begin; it != end; ++it)
+      positions.push_back(it->second);
     return positions;
   }
 
@@ -199,6 +256,7 @@ public:
       const auto& ht = checked_pointer_cast<const HashTable<MAP, KEY>>(nextElement);
       _map.insert(ht->getMapBegin(), ht->getMapEnd());
     }
+    finalizeMap(_map);
   }
 
   // Hash given table's columns directly into the new HashTable
@@ -237,6 +295,13 @@ public:
     return constructPositions(range);
   }
 
+  virtual bool contains(const hyrise::storage::c_atable_ptr_t &table,
+                        const field_list_t &columns,
+                        const pos_t row) const {
+    const auto range = _map.equal_range(MAP::hasher::getGroupKey(table, columns, columns.size(), row));
+    return range.first != range.second;
+  }
+
   /// Get const interators to underlying map's begin or end.
   map_const_iterator_t getMapBegin() const {
     return _map.begin();
@@ -357,6 +422,18 @@ public:
     return pos_list;
   }
 
+  virtual bool contains(
+    const hyrise::storage::c_atable_ptr_t &table,
+    const field_list_t &columns,
+    const pos_t row) const {
+    key_t key = MAP::hasher::getGroupKey(table, columns, columns.size(), row);
+    for (typename hash_table_t::map_const_iterator_t it = _begin; it != _end; ++it) {
+      if (it->first == key)
+        return true;
+    }
+    return false;
+  }
+
   pos_list_t get(key_t key) const {
     pos_list_t pos_list;
 
@@ -0,0 +1,143 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/JoinFilter.h"
+
+#include <algorithm>
+
+#include "storage/AbstractDictionary.h"
+#include "storage/HashTable.h"
+
+namespace {
+
+// Bloom filter bits per build row and bits set per key
+const size_t BITS_PER_KEY = 16;
+const size_t HASHES_PER_KEY = 3;
+const size_t BITS_PER_BLOCK = 512;
+
+inline size_t mix(size_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+}
+
+// Hashes the join keys of rows the way JoinHashTable does
+size_t keyHash(const hyrise::storage::c_atable_ptr_t &table,
+               const field_list_t &fields,
+               const std::vector<ValueIdList> &valueIds,
+               const size_t i,
+               join_key_t &key) {
+  for (size_t f = 0; f < fields.size(); ++f)
+    key[f] = extract<join_key_t>(table, fields[f], valueIds[f][i]);
+  return GroupKeyHash<join_key_t>()(key);
+}
+
+}
+
+JoinFilter::JoinFilter(const hyrise::storage::c_atable_ptr_t &table, const field_list_t &fields) {
+  size_t blocks = 1;
+  while (blocks * BITS_PER_BLOCK < table->size() * BITS_PER_KEY)
+    blocks <<= 1;
+  _blocks.assign(blocks * WORDS_PER_BLOCK, 0);
+  _blockMask = blocks - 1;
+
+  std::vector<ValueIdList> valueIds(fields.size(), ValueIdList(VALUE_ID_BATCH_SIZE));
+  join_key_t key(fields.size());
+  DictionaryBitmap *bitmap = nullptr;
+  table_id_t bitmapTable = 0;
+
+  for (size_t start = 0; start < table->size(); start += VALUE_ID_BATCH_SIZE) {
+    const size_t stop = std::min<size_t>(start + VALUE_ID_BATCH_SIZE, table->size());
+    for (size_t f = 0; f < fields.size(); ++f)
+      table->getValueIds(fields[f], start, stop, valueIds[f].data());
+
+    for (size_t i = 0; i < stop - start; ++i) {
+      insert(keyHash(table, fields, valueIds, i, key));
+
+      if (fields.size() != 1)
+        continue;
+      const ValueId &vid = valueIds[0][i];
+      if (bitmap == nullptr || vid.table != bitmapTable) {
+        const auto &dictionary = table->dictionaryByTableId(fields[0], vid.table);
+        bitmap = nullptr;
+        for (auto &existing : _bitmaps) {
+          if (existing.dictionary == dictionary)
+            bitmap = &existing;
+        }
+        if (bitmap == nullptr) {
+          _bitmaps.push_back(DictionaryBitmap());
+          bitmap = &_bitmaps.back();
+          bitmap->dictionary = dictionary;
+        }
+        bitmapTable = vid.table;
+      }
+      if (vid.valueId >= bitmap->valueIds.size())
+        bitmap->valueIds.resize(std::max<size_t>(vid.valueId + 1, bitmap->dictionary->size()), false);
+      bitmap->valueIds[vid.valueId] = true;
+    }
+  }
+}
+
+void JoinFilter::insert(const size_t keyHash) {
+  const size_t h = mix(keyHash);
+  uint64_t *block = &_blocks[((h >> 32) & _blockMask) * WORDS_PER_BLOCK];
+  for (size_t i = 0; i < HASHES_PER_KEY; ++i) {
+    const size_t bit = (h >> (9 * i)) & (BITS_PER_BLOCK - 1);
+    block[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+}
+
+bool JoinFilter::mayContain(const size_t keyHash) const {
+  const size_t h = mix(keyHash);
+  const uint64_t *block = &_blocks[((h >> 32) & _blockMask) * WORDS_PER_BLOCK];
+  for (size_t i = 0; i < HASHES_PER_KEY; ++i) {
+    const size_t bit = (h >> (9 * i)) & (BITS_PER_BLOCK - 1);
+    if ((block[bit / 64] & (uint64_t(1) << (bit % 64))) == 0)
+      return false;
+  }
+  return true;
+}
+
+const JoinFilter::DictionaryBitmap *JoinFilter::bitmapFor(const AbstractTable::SharedDictionaryPtr &dictionary) const {
+  for (const auto &bitmap : _bitmaps) {
+    if (bitmap.dictionary == dictionary)
+      return &bitmap;
+  }
+  return nullptr;
+}
+
+void JoinFilter::filter(const hyrise::storage::c_atable_ptr_t &table, const field_list_t &fields, pos_list_t &positions) const {
+  std::vector<ValueIdList> valueIds(fields.size(), ValueIdList(VALUE_ID_BATCH_SIZE));
+  join_key_t key(fields.size());
+  const DictionaryBitmap *bitmap = nullptr;
+  table_id_t bitmapTable = 0;
+  bool bitmapLookedUp = false;
+
+  size_t kept = 0;
+  for (size_t start = 0; start < positions.size(); start += VALUE_ID_BATCH_SIZE) {
+    const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, positions.size() - start);
+    for (size_t f = 0; f < fields.size(); ++f)
+      table->gatherValueIds(fields[f], positions.data() + start, count, valueIds[f].data());
+
+    for (size_t i = 0; i < count; ++i) {
+      bool candidate;
+      if (fields.size() == 1 && !_bitmaps.empty()) {
+        const ValueId &vid = valueIds[0][i];
+        if (!bitmapLookedUp || vid.table != bitmapTable) {
+          bitmap = bitmapFor(table->dictionaryByTableId(fields[0], vid.table));
+          bitmapTable = vid.table;
+          bitmapLookedUp = true;
+        }
+        if (bitmap != nullptr)
+          candidate = vid.valueId < bitmap->valueIds.size() && bitmap->valueIds[vid.valueId];
+        else
+          candidate = mayContain(keyHash(table, fields, valueIds, i, key));
+      } else {
+        candidate = mayContain(keyHash(table, fields, valueIds, i, key));
+      }
+
+      if (candidate)
+        positions[kept++] = positions[start + i];
+    }
+  }
+  positions.resize(kept);
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_JOINFILTER_H_
+#define SRC_LIB_STORAGE_JOINFILTER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractTable.h"
+
+/**
+ * Compact summary of the join keys of a hash join's build input that
+ * scans on the probe input apply to skip rows without a join partner.
+ *
+ * Keys are summarized in a blocked Bloom filter over the same hashes the
+ * join hash tables use, one cache line per key. For single field keys,
+ * a value id bitmap is kept per build dictionary in addition; probe rows
+ * whose value ids belong to one of these dictionaries are filtered
+ * exactly and without decoding.
+ *
+ * The filter has no false negatives, rows it removes never join.
+ */
+class JoinFilter {
+public:
+  JoinFilter(const hyrise::storage::c_atable_ptr_t &table, const field_list_t &fields);
+
+  /// Removes all positions of table whose key in fields cannot occur in
+  /// the build input, keeps the order of the remaining positions
+  void filter(const hyrise::storage::c_atable_ptr_t &table, const field_list_t &fields, pos_list_t &positions) const;
+
+  /// false only if no build row has a key with this join key hash
+  bool mayContain(size_t keyHash) const;
+
+  size_t blockCount() const {
+    return _blocks.size() / WORDS_PER_BLOCK;
+  }
+
+private:
+  enum { WORDS_PER_BLOCK = 8 };
+
+  struct DictionaryBitmap {
+    AbstractTable::SharedDictionaryPtr dictionary;
+    std::vector<bool> valueIds;
+  };
+
+  void insert(size_t keyHash);
+  const DictionaryBitmap *bitmapFor(const AbstractTable::SharedDictionaryPtr &dictionary) const;
+
+  std::vector<uint64_t> _blocks;
+  size_t _blockMask;
+  std::vector<DictionaryBitmap> _bitmaps;
+};
+
+#endif  // SRC_LIB_STORAGE_JOINFILTER_H_
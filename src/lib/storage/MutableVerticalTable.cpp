@@ -82,11 +82,11 @@ const ColumnMetadata *MutableVerticalTable::metadataAt(const size_t column_index
   return containerAt(column_index)->metadataAt(offset_in_container[column_index]);
 }
 
-const AbstractTable::SharedDictionaryPtr& MutableVerticalTable::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
+AbstractTable::SharedDictionaryPtr MutableVerticalTable::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
   return containerAt(column)->dictionaryAt(offset_in_container[column], row, table_id, of_delta);
 }
 
-const AbstractTable::SharedDictionaryPtr& MutableVerticalTable::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
+AbstractTable::SharedDictionaryPtr MutableVerticalTable::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
   return containerAt(column)->dictionaryByTableId(offset_in_container[column], table_id);
 }
 
@@ -108,6 +108,14 @@ ValueId MutableVerticalTable::getValueId(const size_t column, const size_t row)
   return containerAt(column)->getValueId(tmp, row);
 }
 
+void MutableVerticalTable::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  containerAt(column)->getValueIds(offset_in_container[column], start, stop, value_ids);
+}
+
+void MutableVerticalTable::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  containerAt(column)->gatherValueIds(offset_in_container[column], rows, count, value_ids);
+}
+
 void MutableVerticalTable::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   containerAt(column)->setValueId(offset_in_container[column], row, valueId);
 }
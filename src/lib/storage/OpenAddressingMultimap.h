@@ -0,0 +1,416 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_OPENADDRESSINGMULTIMAP_H_
+#define SRC_LIB_STORAGE_OPENADDRESSINGMULTIMAP_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "storage/storage_types.h"
+
+/// Reference to a composite key that is stored in a flat key array
+template <typename T>
+class FlatKeyRef {
+  const T *_data;
+  size_t _width;
+
+public:
+  FlatKeyRef(const T *data, const size_t width) : _data(data), _width(width) {}
+
+  size_t size() const {
+    return _width;
+  }
+
+  const T &operator[](const size_t i) const {
+    return _data[i];
+  }
+
+  operator std::vector<T>() const {
+    return std::vector<T>(_data, _data + _width);
+  }
+
+  bool operator==(const FlatKeyRef &other) const {
+    return _width == other._width && std::equal(_data, _data + _width, other._data);
+  }
+
+  bool operator!=(const FlatKeyRef &other) const {
+    return !(*this == other);
+  }
+
+  bool operator==(const std::vector<T> &other) const {
+    return _width == other.size() && std::equal(_data, _data + _width, other.begin());
+  }
+};
+
+/// Stores the distinct keys of a map, scalar keys are kept as they are
+template <typename KEY>
+class FlatKeyStore {
+  std::vector<KEY> _keys;
+
+public:
+  typedef const KEY &const_reference;
+
+  size_t size() const {
+    return _keys.size();
+  }
+
+  void push_back(const KEY &key) {
+    _keys.push_back(key);
+  }
+
+  const_reference at(const size_t group) const {
+    return _keys[group];
+  }
+
+  bool equals(const size_t group, const KEY &key) const {
+    return _keys[group] == key;
+  }
+
+  static size_t hash(const KEY &key) {
+    return std::hash<KEY>()(key);
+  }
+};
+
+/// Composite keys are stored back to back in one array with the width
+/// of the first inserted key, so no key needs an allocation of its own
+template <typename T>
+class FlatKeyStore<std::vector<T> > {
+  std::vector<T> _data;
+  size_t _width;
+  size_t _count;
+
+public:
+  typedef FlatKeyRef<T> const_reference;
+
+  FlatKeyStore() : _width(0), _count(0) {}
+
+  size_t size() const {
+    return _count;
+  }
+
+  // Keys are either std::vector<T> or FlatKeyRef<T> of another store
+
+  template <typename K>
+  void push_back(const K &key) {
+    if (_count == 0) {
+      _width = key.size();
+    } else if (key.size() != _width) {
+      throw std::runtime_error("All keys of a map must have the same number of fields");
+    }
+    for (size_t i = 0; i < _width; ++i)
+      _data.push_back(key[i]);
+    ++_count;
+  }
+
+  const_reference at(const size_t group) const {
+    return const_reference(_data.data() + group * _width, _width);
+  }
+
+  template <typename K>
+  bool equals(const size_t group, const K &key) const {
+    if (key.size() != _width)
+      return false;
+    const T *data = _data.data() + group * _width;
+    for (size_t i = 0; i < _width; ++i)
+      if (data[i] != key[i])
+        return false;
+    return true;
+  }
+
+  template <typename K>
+  static size_t hash(const K &key) {
+    static auto hasher = std::hash<T>();
+    size_t seed = 0;
+    for (size_t i = 0; i < key.size(); ++i) {
+      // compare boost hash_combine
+      seed ^= hasher(key[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+};
+
+/**
+ * Assigns consecutive group numbers to distinct keys.
+ *
+ * Every distinct key is stored once in a flat key store and found via a
+ * linear probing slot array that holds group numbers only, the hash of
+ * every key is kept so that it is compared before the key itself and
+ * never has to be recomputed.
+ */
+template <typename KEY>
+class OpenAddressingKeyIndex {
+public:
+  typedef FlatKeyStore<KEY> key_store_t;
+  typedef typename key_store_t::const_reference const_key_reference;
+
+private:
+  enum { EMPTY_SLOT = 0 };
+
+  // Group number + 1 of the key occupying a slot, EMPTY_SLOT otherwise
+  std::vector<uint32_t> _slots;
+  std::vector<size_t> _hashes;
+  key_store_t _keys;
+
+  static inline size_t mix(size_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+  }
+
+  void placeGroup(const size_t group) {
+    const size_t mask = _slots.size() - 1;
+    size_t slot = mix(_hashes[group]) & mask;
+    while (_slots[slot] != EMPTY_SLOT)
+      slot = (slot + 1) & mask;
+    _slots[slot] = group + 1;
+  }
+
+  void grow() {
+    _slots.assign(std::max<size_t>(16, _slots.size() * 2), EMPTY_SLOT);
+    for (size_t group = 0; group < _keys.size(); ++group)
+      placeGroup(group);
+  }
+
+public:
+  template <typename K>
+  static size_t hash(const K &key) {
+    return key_store_t::hash(key);
+  }
+
+  /// Returns the group of key or size() if key is unknown
+  template <typename K>
+  size_t find(const K &key, const size_t hash) const {
+    if (_slots.empty())
+      return _keys.size();
+
+    const size_t mask = _slots.size() - 1;
+    for (size_t slot = mix(hash) & mask; _slots[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+      const size_t group = _slots[slot] - 1;
+      if (_hashes[group] == hash && _keys.equals(group, key))
+        return group;
+    }
+    return _keys.size();
+  }
+
+  /// Returns the group of key, unknown keys get the next group number
+  template <typename K>
+  size_t findOrInsert(const K &key, const size_t hash) {
+    const size_t group = find(key, hash);
+    if (group == _keys.size()) {
+      if ((_keys.size() + 1) * 2 > _slots.size())
+        grow();
+      _keys.push_back(key);
+      _hashes.push_back(hash);
+      placeGroup(group);
+    }
+    return group;
+  }
+
+  const_key_reference keyAt(const size_t group) const {
+    return _keys.at(group);
+  }
+
+  size_t hashAt(const size_t group) const {
+    return _hashes[group];
+  }
+
+  /// Number of distinct keys
+  size_t size() const {
+    return _keys.size();
+  }
+
+  size_t bucket_count() const {
+    return _slots.size();
+  }
+
+  float load_factor() const {
+    return _slots.empty() ? 0.0f : static_cast<float>(_keys.size()) / _slots.size();
+  }
+
+  float max_load_factor() const {
+    return 0.5f;
+  }
+};
+
+/**
+ * Multimap from keys to positions based on open addressing.
+ *
+ * Distinct keys are numbered by an OpenAddressingKeyIndex. The positions
+ * of all keys are kept in one array, grouped by key, so that equal keys
+ * are adjacent during iteration like in std::unordered_multimap.
+ *
+ * Inserted entries are only visible after finalize() was called, reading
+ * an unfinalized map throws. Iterators yield proxies with the members
+ * first and second instead of references to stored pairs.
+ */
+template <typename KEY, typename HASH>
+class OpenAddressingMultimap {
+public:
+  typedef KEY key_type;
+  typedef pos_t mapped_type;
+  typedef std::pair<KEY, pos_t> value_type;
+  typedef HASH hasher;
+  typedef FlatKeyStore<KEY> key_store_t;
+  typedef OpenAddressingKeyIndex<KEY> key_index_t;
+
+  struct reference {
+    typename key_store_t::const_reference first;
+    pos_t second;
+
+    const reference *operator->() const {
+      return this;
+    }
+  };
+
+  class const_iterator : public std::iterator<std::forward_iterator_tag, value_type, std::ptrdiff_t, const reference *, reference> {
+    const OpenAddressingMultimap *_map;
+    size_t _entry;
+    size_t _group;
+
+  public:
+    const_iterator() : _map(nullptr), _entry(0), _group(0) {}
+
+    const_iterator(const OpenAddressingMultimap *map, const size_t entry, const size_t group) :
+      _map(map), _entry(entry), _group(group) {}
+
+    reference operator*() const {
+      return reference {_map->_index.keyAt(_group), _map->_positions[_entry]};
+    }
+
+    reference operator->() const {
+      return **this;
+    }
+
+    const_iterator &operator++() {
+      if (++_entry == _map->_offsets[_group + 1])
+        ++_group;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return _entry == other._entry && _map == other._map;
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+private:
+  key_index_t _index;
+
+  // Positions of finalized entries, group g owns [_offsets[g], _offsets[g + 1])
+  std::vector<pos_t> _positions;
+  std::vector<size_t> _offsets;
+
+  // Entries inserted since the last finalize()
+  std::vector<uint32_t> _pendingGroups;
+  std::vector<pos_t> _pendingPositions;
+
+  void checkFinalized() const {
+    if (!_pendingGroups.empty())
+      throw std::logic_error("OpenAddressingMultimap has to be finalized before it is read");
+  }
+
+public:
+  OpenAddressingMultimap() : _offsets(1, 0) {}
+
+  void insert(const value_type &value) {
+    const size_t group = _index.findOrInsert(value.first, key_index_t::hash(value.first));
+    _pendingGroups.push_back(group);
+    _pendingPositions.push_back(value.second);
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, const InputIterator last) {
+    for (; first != last; ++first)
+      insert(value_type(first->first, first->second));
+  }
+
+  /// Groups all inserted entries by key, positions of a key keep their
+  /// insertion order
+  void finalize() {
+    if (_pendingGroups.empty())
+      return;
+
+    const size_t groups = _index.size();
+    std::vector<size_t> offsets(groups + 1, 0);
+    for (size_t group = 0; group + 1 < _offsets.size(); ++group)
+      offsets[group + 1] = _offsets[group + 1] - _offsets[group];
+    for (const auto &group : _pendingGroups)
+      ++offsets[group + 1];
+    for (size_t group = 0; group < groups; ++group)
+      offsets[group + 1] += offsets[group];
+
+    std::vector<pos_t> positions(offsets.back());
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t group = 0; group + 1 < _offsets.size(); ++group)
+      for (size_t entry = _offsets[group]; entry < _offsets[group + 1]; ++entry)
+        positions[fill[group]++] = _positions[entry];
+    for (size_t i = 0; i < _pendingGroups.size(); ++i)
+      positions[fill[_pendingGroups[i]]++] = _pendingPositions[i];
+
+    _positions.swap(positions);
+    _offsets.swap(offsets);
+    std::vector<uint32_t>().swap(_pendingGroups);
+    std::vector<pos_t>().swap(_pendingPositions);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const KEY &key) const {
+    checkFinalized();
+    const size_t group = _index.find(key, key_index_t::hash(key));
+    if (group == _index.size())
+      return std::make_pair(end(), end());
+    return std::make_pair(const_iterator(this, _offsets[group], group),
+                          const_iterator(this, _offsets[group + 1], group + 1));
+  }
+
+  size_t count(const KEY &key) const {
+    const auto range = equal_range(key);
+    return std::distance(range.first, range.second);
+  }
+
+  const_iterator begin() const {
+    checkFinalized();
+    return const_iterator(this, 0, 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(this, _positions.size(), _index.size());
+  }
+
+  size_t size() const {
+    return _positions.size() + _pendingPositions.size();
+  }
+
+  /// Number of distinct keys
+  size_t keyCount() const {
+    return _index.size();
+  }
+
+  size_t bucket_count() const {
+    return _index.bucket_count();
+  }
+
+  float load_factor() const {
+    return _index.load_factor();
+  }
+
+  float max_load_factor() const {
+    return _index.max_load_factor();
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_OPENADDRESSINGMULTIMAP_H_
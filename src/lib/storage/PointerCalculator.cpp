@@ -4,21 +4,23 @@
 #include <iostream>
 #include <string>
 
+#include "storage/PointerCalculatorFactory.h"
 #include "storage/PrettyPrinter.h"
 #include "storage/Store.h"
 
 
 
-PointerCalculator::PointerCalculator(hyrise::storage::c_atable_ptr_t t, pos_list_t *pos, field_list_t *f) : table(t), pos_list(pos), fields(f) {
+PointerCalculator::PointerCalculator(hyrise::storage::c_atable_ptr_t t, pos_list_t *pos, field_list_t *f) : table(t), pos_list(pos), fields(f),
+  has_range(false), range_start(0), range_size(0), materialized_rows(nullptr) {
   // prevent nested pos_list/fields: if the input table is a
   // PointerCalculator instance, combine the old and new
   // pos_list/fields lists
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(t);
   if (p) {
-    if (pos_list != nullptr && p->pos_list != NULL) {
+    if (pos_list != nullptr && p->isFiltered()) {
       pos_list = new pos_list_t(pos->size());
       for (size_t i = 0; i < pos->size(); i++) {
-        (*pos_list)[i] = p->pos_list->at(pos->at(i));
+        (*pos_list)[i] = p->actualRow(pos->at(i));
       }
       table = p->table;
       delete pos;
@@ -35,7 +37,28 @@ PointerCalculator::PointerCalculator(hyrise::storage::c_atable_ptr_t t, pos_list
 }
 
 hyrise::storage::atable_ptr_t PointerCalculator::copy() const {
-  return std::make_shared<PointerCalculator>(table, fields, pos_list);
+  auto result = std::make_shared<PointerCalculator>(table, nullptr, fields ? new field_list_t(*fields) : nullptr);
+  result->copyRowsFrom(*this);
+  return result;
+}
+
+void PointerCalculator::copyRowsFrom(const PointerCalculator &other) {
+  delete pos_list;
+  pos_list = other.pos_list ? new pos_list_t(*other.pos_list) : nullptr;
+  bitmap = other.bitmap;
+  has_range = other.has_range;
+  range_start = other.range_start;
+  range_size = other.range_size;
+  // the positions of the same rows are shared
+  std::lock_guard<std::mutex> lock(other.materialize_mutex);
+  materialized = other.materialized;
+  materialized_rows.store(materialized.get(), std::memory_order_release);
+}
+
+void PointerCalculator::resetMaterialized() {
+  std::lock_guard<std::mutex> lock(materialize_mutex);
+  materialized_rows.store(nullptr, std::memory_order_release);
+  materialized = nullptr;
 }
 
 PointerCalculator::~PointerCalculator() {
@@ -88,6 +111,33 @@ void PointerCalculator::setPositions(const pos_list_t pos) {
   if (pos_list != nullptr)
     delete pos_list;
   pos_list = new std::vector<pos_t>(pos);
+  resetMaterialized();
+  bitmap = nullptr;
+  has_range = false;
+  range_start = 0;
+}
+
+void PointerCalculator::setRange(const pos_t start, const pos_t stop) {
+  delete pos_list;
+  pos_list = nullptr;
+  resetMaterialized();
+  bitmap = nullptr;
+  has_range = true;
+  range_start = start;
+  range_size = stop - start;
+}
+
+void PointerCalculator::setBitmap(BitVector *rows) {
+  if (rows->size() != table->size())
+    throw std::runtime_error("Bitmap needs one bit per row of the table");
+  rows->buildRankIndex();
+  delete pos_list;
+  pos_list = nullptr;
+  resetMaterialized();
+  has_range = false;
+  range_start = 0;
+  bitmap.reset(rows);
+  range_size = bitmap->count();
 }
 
 void PointerCalculator::setFields(const field_list_t f) {
@@ -111,7 +161,7 @@ void PointerCalculator::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict,
   throw std::runtime_error("Can't set PointerCalculator dictionary");
 }
 
-const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
+AbstractTable::SharedDictionaryPtr PointerCalculator::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
   size_t actual_column, actual_row;
 
   if (fields) {
@@ -120,8 +170,8 @@ const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryAt(const
     actual_column = column;
   }
 
-  if (pos_list && pos_list->size() > 0) {
-    actual_row = pos_list->at(row);
+  if (isFiltered() && size() > 0) {
+    actual_row = actualRow(row);
   } else {
     actual_row = row;
   }
@@ -129,7 +179,7 @@ const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryAt(const
   return table->dictionaryAt(actual_column, actual_row, table_id);
 }
 
-const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
+AbstractTable::SharedDictionaryPtr PointerCalculator::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
   size_t actual_column;
 
   if (fields) {
@@ -146,6 +196,11 @@ size_t PointerCalculator::size() const {
     return pos_list->size();
   }
 
+  // the number of set bits for bitmaps
+  if (bitmap || has_range) {
+    return range_size;
+  }
+
   return table->size();
 }
 
@@ -160,11 +215,7 @@ size_t PointerCalculator::columnCount() const {
 ValueId PointerCalculator::getValueId(const size_t column, const size_t row) const {
   size_t actual_column, actual_row;
 
-  if (pos_list) {
-    actual_row = pos_list->at(row);
-  } else {
-    actual_row = row;
-  }
+  actual_row = actualRow(row);
 
   if (fields) {
     actual_column = fields->at(column);
@@ -175,18 +226,52 @@ ValueId PointerCalculator::getValueId(const size_t column, const size_t row) con
   return table->getValueId(actual_column, actual_row);
 }
 
-unsigned PointerCalculator::sliceCount() const {
-  return slice_count;
+void PointerCalculator::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  size_t actual_column = fields ? fields->at(column) : column;
+
+  if (pos_list) {
+    table->gatherValueIds(actual_column, pos_list->data() + start, stop - start, value_ids);
+  } else if (bitmap) {
+    if (start == stop)
+      return;
+    const pos_list_t *materialized_positions = materialized_rows.load(std::memory_order_acquire);
+    if (materialized_positions) {
+      table->gatherValueIds(actual_column, materialized_positions->data() + start, stop - start, value_ids);
+      return;
+    }
+    // the rows after the first one are the next set bits
+    pos_list_t rows(stop - start);
+    pos_t row = bitmap->select(start);
+    for (size_t i = 0; i < rows.size(); ++i) {
+      rows[i] = row;
+      row = bitmap->nextSetBit(row + 1);
+    }
+    table->gatherValueIds(actual_column, rows.data(), rows.size(), value_ids);
+  } else {
+    table->getValueIds(actual_column, range_start + start, range_start + stop, value_ids);
+  }
 }
 
-void *PointerCalculator::atSlice(const size_t slice, const size_t row) const {
-  size_t actual_row;
+void PointerCalculator::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  size_t actual_column = fields ? fields->at(column) : column;
 
-  if (pos_list) {
-    actual_row = pos_list->at(row);
+  if (isFiltered()) {
+    pos_list_t actual_rows(count);
+    for (size_t i = 0; i < count; ++i) {
+      actual_rows[i] = actualRow(rows[i]);
+    }
+    table->gatherValueIds(actual_column, actual_rows.data(), count, value_ids);
   } else {
-    actual_row = row;
+    table->gatherValueIds(actual_column, rows, count, value_ids);
   }
+}
+
+unsigned PointerCalculator::sliceCount() const {
+  return slice_count;
+}
+
+void *PointerCalculator::atSlice(const size_t slice, const size_t row) const {
+  size_t actual_row = actualRow(row);
 
   if (fields) {
     void *at = table->atSlice(slice_for_slice[slice], row);
@@ -222,11 +307,7 @@ void PointerCalculator::print(const size_t limit) const {
 std::string PointerCalculator::printValue(const size_t column, const size_t row) const {
   size_t actual_column, actual_row;
 
-  if (pos_list) {
-    actual_row = pos_list->at(row);
-  } else {
-    actual_row = row;
-  }
+  actual_row = actualRow(row);
 
   if (fields) {
     actual_column = fields->at(column);
@@ -243,13 +324,8 @@ void PointerCalculator::sortDictionary() {
 
 size_t PointerCalculator::getTableRowForRow(const size_t row) const
 {
-  size_t actual_row;
   // resolve mapping of THIS pointer calculator
-  if (pos_list) {
-      actual_row = pos_list->at(row);
-  } else {
-      actual_row = row;
-  }
+  size_t actual_row = actualRow(row);
   // if underlying table is PointerCalculator, resolve recursively
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(table);
   if (p)
@@ -289,12 +365,34 @@ hyrise::storage::c_atable_ptr_t PointerCalculator::getActualTable() const {
 }
 
 const pos_list_t *PointerCalculator::getPositions() const {
-  return pos_list;
+  if (pos_list || !isFiltered()) {
+    return pos_list;
+  }
+
+  const pos_list_t *rows = materialized_rows.load(std::memory_order_acquire);
+  if (rows)
+    return rows;
+
+  std::lock_guard<std::mutex> lock(materialize_mutex);
+  if (!materialized) {
+    auto positions = std::make_shared<pos_list_t>();
+    positions->reserve(range_size);
+    if (bitmap) {
+      bitmap->forEachSetBit([&positions](size_t row) { positions->push_back(row); });
+    } else {
+      for (size_t row = 0; row < range_size; ++row)
+        positions->push_back(range_start + row);
+    }
+    materialized = positions;
+    materialized_rows.store(materialized.get(), std::memory_order_release);
+  }
+  return materialized.get();
 }
 
 pos_list_t PointerCalculator::getActualTablePositions() const {
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(table);
 
+  const pos_list_t *pos_list = getPositions();
   if (!p) {
     return *pos_list;
   }
@@ -343,14 +441,112 @@ for (const field_t & field: *fields) {
 }
 
 
-std::shared_ptr<PointerCalculator> PointerCalculator::intersect(const std::shared_ptr<const PointerCalculator>& other) const {
-  pos_list_t *result = new pos_list_t(std::max(pos_list->size(), other->pos_list->size()));
+bool PointerCalculator::containsRow(const pos_t row) const {
+  if (pos_list)
+    return std::binary_search(pos_list->begin(), pos_list->end(), row);
+  if (bitmap)
+    return bitmap->get(row);
+  if (has_range)
+    return row >= range_start && row < range_start + range_size;
+  return row < table->size();
+}
+
+std::shared_ptr<const BitVector> PointerCalculator::toBitmap() const {
+  if (bitmap)
+    return bitmap;
+
+  auto bits = std::make_shared<BitVector>(table->size());
+  if (pos_list) {
+    for (const auto &row : *pos_list)
+      bits->set(row, true);
+  } else if (has_range) {
+    bits->setRange(range_start, range_start + range_size);
+  } else {
+    bits->setRange(0, table->size());
+  }
+  return bits;
+}
+
+std::shared_ptr<PointerCalculator> PointerCalculator::withBitmap(BitVector *bits) const {
+  return PointerCalculatorFactory::createPointerCalculatorForBitmap(table, fields ? new field_list_t(*fields) : nullptr, bits);
+}
 
-  std::set_intersection(pos_list->begin(), pos_list->end(),
-                        other->pos_list->begin(), other->pos_list->end(),
-                        std::back_inserter(*result));
+std::shared_ptr<PointerCalculator> PointerCalculator::withPositions(pos_list_t *positions) const {
+  return PointerCalculatorFactory::createPointerCalculatorForSorted(table, fields ? new field_list_t(*fields) : nullptr, positions);
+}
 
+std::shared_ptr<PointerCalculator> PointerCalculator::intersect(const std::shared_ptr<const PointerCalculator>& other) const {
   assert((other->table == this->table) && "Should point to same table");
-  return std::make_shared<PointerCalculator>(table, result, fields);  
+
+  // a view without positions contains all rows
+  if (!isFiltered() || !other->isFiltered()) {
+    auto result = std::dynamic_pointer_cast<PointerCalculator>(copy());
+    if (!isFiltered())
+      result->copyRowsFrom(*other);
+    return result;
+  }
+
+  if (has_range && other->has_range) {
+    const pos_t start = std::max(range_start, other->range_start);
+    const pos_t stop = std::min(range_start + range_size, other->range_start + other->range_size);
+    auto result = withPositions(new pos_list_t);
+    if (start < stop)
+      result->setRange(start, stop);
+    return result;
+  }
+
+  if (pos_list && other->pos_list) {
+    pos_list_t *result = new pos_list_t;
+    result->reserve(std::min(pos_list->size(), other->pos_list->size()));
+    std::set_intersection(pos_list->begin(), pos_list->end(),
+                          other->pos_list->begin(), other->pos_list->end(),
+                          std::back_inserter(*result));
+    return withPositions(result);
+  }
+
+  // positions stay sorted when filtered by the other view
+  if (pos_list || other->pos_list) {
+    const auto &positions = pos_list ? *pos_list : *other->pos_list;
+    const PointerCalculator &filter = pos_list ? *other : *this;
+    pos_list_t *result = new pos_list_t;
+    for (const auto &row : positions) {
+      if (filter.containsRow(row))
+        result->push_back(row);
+    }
+    return withPositions(result);
+  }
+
+  BitVector *bits = new BitVector(*toBitmap());
+  *bits &= *other->toBitmap();
+  return withBitmap(bits);
 }
 
+std::shared_ptr<PointerCalculator> PointerCalculator::unite(const std::shared_ptr<const PointerCalculator>& other) const {
+  assert((other->table == this->table) && "Should point to same table");
+
+  if (!isFiltered() || !other->isFiltered())
+    return std::make_shared<PointerCalculator>(table, nullptr, fields ? new field_list_t(*fields) : nullptr);
+
+  // overlapping or adjacent ranges form a single range
+  if (has_range && other->has_range &&
+      range_start <= other->range_start + other->range_size &&
+      other->range_start <= range_start + range_size) {
+    auto result = withPositions(new pos_list_t);
+    result->setRange(std::min(range_start, other->range_start),
+                     std::max(range_start + range_size, other->range_start + other->range_size));
+    return result;
+  }
+
+  if (pos_list && other->pos_list && !prefersBitmap(pos_list->size() + other->pos_list->size(), table->size())) {
+    pos_list_t *result = new pos_list_t;
+    result->reserve(pos_list->size() + other->pos_list->size());
+    std::set_union(pos_list->begin(), pos_list->end(),
+                   other->pos_list->begin(), other->pos_list->end(),
+                   std::back_inserter(*result));
+    return withPositions(result);
+  }
+
+  BitVector *bits = new BitVector(*toBitmap());
+  *bits |= *other->toBitmap();
+  return withBitmap(bits);
+}
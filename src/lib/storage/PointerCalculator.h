@@ -5,18 +5,39 @@
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #include "helper/types.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/BitVector.h"
 #include "storage/MutableVerticalTable.h"
 
+/*
+ * View on the rows of a table. The rows are given by a list of positions,
+ * or for sorted positions more compactly by a range of rows or a bitmap
+ * over all rows of the table, see setRange and setBitmap. Without any of
+ * them the view contains all rows.
+ */
 class PointerCalculator : public AbstractTable {
 private:
   hyrise::storage::c_atable_ptr_t table;
   pos_list_t *pos_list;
   field_list_t *fields;
 
+  std::shared_ptr<const BitVector> bitmap;
+  bool has_range;
+  pos_t range_start;
+  size_t range_size;
+
+  // positions of a range or bitmap for getPositions, materialized_rows
+  // is set once they are complete
+  mutable std::mutex materialize_mutex;
+  mutable std::shared_ptr<const pos_list_t> materialized;
+  mutable std::atomic<const pos_list_t *> materialized_rows;
+
   std::vector<size_t> slice_for_slice;
   std::vector<size_t> offset_in_slice;
   std::vector<size_t> width_for_slice;
@@ -25,6 +46,40 @@ private:
 protected:
   void updateFieldMapping();
 
+  bool isFiltered() const {
+    return pos_list || bitmap || has_range;
+  }
+
+  // Row of table for row of the view, a bitmap is converted to positions
+  // on the first access instead of selecting the row in it each time
+  inline pos_t actualRow(const size_t row) const {
+    if (pos_list)
+      return pos_list->at(row);
+    if (bitmap) {
+      const pos_list_t *rows = materialized_rows.load(std::memory_order_acquire);
+      return (rows ? rows : getPositions())->at(row);
+    }
+    return range_start + row;
+  }
+
+  // Drops the positions materialized for the previous rows
+  void resetMaterialized();
+
+  // Whether row of table is part of the view
+  bool containsRow(const pos_t row) const;
+
+  // Takes over the rows of other, keeps table and fields
+  void copyRowsFrom(const PointerCalculator &other);
+
+  // Bitmap over the rows of table marking the rows of the view
+  std::shared_ptr<const BitVector> toBitmap() const;
+
+  // View on the same table and fields with the sorted rows of bits
+  std::shared_ptr<PointerCalculator> withBitmap(BitVector *bits) const;
+
+  // View on the same table and fields with the sorted positions
+  std::shared_ptr<PointerCalculator> withPositions(pos_list_t *positions) const;
+
 public:
 
   PointerCalculator(hyrise::storage::c_atable_ptr_t t, pos_list_t *pos = nullptr, field_list_t *f = nullptr);
@@ -35,13 +90,36 @@ public:
 
   void setPositions(const pos_list_t pos);
 
+  /// Restricts the view to the rows [start, stop) of the table
+  void setRange(const pos_t start, const pos_t stop);
+
+  /// Restricts the view to the rows set in rows, the bitmap has one bit
+  /// per row of the table
+  void setBitmap(BitVector *rows);
+
+  bool isRange() const {
+    return has_range;
+  }
+
+  bool isBitmap() const {
+    return bitmap != nullptr;
+  }
+
+  /// Whether count sorted positions out of rows are kept as bitmap, it
+  /// has to save at least a byte per row. Bitmaps serve scans and
+  /// intersect/unite, the first access to a single row converts them to
+  /// positions.
+  static bool prefersBitmap(const size_t count, const size_t rows) {
+    return count * sizeof(pos_t) > rows;
+  }
+
   void setFields(const field_list_t f);
 
   const ColumnMetadata *metadataAt(const size_t column_index, const size_t row_index = 0, const table_id_t table_id = 0) const;
 
-  const AbstractTable::SharedDictionaryPtr& dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
+  AbstractTable::SharedDictionaryPtr dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
 
-  virtual const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(const size_t column, const table_id_t table_id) const;
+  virtual AbstractTable::SharedDictionaryPtr dictionaryByTableId(const size_t column, const table_id_t table_id) const;
 
   virtual void setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row = 0, const table_id_t table_id = 0);
 
@@ -51,6 +129,10 @@ public:
 
   ValueId getValueId(const size_t column, const size_t row) const;
 
+  void getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const;
+
+  void gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const;
+
   unsigned sliceCount() const;
 
   virtual void *atSlice(const size_t slice, const size_t row) const;
@@ -79,6 +161,8 @@ public:
 
   hyrise::storage::c_atable_ptr_t getActualTable() const;
 
+  /// Positions of the view, ranges and bitmaps are converted to a
+  /// list on the first call
   const pos_list_t *getPositions() const;
 
   pos_list_t getActualTablePositions() const;
@@ -86,8 +170,13 @@ public:
   virtual  hyrise::storage::atable_ptr_t copy_structure(const field_list_t *fields = nullptr, const bool reuse_dict = false, const size_t initial_size = 0, const bool with_containers = true) const;
 
 
+  /// Rows contained in both views of the same table, ranges and bitmaps
+  /// are combined without converting them to positions
   std::shared_ptr<PointerCalculator> intersect(const std::shared_ptr<const PointerCalculator>& other) const;
 
+  /// Rows contained in any of both views of the same table
+  std::shared_ptr<PointerCalculator> unite(const std::shared_ptr<const PointerCalculator>& other) const;
+
 };
 
 #endif  // SRC_LIB_STORAGE_POINTERCALCULATOR_H_
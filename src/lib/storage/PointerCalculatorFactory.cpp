@@ -12,10 +12,55 @@ std::shared_ptr<PointerCalculator> PointerCalculatorFactory::createPointerCalcul
   return std::make_shared<PointerCalculator>(_table, _positions, _field_definition);
 }
 
-std::shared_ptr<PointerCalculator> PointerCalculatorFactory::createView(hyrise::storage::c_atable_ptr_t& _table, size_t start, size_t end) {
-  pos_list_t *positions = new pos_list_t;
-  for (pos_t row = start; row <= end; ++row)
-    positions->push_back(row);
+std::shared_ptr<PointerCalculator> PointerCalculatorFactory::createPointerCalculatorForSorted(hyrise::storage::c_atable_ptr_t _table, std::vector<field_t> *_field_definition, std::vector<pos_t> *_positions) {
+  const size_t count = _positions->size();
+  if (count > 0 && _positions->back() - _positions->front() + 1 == count) {
+    auto result = std::make_shared<PointerCalculator>(_table, nullptr, _field_definition);
+    result->setRange(_positions->front(), _positions->back() + 1);
+    delete _positions;
+    return result;
+  }
+
+  if (PointerCalculator::prefersBitmap(count, _table->size())) {
+    BitVector *rows = new BitVector(_table->size());
+    for (const auto &row : *_positions)
+      rows->set(row, true);
+    delete _positions;
+    auto result = std::make_shared<PointerCalculator>(_table, nullptr, _field_definition);
+    result->setBitmap(rows);
+    return result;
+  }
+
+  return std::make_shared<PointerCalculator>(_table, _positions, _field_definition);
+}
+
+std::shared_ptr<PointerCalculator> PointerCalculatorFactory::createPointerCalculatorForBitmap(hyrise::storage::c_atable_ptr_t _table, std::vector<field_t> *_field_definition, BitVector *_rows) {
+  const size_t count = _rows->count();
+  const size_t first = _rows->nextSetBit(0);
 
-  return std::make_shared<PointerCalculator>(_table, positions);
+  // set bits that form a single run
+  if (count > 0 && _rows->nextSetBit(first + count) == _rows->size()) {
+    auto result = std::make_shared<PointerCalculator>(_table, nullptr, _field_definition);
+    result->setRange(first, first + count);
+    delete _rows;
+    return result;
+  }
+
+  if (!PointerCalculator::prefersBitmap(count, _rows->size())) {
+    pos_list_t *positions = new pos_list_t;
+    positions->reserve(count);
+    _rows->forEachSetBit([positions](size_t row) { positions->push_back(row); });
+    delete _rows;
+    return std::make_shared<PointerCalculator>(_table, positions, _field_definition);
+  }
+
+  auto result = std::make_shared<PointerCalculator>(_table, nullptr, _field_definition);
+  result->setBitmap(_rows);
+  return result;
+}
+
+std::shared_ptr<PointerCalculator> PointerCalculatorFactory::createView(hyrise::storage::c_atable_ptr_t& _table, size_t start, size_t end) {
+  auto result = std::make_shared<PointerCalculator>(_table);
+  result->setRange(start, end + 1);
+  return result;
 }
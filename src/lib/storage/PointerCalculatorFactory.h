@@ -9,6 +9,7 @@
 #include "storage/storage_types.h"
 
 class AbstractTable;
+class BitVector;
 class PointerCalculator;
 
 class PointerCalculatorFactory {
@@ -20,6 +21,14 @@ class PointerCalculatorFactory {
 
   static std::shared_ptr<PointerCalculator> createPointerCalculatorNonRef(hyrise::storage::c_atable_ptr_t _table, field_list_t *_field_definition = nullptr, pos_list_t *_positions = NULL);
 
+  /// Creates a pointer calculator on the sorted positions that stores
+  /// them as range, bitmap or list, whichever is smallest
+  static std::shared_ptr<PointerCalculator> createPointerCalculatorForSorted(hyrise::storage::c_atable_ptr_t _table, field_list_t *_field_definition, pos_list_t *_positions);
+
+  /// Creates a pointer calculator on the rows set in _rows, which has
+  /// one bit per row of _table, like createPointerCalculatorForSorted
+  static std::shared_ptr<PointerCalculator> createPointerCalculatorForBitmap(hyrise::storage::c_atable_ptr_t _table, field_list_t *_field_definition, BitVector *_rows);
+
   static std::shared_ptr<PointerCalculator> createView(hyrise::storage::c_atable_ptr_t& _table, size_t start, size_t end);
 
 };
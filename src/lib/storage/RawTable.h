@@ -352,14 +352,14 @@ public:
     STORAGE_NOT_IMPLEMENTED(RawTable, getSliceWidth());
   }
 
-  virtual const AbstractTable::SharedDictionaryPtr& dictionaryAt(const size_t column, 
+  virtual AbstractTable::SharedDictionaryPtr dictionaryAt(const size_t column, 
                                                           const size_t row = 0, 
                                                           const table_id_t table_id = 0, 
                                                           const bool of_delta = false) const { 
     STORAGE_NOT_IMPLEMENTED(RawTable, getSliceWidth());
   }
 
-  virtual const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(const size_t column, 
+  virtual AbstractTable::SharedDictionaryPtr dictionaryByTableId(const size_t column, 
                                                                  const table_id_t table_id) const { 
     STORAGE_NOT_IMPLEMENTED(RawTable, dictionaryByTableId());
   }
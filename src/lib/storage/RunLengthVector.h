@@ -0,0 +1,281 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_RUNLENGTHVECTOR_H_
+#define SRC_LIB_STORAGE_RUNLENGTHVECTOR_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <storage/AbstractAttributeVector.h>
+#include <storage/BaseAttributeVector.h>
+
+/*
+  Stores every column as a sequence of runs of equal values. A run is
+  kept as its value and the row one past its end, so a column costs
+  (sizeof(T) + sizeof(pos_t)) bytes per run independent of the number of
+  rows. Sorted or clustered columns, e.g. a warehouse id, need far fewer
+  bytes than with bit compression.
+
+  Rows are located by a binary search over the run ends, block accessors
+  walk the runs sequentially instead. Writes are supported but may split
+  runs, the vector is meant for main tables that are not modified.
+ */
+template <typename T>
+class RunLengthVector : public BaseAttributeVector<T> {
+  struct column_runs_t {
+    std::vector<T> values;
+    // row one past the end of each run, ascending
+    std::vector<pos_t> ends;
+  };
+
+  std::vector<column_runs_t> _columns;
+  size_t _rows;
+
+public:
+  typedef T value_type;
+
+  RunLengthVector(size_t columns, size_t rows) : _columns(columns), _rows(0) {
+    resize(rows);
+  }
+
+  virtual ~RunLengthVector() {
+  }
+
+  /*
+    Encodes the first rows rows of all columns of source
+   */
+  static std::shared_ptr<RunLengthVector<T>> encode(const BaseAttributeVector<T> &source, size_t columns, size_t rows) {
+    const static size_t block_size = 1024;
+    T values[block_size];
+
+    auto result = std::make_shared<RunLengthVector<T>>(columns, 0);
+    for (size_t column = 0; column < columns; ++column) {
+      auto &runs = result->_columns[column];
+      for (size_t start = 0; start < rows; start += block_size) {
+        const size_t count = std::min(block_size, rows - start);
+        source.decode(column, start, start + count, values);
+        for (size_t i = 0; i < count; ++i) {
+          if (runs.values.empty() || runs.values.back() != values[i]) {
+            runs.values.push_back(values[i]);
+            runs.ends.push_back(start + i + 1);
+          } else {
+            runs.ends.back() = start + i + 1;
+          }
+        }
+      }
+    }
+    result->_rows = rows;
+    return result;
+  }
+
+  /*
+    Number of runs the first rows rows of column of source consist of
+   */
+  static size_t countRuns(const BaseAttributeVector<T> &source, size_t column, size_t rows) {
+    const static size_t block_size = 1024;
+    T values[block_size];
+
+    size_t runs = 0;
+    T last = T();
+    for (size_t start = 0; start < rows; start += block_size) {
+      const size_t count = std::min(block_size, rows - start);
+      source.decode(column, start, start + count, values);
+      for (size_t i = 0; i < count; ++i) {
+        if ((start + i) == 0 || values[i] != last) {
+          ++runs;
+          last = values[i];
+        }
+      }
+    }
+    return runs;
+  }
+
+  size_t runCount(size_t column) const {
+    return _columns[column].ends.size();
+  }
+
+  void *data() {
+    throw std::runtime_error("Direct data access not allowed");
+  }
+
+  void setNumRows(size_t s) {
+    throw std::runtime_error("Direct data access not allowed");
+  }
+
+  T get(size_t column, size_t row) const {
+    const auto &runs = _columns[column];
+    return runs.values[runOf(runs, row)];
+  }
+
+  void set(size_t column, size_t row, T value) {
+    auto &runs = _columns[column];
+    const size_t run = runOf(runs, row);
+    if (runs.values[run] == value) {
+      return;
+    }
+
+    // split the run into the rows before, the row and the rows after
+    const pos_t begin = run == 0 ? 0 : runs.ends[run - 1];
+    const pos_t end = runs.ends[run];
+    const T old = runs.values[run];
+    size_t position = run;
+    runs.values.erase(runs.values.begin() + run);
+    runs.ends.erase(runs.ends.begin() + run);
+    if (begin < row) {
+      runs.values.insert(runs.values.begin() + position, old);
+      runs.ends.insert(runs.ends.begin() + position, row);
+      ++position;
+    }
+    runs.values.insert(runs.values.begin() + position, value);
+    runs.ends.insert(runs.ends.begin() + position, row + 1);
+    if (row + 1 < end) {
+      runs.values.insert(runs.values.begin() + position + 1, old);
+      runs.ends.insert(runs.ends.begin() + position + 1, end);
+    }
+
+    // join the new run with equal neighbours
+    if (position + 1 < runs.values.size() && runs.values[position + 1] == value) {
+      runs.ends[position] = runs.ends[position + 1];
+      runs.values.erase(runs.values.begin() + position + 1);
+      runs.ends.erase(runs.ends.begin() + position + 1);
+    }
+    if (position > 0 && runs.values[position - 1] == value) {
+      runs.ends[position - 1] = runs.ends[position];
+      runs.values.erase(runs.values.begin() + position);
+      runs.ends.erase(runs.ends.begin() + position);
+    }
+  }
+
+  void decode(size_t column, size_t start, size_t stop, T *values) const {
+    if (start >= stop) {
+      return;
+    }
+    const auto &runs = _columns[column];
+    size_t row = start;
+    for (size_t run = runOf(runs, start); row < stop; ++run) {
+      const size_t end = std::min<size_t>(runs.ends[run], stop);
+      std::fill(values + (row - start), values + (end - start), runs.values[run]);
+      row = end;
+    }
+  }
+
+  void gather(size_t column, const pos_t *rows, size_t count, T *values) const {
+    const auto &runs = _columns[column];
+    size_t run = 0;
+    for (size_t i = 0; i < count; ++i) {
+      // ascending rows, the common case, continue from the last run
+      if (i == 0 || rows[i] < rows[i - 1]) {
+        run = runOf(runs, rows[i]);
+      } else {
+        while (runs.ends[run] <= rows[i]) {
+          ++run;
+        }
+      }
+      values[i] = runs.values[run];
+    }
+  }
+
+  /*
+    Compares every run once and appends the positions of all rows of
+    each matching run
+   */
+  void scanRange(size_t column, size_t start, size_t stop, T low, T high, pos_list_t &positions, size_t offset = 0) const {
+    std::vector<row_range_t> ranges;
+    scanRanges(column, start, stop, low, high, ranges, offset);
+    for (const auto &range : ranges) {
+      const size_t first = positions.size();
+      positions.resize(first + range.second - range.first);
+      for (size_t i = first; i < positions.size(); ++i) {
+        positions[i] = range.first + (i - first);
+      }
+    }
+  }
+
+  /*
+    Compares every run once and appends one range per matching run,
+    adjacent matching runs are joined
+   */
+  bool scanRanges(size_t column, size_t start, size_t stop, T low, T high, std::vector<row_range_t> &ranges, size_t offset = 0) const {
+    if (start >= stop) {
+      return true;
+    }
+    const auto &runs = _columns[column];
+    size_t row = start;
+    for (size_t run = runOf(runs, start); row < stop; ++run) {
+      const size_t end = std::min<size_t>(runs.ends[run], stop);
+      if (runs.values[run] >= low && runs.values[run] <= high) {
+        if (!ranges.empty() && ranges.back().second == offset + row) {
+          ranges.back().second = offset + end;
+        } else {
+          ranges.push_back(row_range_t(offset + row, offset + end));
+        }
+      }
+      row = end;
+    }
+    return true;
+  }
+
+  void reserve(size_t rows) {
+  }
+
+  /*
+    Appends rows holding the value 0 or drops the rows from the end
+   */
+  void resize(size_t rows) {
+    for (auto &runs : _columns) {
+      if (rows > _rows) {
+        if (!runs.values.empty() && runs.values.back() == T()) {
+          runs.ends.back() = rows;
+        } else {
+          runs.values.push_back(T());
+          runs.ends.push_back(rows);
+        }
+      } else {
+        const size_t kept = rows == 0 ? 0 : runOf(runs, rows - 1) + 1;
+        runs.values.resize(kept);
+        runs.ends.resize(kept);
+        if (kept > 0) {
+          runs.ends.back() = rows;
+        }
+      }
+    }
+    _rows = rows;
+  }
+
+  uint64_t capacity() {
+    return _rows;
+  }
+
+  void clear() {
+    for (auto &runs : _columns) {
+      runs.values.clear();
+      runs.ends.clear();
+    }
+    _rows = 0;
+  }
+
+  size_t size() {
+    return _rows;
+  }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() {
+    auto result = std::make_shared<RunLengthVector<T>>(_columns.size(), 0);
+    result->_columns = _columns;
+    result->_rows = _rows;
+    return result;
+  }
+
+  // Values are stored in full width, a new dictionary needs no rewrite
+  void rewriteColumn(const size_t column, const size_t bits) {
+  }
+
+private:
+  static size_t runOf(const column_runs_t &runs, size_t row) {
+    return std::upper_bound(runs.ends.begin(), runs.ends.end(), static_cast<pos_t>(row)) - runs.ends.begin();
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_RUNLENGTHVECTOR_H_
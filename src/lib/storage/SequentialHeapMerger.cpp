@@ -1,58 +1,152 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/SequentialHeapMerger.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <queue>
 
-void SequentialHeapMerger::mergeValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
-                                       hyrise::storage::atable_ptr_t merged_table,
-                                       const hyrise::storage::column_mapping_t &column_mapping,
-                                       const uint64_t newSize) {
+#include "storage/FrameOfReferenceDictionary.h"
+#include "storage/FrontCodedDictionary.h"
+#include "taskscheduler/MorselTask.h"
 
-  std::vector<value_id_mapping_t> mappingPerAtrtibute(input_tables[0]->columnCount());
+namespace {
+  // Rows per morsel of the value id rewrite, a multiple of 64 so that
+  // morsels start on word boundaries of bit compressed attribute vectors
+  const size_t MERGE_MORSEL_SIZE = 64 * 1024;
 
-for (const auto & kv: column_mapping) {
-    const auto &source = kv.first;
-    const auto &destination = kv.second;
-    switch (merged_table->metadataAt(destination)->getType()) {
-      case IntegerType:
-        mergeValues<hyrise_int_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
-        break;
+  // Smaller dictionaries stay cache resident, their lookups cost little
+  const size_t FRAME_OF_REFERENCE_MIN_VALUES = 256;
 
-      case FloatType:
-        mergeValues<hyrise_float_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
-        break;
+  // Bits of a value id of a dictionary of size values, see Table::setDictionaryAt
+  size_t valueIdBits(const uint64_t values) {
+    return values <= 1 ? 1 : static_cast<size_t>(ceil(log(values) / log(2)));
+  }
 
-      case StringType:
-        mergeValues<hyrise_string_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
-        break;
+  /*
+    Replaces the merged dictionary of an integer column by a frame of
+    reference if the range of its values needs no more bits than its
+    distinct values, the value ids are rewritten to offsets from the base
+   */
+  void encodeFrameOfReference(AbstractTable::SharedDictionaryPtr &dictionary,
+                              std::vector<std::vector<value_id_t> > &value_id_mapping) {
+    auto values = std::dynamic_pointer_cast<BaseDictionary<hyrise_int_t>>(dictionary);
+    if (!values || values->size() < FRAME_OF_REFERENCE_MIN_VALUES)
+      return;
+
+    // the difference of two signed values may exceed hyrise_int_t, it
+    // always fits into uint64_t
+    const hyrise_int_t base = values->getSmallestValue();
+    const uint64_t difference = static_cast<uint64_t>(values->getGreatestValue()) - static_cast<uint64_t>(base);
+    if (difference >= std::numeric_limits<value_id_t>::max())
+      return;
+    const uint64_t range = difference + 1;
+    if (valueIdBits(range) > valueIdBits(values->size()))
+      return;
+
+    for (auto &mapping : value_id_mapping)
+      for (auto &value_id : mapping)
+        value_id = values->getValueForValueId(value_id) - base;
+    dictionary = std::make_shared<FrameOfReferenceDictionary<hyrise_int_t>>(base, range);
+  }
 
-      default:
-        break;
+  /*
+    Value ids of a frame of reference dictionary that occur in column of
+    table, the dictionary also covers the gaps between its values. Empty
+    for other dictionaries, all their values occur.
+   */
+  std::vector<bool> occurringValueIds(const hyrise::storage::c_atable_ptr_t &table,
+                                      const size_t column,
+                                      const AbstractTable::SharedDictionaryPtr &dictionary) {
+    std::vector<bool> occurring;
+    if (!std::dynamic_pointer_cast<FrameOfReferenceDictionary<hyrise_int_t>>(dictionary))
+      return occurring;
+
+    occurring.resize(dictionary->size(), false);
+    std::vector<ValueId> value_ids(VALUE_ID_BATCH_SIZE);
+    for (size_t start = 0; start < table->size(); start += VALUE_ID_BATCH_SIZE) {
+      const size_t stop = std::min(table->size(), start + VALUE_ID_BATCH_SIZE);
+      table->getValueIds(column, start, stop, value_ids.data());
+      for (size_t i = 0; i < stop - start; ++i)
+        occurring[value_ids[i].valueId] = true;
     }
+    return occurring;
   }
 
-  merged_table->resize(newSize);
+  // Dictionary the merged values of a column are appended to in order
+  template <typename T>
+  AbstractTable::SharedDictionaryPtr createMergedDictionary(const size_t size) {
+    return std::make_shared<OrderPreservingDictionary<T>>(size);
+  }
 
-  // Only after the dictionaries are merged copy the values
-for (const auto & kv: column_mapping) {
-    const auto &source = kv.first;
-    const auto &destination = kv.second;
-    // copy the actual values and apply mapping
+  // Merged strings are front coded in one buffer instead of one
+  // allocation per value
+  template <>
+  AbstractTable::SharedDictionaryPtr createMergedDictionary<hyrise_string_t>(const size_t size) {
+    return std::make_shared<FrontCodedDictionary>(size);
+  }
+}
 
+void SequentialHeapMerger::mergeValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
+                                       hyrise::storage::atable_ptr_t merged_table,
+                                       const hyrise::storage::column_mapping_t &column_mapping,
+                                       const uint64_t newSize) {
 
-    copyValues(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
+  std::vector<value_id_mapping_t> mappingPerAtrtibute(input_tables[0]->columnCount());
+  const std::vector<std::pair<size_t, size_t> > columns(column_mapping.begin(), column_mapping.end());
+  std::vector<AbstractTable::SharedDictionaryPtr> dictionaries(columns.size());
+
+  // one morsel per column
+  executeMorsels(columns.size(), [&](size_t column, size_t, size_t) {
+      const auto &source = columns[column].first;
+      const auto &destination = columns[column].second;
+      switch (merged_table->metadataAt(destination)->getType()) {
+        case IntegerType:
+          dictionaries[column] = mergeValues<hyrise_int_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
+          encodeFrameOfReference(dictionaries[column], mappingPerAtrtibute[source]);
+          break;
+
+        case FloatType:
+          dictionaries[column] = mergeValues<hyrise_float_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
+          break;
+
+        case StringType:
+          dictionaries[column] = mergeValues<hyrise_string_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source]);
+          break;
+
+        default:
+          break;
+      }
+    }, 1);
+
+  // setting a dictionary resizes the column in the attribute vector
+  // shared with other columns, so this is done serially
+  for (size_t column = 0; column < columns.size(); ++column) {
+    if (dictionaries[column])
+      merged_table->setDictionaryAt(dictionaries[column], columns[column].second);
   }
+
+  merged_table->resize(newSize);
+
+  std::vector<size_t> table_offsets(1, 0);
+  for (const auto &table : input_tables)
+    table_offsets.push_back(table_offsets.back() + table->size());
+
+  // Only after the dictionaries are merged copy the values
+  executeMorsels(table_offsets.back(), [&](size_t, size_t start, size_t stop) {
+      for (const auto &column : columns)
+        copyValues(input_tables, table_offsets, column.first, merged_table, column.second, mappingPerAtrtibute[column.first], start, stop);
+    }, MERGE_MORSEL_SIZE);
 }
 
 template <typename T>
-void SequentialHeapMerger::mergeValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
-                                       size_t source_column_index,
-                                       hyrise::storage::atable_ptr_t merged_table,
-                                       size_t destination_column_index,
-                                       value_id_mapping_t &value_id_mapping) {
+AbstractTable::SharedDictionaryPtr SequentialHeapMerger::mergeValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
+                                                                     size_t source_column_index,
+                                                                     hyrise::storage::atable_ptr_t merged_table,
+                                                                     size_t destination_column_index,
+                                                                     value_id_mapping_t &value_id_mapping) {
 
   std::vector<AbstractTable::SharedDictionaryPtr > value_id_maps;
-  AbstractTable::SharedDictionaryPtr new_dict;
 
   // shortcut for dicts
   value_id_maps.reserve(input_tables.size());
@@ -66,20 +160,35 @@ void SequentialHeapMerger::mergeValues(const std::vector<hyrise::storage::c_atab
     value_id_maps.push_back(dict);
   }
 
-  // Create new BaseDictionary - shrink when merge finished?
-  new_dict = createNewDict<T>(input_tables, value_id_maps, value_id_mapping);
+  std::vector<std::vector<bool> > occurring;
+  occurring.reserve(input_tables.size());
+  for (size_t table = 0; table < input_tables.size(); table++)
+    occurring.push_back(occurringValueIds(input_tables[table], source_column_index, value_id_maps[table]));
 
-  // set new value id map for column
-  merged_table->setDictionaryAt(new_dict, destination_column_index);
+  // Create new BaseDictionary - shrink when merge finished?
+  return createNewDict<T>(input_tables, value_id_maps, occurring, value_id_mapping);
 }
 
 template <typename T>
-AbstractTable::SharedDictionaryPtr SequentialHeapMerger::createNewDict(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables, std::vector<AbstractTable::SharedDictionaryPtr > &value_id_maps, std::vector<std::vector<value_id_t> > &value_id_mapping) {
+AbstractTable::SharedDictionaryPtr SequentialHeapMerger::createNewDict(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
+                                                                       std::vector<AbstractTable::SharedDictionaryPtr > &value_id_maps,
+                                                                       const std::vector<std::vector<bool> > &occurring,
+                                                                       std::vector<std::vector<value_id_t> > &value_id_mapping) {
   AbstractTable::SharedDictionaryPtr new_dict;
   std::priority_queue<DictionaryPosition<T> > p_queue;
   size_t new_dict_max_size = 0;
   T last_value;
 
+  // Skips value ids that do not occur in the input, returns whether a
+  // value is left
+  auto skipGaps = [&](DictionaryPosition<T> &dict_pos) {
+    const auto &occurs = occurring[dict_pos.index];
+    const auto end = std::dynamic_pointer_cast<BaseDictionary<T>>(value_id_maps[dict_pos.index])->end();
+    while (!occurs.empty() && dict_pos.it != end && !occurs[dict_pos.it.getValueId()])
+      dict_pos.it++;
+    return dict_pos.it != end;
+  };
+
   // init
   value_id_mapping.resize(input_tables.size());
 
@@ -89,14 +198,16 @@ AbstractTable::SharedDictionaryPtr SequentialHeapMerger::createNewDict(const std
 
     // insert initial value in queue
     if (value_id_maps[table]->size() > 0) {
-      p_queue.push(DictionaryPosition<T>(table, std::dynamic_pointer_cast<BaseDictionary<T>>(value_id_maps[table])->begin()));
+      DictionaryPosition<T> dict_pos(table, std::dynamic_pointer_cast<BaseDictionary<T>>(value_id_maps[table])->begin());
+      if (skipGaps(dict_pos))
+        p_queue.push(dict_pos);
     }
 
     new_dict_max_size += value_id_maps[table]->size();
   }
 
   // Create new BaseDictionary - shrink when merge finished?
-  new_dict = std::make_shared<OrderPreservingDictionary<T>>(new_dict_max_size);
+  new_dict = createMergedDictionary<T>(new_dict_max_size);
 
   if (!p_queue.empty()) {
     DictionaryPosition<T> dict_pos = p_queue.top();
@@ -106,7 +217,7 @@ AbstractTable::SharedDictionaryPtr SequentialHeapMerger::createNewDict(const std
     value_id_mapping[dict_pos.index][dict_pos.it.getValueId()] = new_dict->size() - 1;
     dict_pos.it++;
 
-    if (std::dynamic_pointer_cast<BaseDictionary<T>>(value_id_maps[dict_pos.index])->end() != dict_pos.it) {
+    if (skipGaps(dict_pos)) {
       p_queue.push(dict_pos);
     }
   }
@@ -123,7 +234,7 @@ AbstractTable::SharedDictionaryPtr SequentialHeapMerger::createNewDict(const std
     value_id_mapping[dict_pos.index][dict_pos.it.getValueId()] = new_dict->size() - 1;
     dict_pos.it++;
 
-    if (std::dynamic_pointer_cast<BaseDictionary<T>>(value_id_maps[dict_pos.index])->end() != dict_pos.it) {
+    if (skipGaps(dict_pos)) {
       p_queue.push(dict_pos);
     }
   }
@@ -133,25 +244,32 @@ AbstractTable::SharedDictionaryPtr SequentialHeapMerger::createNewDict(const std
 }
 
 void SequentialHeapMerger::copyValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
+                                      const std::vector<size_t> &table_offsets,
                                       size_t source_column_index,
                                       hyrise::storage::atable_ptr_t &merged_table,
                                       size_t destination_column_index,
-                                      std::vector<std::vector<value_id_t> > &value_id_mapping) {
-  ValueId value_id;
+                                      const std::vector<std::vector<value_id_t> > &value_id_mapping,
+                                      const size_t start,
+                                      const size_t stop) {
+  ValueIdList value_ids(VALUE_ID_BATCH_SIZE);
 
   // copy all value ids to the new doc vector
   // and apply value id mapping
-  size_t merged_table_row = 0;
-
   for (size_t table = 0; table < input_tables.size(); table++) {
-    for (size_t row = 0; row < input_tables[table]->size(); row++) {
-      value_id.valueId = input_tables[table]->getValueId(source_column_index, row).valueId;
-      value_id.valueId = value_id_mapping[table][value_id.valueId]; // translate value id to new dict
-      merged_table->setValueId(destination_column_index, merged_table_row, value_id);
-      merged_table_row++;
+    const size_t first = std::max(start, table_offsets[table]);
+    const size_t last = std::min(stop, table_offsets[table + 1]);
+
+    for (size_t batch = first; batch < last; batch += VALUE_ID_BATCH_SIZE) {
+      const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, last - batch);
+      const size_t row = batch - table_offsets[table];
+      input_tables[table]->getValueIds(source_column_index, row, row + count, value_ids.data());
+      for (size_t i = 0; i < count; ++i) {
+        ValueId value_id;
+        value_id.valueId = value_id_mapping[table][value_ids[i].valueId]; // translate value id to new dict
+        merged_table->setValueId(destination_column_index, batch + i, value_id);
+      }
     }
   }
-
 }
 
 AbstractMerger *SequentialHeapMerger::copy() {
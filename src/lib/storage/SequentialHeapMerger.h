@@ -7,6 +7,16 @@
 #include <storage/AbstractMerger.h>
 #include <storage/DictionaryPosition.h>
 
+/**
+ * Merges the dictionaries of each column with a heap and rewrites the
+ * value ids of all rows into the merged table.
+ *
+ * Columns are independent, so their dictionaries are merged as
+ * concurrent morsels on the shared scheduler. The value ids are rewritten
+ * afterwards in row ranges, each range writes all columns of its rows;
+ * ranges start at multiples of 64 rows so that no two of them share a
+ * word of a bit compressed attribute vector.
+ */
 class SequentialHeapMerger : public AbstractMerger {
 public:
 
@@ -21,22 +31,29 @@ private:
   typedef std::vector<std::vector<value_id_t> > value_id_mapping_t;
 
   template <typename T>
-  void mergeValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
-                   size_t source_column_index,
-                   hyrise::storage::atable_ptr_t  merged_table,
-                   size_t destination_column,
-                   value_id_mapping_t &mapping);
-
-
+  AbstractTable::SharedDictionaryPtr mergeValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
+                                                 size_t source_column_index,
+                                                 hyrise::storage::atable_ptr_t  merged_table,
+                                                 size_t destination_column,
+                                                 value_id_mapping_t &mapping);
+
+  /// Copies the value ids of the merged rows [start, stop) of one column
+  /// and applies the value id mapping
   void copyValues(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
+                  const std::vector<size_t> &table_offsets,
                   size_t source_column_index,
                   hyrise::storage::atable_ptr_t  &merged_table,
                   size_t destination_column_index,
-                  std::vector<std::vector<value_id_t> > &value_id_mapping);
+                  const std::vector<std::vector<value_id_t> > &value_id_mapping,
+                  size_t start,
+                  size_t stop);
 
+  /// Merges the dictionaries in value_id_maps, a non-empty occurring of
+  /// a table marks the only value ids of its dictionary that are merged
   template <typename T>
   AbstractTable::SharedDictionaryPtr createNewDict(const std::vector<hyrise::storage::c_atable_ptr_t > &input_tables,
       std::vector<AbstractTable::SharedDictionaryPtr > &value_id_maps,
+      const std::vector<std::vector<bool> > &occurring,
       std::vector<std::vector<value_id_t> > &value_id_mapping);
 
 };
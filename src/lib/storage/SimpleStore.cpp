@@ -45,13 +45,13 @@ void SimpleStore::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict,
   _main->setDictionaryAt(dict, column, row, table_id);
 }
 
-const AbstractTable::SharedDictionaryPtr& SimpleStore::dictionaryByTableId(const size_t column, 
+AbstractTable::SharedDictionaryPtr SimpleStore::dictionaryByTableId(const size_t column, 
                                                          const table_id_t table_id) const {
   if (table_id > 0) STORAGE_NOT_IMPLEMENTED(SimpleStore, dictionaryByTableId());
   return _main->dictionaryByTableId(column, table_id);
 }
 
-const AbstractTable::SharedDictionaryPtr& SimpleStore::dictionaryAt(const size_t column, 
+AbstractTable::SharedDictionaryPtr SimpleStore::dictionaryAt(const size_t column, 
                                                 const size_t row, 
                                                 const table_id_t table_id, 
                                                 const bool of_delta) const {
@@ -99,7 +99,7 @@ public:
   /**
    * @see AbstractTable
    */
-  const AbstractTable::SharedDictionaryPtr& dictionaryAt(const size_t column, 
+  AbstractTable::SharedDictionaryPtr dictionaryAt(const size_t column, 
                                                   const size_t row = 0, 
                                                   const table_id_t table_id = 0, 
                                                   const bool of_delta = false) const;
@@ -107,7 +107,7 @@ public:
   /**
    * @see AbstractTable
    */
-  const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(const size_t column, 
+  AbstractTable::SharedDictionaryPtr dictionaryByTableId(const size_t column, 
                                                          const table_id_t table_id) const;
 
   /**
@@ -44,7 +44,7 @@ struct MergeDictFunctor {
   
   template<typename R>
   result operator()() {
-    auto dict = std::dynamic_pointer_cast<OrderPreservingDictionary<R>>(_main->dictionaryAt(_column));
+    auto dict = std::dynamic_pointer_cast<BaseDictionary<R>>(_main->dictionaryAt(_column));
     std::set<R> data;
 
     // Build unified dictionary
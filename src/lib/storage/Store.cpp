@@ -1,119 +1,293 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/Store.h>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <set>
 
+#include "storage/ConcurrentDeltaVector.h"
 #include "storage/PrettyPrinter.h"
+#include "storage/ZoneMap.h"
+
+#include "taskscheduler/BackgroundTask.h"
+
+namespace {
+  // Deltas grow while snapshots read them, so their rows are kept in a
+  // ConcurrentDeltaVector whose chunks never move
+  void makeConcurrentlyReadable(const hyrise::storage::atable_ptr_t &delta) {
+    if (const auto vertical = std::dynamic_pointer_cast<MutableVerticalTable>(delta)) {
+      std::set<hyrise::storage::atable_ptr_t> containers;
+      for (size_t column = 0; column < vertical->columnCount(); ++column)
+        containers.insert(vertical->containerAt(column));
+      for (const auto &container : containers)
+        makeConcurrentlyReadable(container);
+      return;
+    }
+
+    const auto plain = std::dynamic_pointer_cast<Table<> >(delta);
+    if (!plain || plain->columnCount() == 0)
+      return;
+
+    const auto vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(plain->getAttributeVectors(0).at(0).attribute_vector);
+    if (!vector || std::dynamic_pointer_cast<ConcurrentDeltaVector<value_id_t> >(vector))
+      return;
+
+    const size_t rows = plain->size();
+    auto concurrent = std::make_shared<ConcurrentDeltaVector<value_id_t> >(plain->columnCount(), rows);
+    concurrent->resize(rows);
+    for (size_t column = 0; column < plain->columnCount(); ++column)
+      for (size_t row = 0; row < rows; ++row)
+        concurrent->set(column, row, vector->get(column, row));
+    plain->setAttributes(concurrent);
+  }
+}
 
 Store::Store(std::vector<std::vector<const ColumnMetadata *> *> md) :
-  merger(nullptr) {
+  merger(nullptr),
+  delta_rows(std::numeric_limits<size_t>::max()) {
   throw std::runtime_error("Bad things happende");
 }
 
 Store::Store() :
-  merger(nullptr) {
+  tables(std::make_shared<tables_t>()),
+  merger(nullptr),
+  delta_rows(std::numeric_limits<size_t>::max()) {
 }
 
 Store::Store(hyrise::storage::atable_ptr_t main_table) :
-  delta(main_table->copy_structure_modifiable()),
-  merger(nullptr) {
-  main_tables.push_back(main_table);
+  merger(nullptr),
+  delta_rows(std::numeric_limits<size_t>::max()) {
+  auto initial = std::make_shared<tables_t>();
+  initial->mains.push_back(main_table);
+  initial->zone_maps.push_back(std::make_shared<ZoneMap>(main_table));
+  initial->delta = main_table->copy_structure_modifiable();
+  makeConcurrentlyReadable(initial->delta);
+  tables = initial;
 }
 
 Store::~Store() {
+  try {
+    waitForMerge();
+  } catch (...) {
+    // the merged main is discarded anyway
+  }
   delete merger;
 }
 
+std::shared_ptr<const Store::tables_t> Store::currentTables() const {
+  return std::atomic_load(&tables);
+}
+
+size_t Store::deltaSize(const tables_t &current) const {
+  return std::min(current.delta->size(), delta_rows);
+}
+
+void Store::publish(const std::shared_ptr<const tables_t> &next) {
+  std::atomic_store(&tables, next);
+}
+
+// Readers that found a zone map in their generation drop it here, the
+// main may have been replaced by a merge in the meantime
+void Store::dropZoneMap(const hyrise::storage::atable_ptr_t &main) {
+  std::lock_guard<std::mutex> lk(tables_mutex);
+  const auto current = currentTables();
+  const auto it = std::find(current->mains.begin(), current->mains.end(), main);
+  if (it == current->mains.end() || !current->zone_maps[it - current->mains.begin()])
+    return;
+  auto next = std::make_shared<tables_t>(*current);
+  next->zone_maps[it - current->mains.begin()] = nullptr;
+  publish(next);
+}
+
 void Store::merge() {
+  startMerge();
+  waitForMerge();
+}
+
+void Store::startMerge() {
+  std::lock_guard<std::mutex> merging(merge_mutex);
   if (merger == nullptr) {
     throw std::runtime_error("No Merger set.");
   }
 
-  hyrise::storage::atable_ptr_t new_delta = delta->copy_structure_modifiable();
-  std::vector<hyrise::storage::c_atable_ptr_t> tmp(main_tables.begin(), main_tables.end());
-  tmp.push_back(delta);
-  main_tables = merger->merge(tmp);
-  delta = new_delta;
+  // only one merge at a time, it publishes the main tables
+  finishMerge();
+
+  std::vector<hyrise::storage::c_atable_ptr_t> inputs;
+  {
+    std::lock_guard<std::mutex> writers(delta_mutex);
+    std::lock_guard<std::mutex> lk(tables_mutex);
+    const auto current = currentTables();
+    auto next = std::make_shared<tables_t>(*current);
+    inputs.assign(current->mains.begin(), current->mains.end());
+    inputs.push_back(current->delta);
+    next->mains.push_back(current->delta);
+    next->zone_maps.push_back(nullptr);
+    next->delta = current->delta->copy_structure_modifiable();
+    makeConcurrentlyReadable(next->delta);
+    publish(next);
+  }
+
+  TableMerger *tableMerger = merger;
+  running_merge = runInBackground([this, inputs, tableMerger]() {
+      std::vector<hyrise::storage::c_atable_ptr_t> merged_inputs(inputs);
+      const auto merged = tableMerger->merge(merged_inputs);
+
+      // main tables the merge strategy kept unchanged keep their zone map,
+      // the others, including a delta taken over as is, get a new one
+      // outside of the lock
+      const auto kept_end = inputs.end() - 1;
+      std::vector<std::shared_ptr<const ZoneMap> > zone_maps(merged.size());
+      for (size_t i = 0; i < merged.size(); ++i)
+        if (std::find(inputs.begin(), kept_end, merged[i]) == kept_end)
+          zone_maps[i] = std::make_shared<ZoneMap>(merged[i]);
+
+      std::lock_guard<std::mutex> lk(tables_mutex);
+      // merges are serialized, so the main tables are still the inputs
+      const auto current = currentTables();
+      auto next = std::make_shared<tables_t>();
+      next->mains = merged;
+      next->delta = current->delta;
+      for (size_t i = 0; i < merged.size(); ++i) {
+        const auto kept = std::find(current->mains.begin(), current->mains.end() - 1, merged[i]);
+        if (kept != current->mains.end() - 1)
+          zone_maps[i] = current->zone_maps[kept - current->mains.begin()];
+      }
+      next->zone_maps = zone_maps;
+      publish(next);
+    });
+}
+
+void Store::finishMerge() {
+  if (!running_merge) {
+    return;
+  }
+  auto merge = running_merge;
+  running_merge = nullptr;
+  merge->wait();
+}
+
+void Store::waitForMerge() {
+  std::lock_guard<std::mutex> merging(merge_mutex);
+  finishMerge();
+}
+
+bool Store::isMerging() const {
+  std::lock_guard<std::mutex> merging(merge_mutex);
+  return running_merge && !running_merge->done();
+}
+
+std::shared_ptr<Store> Store::snapshot() const {
+  const auto live = liveStore();
+  auto result = std::make_shared<Store>();
+  // generations are immutable, the snapshot shares the current one and
+  // ends at the delta rows writers completed, they hold the delta lock
+  // while they append
+  auto writers = live->lockDelta();
+  result->tables = currentTables();
+  result->delta_rows = deltaSize(*result->tables);
+  result->origin = live;
+  return result;
+}
+
+std::shared_ptr<const Store> Store::liveStore() const {
+  return origin ? origin : shared_from_this();
+}
+
+std::unique_lock<std::mutex> Store::lockDelta() const {
+  return std::unique_lock<std::mutex>(delta_mutex);
 }
 
 
 std::vector< hyrise::storage::atable_ptr_t > Store::getMainTables() const {
-  return main_tables;
+  return currentTables()->mains;
+}
+
+std::vector< hyrise::storage::atable_ptr_t > Store::getMainTables(std::vector< std::shared_ptr<const ZoneMap> > &zone_maps) const {
+  const auto current = currentTables();
+  zone_maps = current->zone_maps;
+  return current->mains;
 }
 
 hyrise::storage::atable_ptr_t Store::getDeltaTable() const {
-  return delta;
+  return currentTables()->delta;
 }
 
 const ColumnMetadata *Store::metadataAt(const size_t column_index, const size_t row_index, const table_id_t table_id) const {
+  const auto current = currentTables();
   size_t offset = 0;
 
-  for (size_t main = 0; main < main_tables.size(); main++)
-    if (main_tables[main]->size() + offset > row_index) {
-      return main_tables[main]->metadataAt(column_index, row_index - offset, table_id);
+  for (size_t main = 0; main < current->mains.size(); main++)
+    if (current->mains[main]->size() + offset > row_index) {
+      return current->mains[main]->metadataAt(column_index, row_index - offset, table_id);
     } else {
-      offset += main_tables[main]->size();
+      offset += current->mains[main]->size();
     }
 
   // row is not in main tables. return metadata from delta
-  return delta->metadataAt(column_index, row_index - offset, table_id);
+  return current->delta->metadataAt(column_index, row_index - offset, table_id);
 }
 
 void Store::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row, const table_id_t table_id) {
+  const auto current = currentTables();
   size_t offset = 0;
 
-  for (size_t main = 0; main < main_tables.size(); main++)
-    if (main_tables[main]->size() + offset > row) {
-      main_tables[main]->setDictionaryAt(dict, column, row - offset, table_id);
+  for (size_t main = 0; main < current->mains.size(); main++)
+    if (current->mains[main]->size() + offset > row) {
+      current->mains[main]->setDictionaryAt(dict, column, row - offset, table_id);
+      dropZoneMap(current->mains[main]);
       return;
     } else {
-      offset += main_tables[main]->size();
+      offset += current->mains[main]->size();
     }
 
   // row is not in main tables. set dict in delta
-  delta->setDictionaryAt(dict, column, row - offset, table_id);
+  current->delta->setDictionaryAt(dict, column, row - offset, table_id);
 }
 
-const AbstractTable::SharedDictionaryPtr& Store::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
+AbstractTable::SharedDictionaryPtr Store::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
   if (!row) {
     return this->dictionaryByTableId(column, table_id);
   }
 
+  const auto current = currentTables();
   if (table_id) {
-    if (table_id < main_tables.size()) {
-      return main_tables[table_id]->dictionaryAt(column, row);
+    if (table_id < current->mains.size()) {
+      return current->mains[table_id]->dictionaryAt(column, row);
     } else {
-      return delta->dictionaryAt(column, row);
+      return current->delta->dictionaryAt(column, row);
     }
   }
 
   size_t offset = 0;
 
-  for (size_t main = 0; main < main_tables.size(); main++)
-    if (main_tables[main]->size() + offset > row) {
-      return main_tables[main]->dictionaryAt(column, row - offset);
+  for (size_t main = 0; main < current->mains.size(); main++)
+    if (current->mains[main]->size() + offset > row) {
+      return current->mains[main]->dictionaryAt(column, row - offset);
     } else {
-      offset += main_tables[main]->size();
+      offset += current->mains[main]->size();
     }
 
   // row is not in main tables. return row from delta
-  return delta->dictionaryAt(column, row - offset);
+  return current->delta->dictionaryAt(column, row - offset);
 }
 
-const AbstractTable::SharedDictionaryPtr& Store::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
-  assert(table_id <= main_tables.size());
+AbstractTable::SharedDictionaryPtr Store::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
+  const auto current = currentTables();
+  assert(table_id <= current->mains.size());
 
-  if (table_id < main_tables.size()) {
-    return main_tables[table_id]->dictionaryByTableId(column, table_id);
+  if (table_id < current->mains.size()) {
+    return current->mains[table_id]->dictionaryByTableId(column, table_id);
   } else {
-    return delta->dictionaryByTableId(column, table_id);
+    return current->delta->dictionaryByTableId(column, table_id);
   }
 }
 
-inline Store::table_offset_idx_t Store::responsibleTable(const size_t row) const {
+inline Store::table_offset_idx_t Store::responsibleTable(const tables_t &current, const size_t row) const {
   size_t offset = 0;
   size_t tableIdx = 0;
 
-  for (const auto& table: main_tables) {
+  for (const auto& table: current.mains) {
     size_t sz = table->size();
     if ((sz + offset) > row) {
       return {table, row - offset, tableIdx};
@@ -123,61 +297,125 @@ inline Store::table_offset_idx_t Store::responsibleTable(const size_t row) const
     ++tableIdx;
   }
 
-  if ((delta->size() + offset) > row) {
-    return {delta, row - offset, tableIdx};
+  if ((deltaSize(current) + offset) > row) {
+    return {current.delta, row - offset, tableIdx};
   }
   throw std::out_of_range("Requested row is located beyond store boundaries");
 }
 
 void Store::setValueId(const size_t column, const size_t row, ValueId vid) {
-  auto location = responsibleTable(row);
+  const auto current = currentTables();
+  auto location = responsibleTable(*current, row);
   location.table->setValueId(column, location.offset_in_table, vid);
+  // the zone map of a modified main table is outdated
+  if (location.table_index < current->zone_maps.size() && current->zone_maps[location.table_index])
+    dropZoneMap(location.table);
 }
 
 ValueId Store::getValueId(const size_t column, const size_t row) const {
-  auto location = responsibleTable(row);
+  const auto current = currentTables();
+  auto location = responsibleTable(*current, row);
   ValueId valueId = location.table->getValueId(column, location.offset_in_table);
   valueId.table = location.table_index;
   return valueId;
 }
 
+// Splits the range at partition boundaries and decodes each part on
+// the responsible main or delta table
+void Store::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  const auto current = currentTables();
+  size_t offset = 0;
+  for (table_id_t table_id = 0; table_id <= current->mains.size(); ++table_id) {
+    const auto &table = table_id < current->mains.size() ? current->mains[table_id] : current->delta;
+    const size_t sz = table_id < current->mains.size() ? table->size() : deltaSize(*current);
+    const size_t first = std::max(start, offset);
+    const size_t last = std::min(stop, offset + sz);
+
+    if (first < last) {
+      ValueId *out = value_ids + (first - start);
+      table->getValueIds(column, first - offset, last - offset, out);
+      for (size_t i = 0; i < last - first; ++i) {
+        out[i].table = table_id;
+      }
+    }
+
+    offset += sz;
+  }
+}
+
+// Consecutive rows located in the same partition are gathered together
+void Store::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  const auto current = currentTables();
+  auto tables = current->mains;
+  tables.push_back(current->delta);
+
+  std::vector<size_t> offsets(1, 0);
+  for (const auto& table: current->mains) {
+    offsets.push_back(offsets.back() + table->size());
+  }
+  offsets.push_back(offsets.back() + deltaSize(*current));
+
+  pos_list_t local_rows;
+  size_t i = 0;
+  while (i < count) {
+    const size_t table_id = std::upper_bound(offsets.begin(), offsets.end(), rows[i]) - offsets.begin() - 1;
+    if (table_id >= tables.size()) {
+      throw std::out_of_range("Requested row is located beyond store boundaries");
+    }
+
+    local_rows.clear();
+    size_t run_end = i;
+    while (run_end < count && rows[run_end] >= offsets[table_id] && rows[run_end] < offsets[table_id + 1]) {
+      local_rows.push_back(rows[run_end] - offsets[table_id]);
+      ++run_end;
+    }
+
+    tables[table_id]->gatherValueIds(column, local_rows.data(), local_rows.size(), value_ids + i);
+    for (size_t j = i; j < run_end; ++j) {
+      value_ids[j].table = table_id;
+    }
+    i = run_end;
+  }
+}
 
 size_t Store::size() const {
+  const auto current = currentTables();
   size_t main_tables_size = 0;
 
-  for (size_t main = 0; main < main_tables.size(); main++) {
-    main_tables_size += main_tables[main]->size();
+  for (size_t main = 0; main < current->mains.size(); main++) {
+    main_tables_size += current->mains[main]->size();
   }
 
 
-  return main_tables_size + delta->size();
+  return main_tables_size + deltaSize(*current);
 }
 
 size_t Store::columnCount() const {
-  return delta->columnCount();
+  return currentTables()->delta->columnCount();
 }
 
 unsigned Store::sliceCount() const {
-  return main_tables[0]->sliceCount();
+  return currentTables()->mains[0]->sliceCount();
 }
 
 void *Store::atSlice(const size_t slice, const size_t row) const {
+  const auto current = currentTables();
   size_t offset = 0;
 
-  for (size_t main = 0; main < main_tables.size(); main++)
-    if (main_tables[main]->size() + offset > row) {
-      return main_tables[main]->atSlice(slice, row - offset);
+  for (size_t main = 0; main < current->mains.size(); main++)
+    if (current->mains[main]->size() + offset > row) {
+      return current->mains[main]->atSlice(slice, row - offset);
     } else {
-      offset += main_tables[main]->size();
+      offset += current->mains[main]->size();
     }
 
   // row is not in main tables. return slice from delta
-  return delta->atSlice(slice, row - offset);
+  return current->delta->atSlice(slice, row - offset);
 }
 
 size_t Store::getSliceWidth(const size_t slice) const {
   // TODO we now require that all main tables have the same layout
-  return main_tables[0]->getSliceWidth(slice);
+  return currentTables()->mains[0]->getSliceWidth(slice);
 }
 
 
@@ -193,35 +431,52 @@ size_t Store::getOffsetInSlice(const size_t column) const {
 
 
 void Store::print(const size_t limit) const {
-  for (size_t main = 0; main < main_tables.size(); main++) {
-    std::cout << "== Main - Pos:" << main << ", Gen: " << main_tables[main]->generation() << " -" << std::endl;
-    main_tables[main]->print(limit);
+  const auto current = currentTables();
+  for (size_t main = 0; main < current->mains.size(); main++) {
+    std::cout << "== Main - Pos:" << main << ", Gen: " << current->mains[main]->generation() << " -" << std::endl;
+    current->mains[main]->print(limit);
   }
 
-  if (delta) {
+  if (current->delta) {
     std::cout << "== Delta:" << std::endl;
-    delta->print(limit);
+    current->delta->print(limit);
   }
 }
 
 void Store::setMerger(TableMerger *_merger) {
+  std::lock_guard<std::mutex> merging(merge_mutex);
   merger = _merger;
 }
 
+bool Store::hasMerger() const {
+  std::lock_guard<std::mutex> merging(merge_mutex);
+  return merger != nullptr;
+}
+
 
 void Store::setDelta(hyrise::storage::atable_ptr_t _delta) {
-  delta = _delta;
+  makeConcurrentlyReadable(_delta);
+  std::lock_guard<std::mutex> lk(tables_mutex);
+  auto next = std::make_shared<tables_t>(*currentTables());
+  next->delta = _delta;
+  publish(next);
 }
 
 hyrise::storage::atable_ptr_t Store::copy() const {
   std::shared_ptr<Store> new_store = std::make_shared<Store>();
+  const auto current = currentTables();
 
-  for (size_t i = 0; i < main_tables.size(); ++i) {
-    new_store->main_tables.push_back(main_tables[i]->copy());
+  auto copied = std::make_shared<tables_t>();
+  for (size_t i = 0; i < current->mains.size(); ++i) {
+    copied->mains.push_back(current->mains[i]->copy());
   }
+  copied->zone_maps = current->zone_maps;
+  copied->delta = current->delta->copy();
+  // a copy of a snapshot holds the snapshot's rows only
+  copied->delta->resize(deltaSize(*current));
+  new_store->tables = copied;
 
-  new_store->delta = delta->copy();
-
+  std::lock_guard<std::mutex> merging(merge_mutex);
   if (merger == nullptr) {
     new_store->merger = nullptr;
   } else {
@@ -233,12 +488,13 @@ hyrise::storage::atable_ptr_t Store::copy() const {
 
 
 const attr_vectors_t Store::getAttributeVectors(size_t column) const {
+  const auto current = currentTables();
   attr_vectors_t tables;
-  for (const auto& main: main_tables) {
+  for (const auto& main: current->mains) {
     const auto& subtables = main->getAttributeVectors(column);
     tables.insert(tables.end(), subtables.begin(), subtables.end());
   }
-  const auto& subtables = delta->getAttributeVectors(column);
+  const auto& subtables = current->delta->getAttributeVectors(column);
   tables.insert(tables.end(), subtables.begin(), subtables.end());
   return tables;
 }
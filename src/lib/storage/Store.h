@@ -18,6 +18,12 @@
 
 #include <helper/types.h>
 
+#include <memory>
+#include <mutex>
+
+class BackgroundTask;
+class ZoneMap;
+
 enum {
   MainStore,
   DeltaStore
@@ -30,19 +36,66 @@ enum {
  * initialization via the delta store. It can be merged into the main
  * tables using a to-be-set merger.
  */
-class Store : public AbstractTable {
+class Store : public AbstractTable, public std::enable_shared_from_this<Store> {
 protected:
-  //* Vector containing the main tables
-  std::vector< hyrise::storage::atable_ptr_t > main_tables;
+  /**
+   * Main tables, their zone maps and the delta as one immutable
+   * generation. Readers load the current generation once per call and
+   * work on it, a merge or a modification builds a new generation and
+   * swaps it in atomically.
+   */
+  struct tables_t {
+    //* Vector containing the main tables
+    std::vector< hyrise::storage::atable_ptr_t > mains;
+
+    //* Zone map of each main table, nullptr for a delta frozen by a running merge
+    std::vector< std::shared_ptr<const ZoneMap> > zone_maps;
+
+    //* Delta store
+    hyrise::storage::atable_ptr_t delta;
+  };
 
-  //* Delta store
-  hyrise::storage::atable_ptr_t delta;
+  //* Current generation, only accessed through std::atomic_load/atomic_store
+  std::shared_ptr<const tables_t> tables;
 
   //* Current merger
   TableMerger *merger;
 
+  //* Serializes swaps of the generation
+  mutable std::mutex tables_mutex;
+
+  //* Held by writers while appending to the delta and by a merge while freezing it
+  mutable std::mutex delta_mutex;
+
+  //* Guards the merger and running_merge
+  mutable std::mutex merge_mutex;
+
+  //* Background work of the merge started last, nullptr if none
+  std::shared_ptr<BackgroundTask> running_merge;
+
+  //* Store a snapshot was taken from, nullptr if this is not a snapshot
+  std::shared_ptr<const Store> origin;
+
+  //* Rows of the delta a snapshot sees, rows appended later are not
+  //* part of it; unbounded for the live store
+  size_t delta_rows;
+
+  std::shared_ptr<const tables_t> currentTables() const;
+
+  //* Rows of the delta of current that belong to this store
+  size_t deltaSize(const tables_t &current) const;
+
+  //* Replaces the current generation, tables_mutex must be held
+  void publish(const std::shared_ptr<const tables_t> &next);
+
+  //* Drops the zone map of main from the current generation
+  void dropZoneMap(const hyrise::storage::atable_ptr_t &main);
+
+  //* Waits for running_merge, merge_mutex must be held
+  void finishMerge();
+
   typedef struct { const hyrise::storage::atable_ptr_t& table; size_t offset_in_table; size_t table_index; } table_offset_idx_t;
-  table_offset_idx_t responsibleTable(size_t row) const;
+  table_offset_idx_t responsibleTable(const tables_t &current, size_t row) const;
 
 public:
 
@@ -60,7 +113,15 @@ public:
   std::vector< hyrise::storage::atable_ptr_t > getMainTables() const;
 
   /**
-   * Returns a pointer to the delta store.
+   * Returns the main tables and stores the zone map of main table i in
+   * zone_maps[i], nullptr if it has none. Both are taken at once, so
+   * they match even if a merge is published concurrently.
+   */
+  std::vector< hyrise::storage::atable_ptr_t > getMainTables(std::vector< std::shared_ptr<const ZoneMap> > &zone_maps) const;
+
+  /**
+   * Returns a pointer to the delta store. The delta of a snapshot may
+   * hold more rows than the snapshot, see size().
    */
   hyrise::storage::atable_ptr_t getDeltaTable() const;
 
@@ -68,11 +129,15 @@ public:
 
   virtual void setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row = 0, const table_id_t table_id = 0);
 
-  const AbstractTable::SharedDictionaryPtr& dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
+  AbstractTable::SharedDictionaryPtr dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
 
-  const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(const size_t column, const table_id_t table_id) const;
+  AbstractTable::SharedDictionaryPtr dictionaryByTableId(const size_t column, const table_id_t table_id) const;
 
   ValueId getValueId(const size_t column, const size_t row) const;
+
+  void getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const;
+
+  void gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const;
   
   virtual void setValueId(const size_t column, const size_t row, ValueId vid);
 
@@ -97,6 +162,56 @@ public:
    */
   void merge();
 
+  /**
+   * Starts merging the main tables with the delta and returns
+   * immediately. The delta is frozen and stays readable as the last main
+   * table while new rows go to a fresh delta; row positions and value ids
+   * of existing rows do not change until the merged main is published.
+   * The merged main is built on a task of the shared scheduler, or on the
+   * calling thread if none is initialized, and replaces the main tables
+   * including the frozen delta at once. Waits for a merge still running.
+   * @note Merger must be set!
+   */
+  void startMerge();
+
+  /**
+   * Blocks until the merge started last is published and rethrows its
+   * error, if any. Runs the merge on the calling thread if no scheduler
+   * thread has picked it up yet.
+   */
+  void waitForMerge();
+
+  /**
+   * Whether the merge started last has not been published yet.
+   */
+  bool isMerging() const;
+
+  /**
+   * Returns a store sharing the current main tables and delta. A merge
+   * published later does not change the snapshot's main tables, so
+   * readers running concurrently to a merge should read from a snapshot
+   * taken before they start. The snapshot ends at the last delta row
+   * written when it was taken; rows appended later are stored in chunks
+   * that never move, so they do not disturb readers of the snapshot.
+   * @note The store must be owned by a shared_ptr.
+   */
+  std::shared_ptr<Store> snapshot() const;
+
+  /**
+   * Returns the store new rows are appended to, which is the store a
+   * snapshot was taken from or this store itself. Writers lock and
+   * append to the delta of the live store, as a merge may have frozen
+   * the delta of a snapshot.
+   * @note The store must be owned by a shared_ptr.
+   */
+  std::shared_ptr<const Store> liveStore() const;
+
+  /**
+   * Lock writers hold while they append to the delta returned by
+   * getDeltaTable(), so that a merge does not freeze the delta under them.
+   */
+  std::unique_lock<std::mutex> lockDelta() const;
+
   void print(const size_t limit = (size_t) - 1) const;
 
   /**
@@ -106,6 +221,8 @@ public:
    */
   void setMerger(TableMerger *_merger);
 
+  bool hasMerger() const;
+
   /**
    * Sets the delta table.
    *
@@ -114,7 +231,7 @@ public:
   void setDelta(hyrise::storage::atable_ptr_t _delta);
 
   virtual table_id_t subtableCount() const {
-    return main_tables.size() + 1;
+    return currentTables()->mains.size() + 1;
   }
 
   virtual  hyrise::storage::atable_ptr_t copy() const;
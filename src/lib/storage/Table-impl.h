@@ -2,8 +2,10 @@
 #ifndef SRC_LIB_STORAGE_TABLE_IMPL_H_
 #define SRC_LIB_STORAGE_TABLE_IMPL_H_
 
+#include <algorithm>
 #include <cmath>
 #include "storage/AttributeVectorFactory.h"
+#include "storage/ConcurrentDeltaDictionary.h"
 
 ALLOC_FUNC_TEMPLATE
 Table<Strategy, Allocator>::Table(
@@ -108,12 +110,12 @@ hyrise::storage::atable_ptr_t Table<Strategy, Allocator>::copy_structure_modifia
   if (fields != nullptr) {
 for (const field_t & field: *fields) {
       metadata.push_back(metadataAt(field));
-      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<OrderIndifferentDictionary> >(metadataAt(field)->getType()));
+      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<ConcurrentDeltaDictionary> >(metadataAt(field)->getType()));
     }
   } else {
     for (size_t i = 0; i < columnCount(); ++i) {
       metadata.push_back(metadataAt(i));
-      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<OrderIndifferentDictionary> >(metadataAt(i)->getType()));
+      dictionaries->push_back(AbstractDictionary::dictionaryWithType<DictionaryFactory<ConcurrentDeltaDictionary> >(metadataAt(i)->getType()));
     }
   }
 
@@ -153,6 +155,38 @@ ValueId Table<Strategy, Allocator>::getValueId(const size_t column, const size_t
   return valueId;
 }
 
+// Value ids are decoded in chunks into a local buffer so that the
+// attribute vector is only called once per chunk
+ALLOC_FUNC_TEMPLATE
+void Table<Strategy, Allocator>::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  assert(column < width);
+  const static size_t chunk_size = 256;
+  value_id_t buffer[chunk_size];
+
+  for (size_t chunk = start; chunk < stop; chunk += chunk_size) {
+    const size_t count = std::min(chunk_size, stop - chunk);
+    tuples->decode(column, chunk, chunk + count, buffer);
+    for (size_t i = 0; i < count; ++i) {
+      value_ids[chunk - start + i] = ValueId(buffer[i], 0);
+    }
+  }
+}
+
+ALLOC_FUNC_TEMPLATE
+void Table<Strategy, Allocator>::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  assert(column < width);
+  const static size_t chunk_size = 256;
+  value_id_t buffer[chunk_size];
+
+  for (size_t chunk = 0; chunk < count; chunk += chunk_size) {
+    const size_t chunk_count = std::min(chunk_size, count - chunk);
+    tuples->gather(column, rows + chunk, chunk_count, buffer);
+    for (size_t i = 0; i < chunk_count; ++i) {
+      value_ids[chunk + i] = ValueId(buffer[i], 0);
+    }
+  }
+}
+
 ALLOC_FUNC_TEMPLATE
 void Table<Strategy, Allocator>::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   assert(column < width);
@@ -176,12 +210,12 @@ const ColumnMetadata *Table<Strategy, Allocator>::metadataAt(const size_t column
 }
 
 ALLOC_FUNC_TEMPLATE
-const AbstractTable::SharedDictionaryPtr& Table<Strategy, Allocator>::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
+AbstractTable::SharedDictionaryPtr Table<Strategy, Allocator>::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id, const bool of_delta) const {
   return _dictionaries[column];
 }
 
 ALLOC_FUNC_TEMPLATE
-const AbstractTable::SharedDictionaryPtr& Table<Strategy, Allocator>::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
+AbstractTable::SharedDictionaryPtr Table<Strategy, Allocator>::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
   return _dictionaries[column];
 }
 
@@ -92,6 +92,10 @@ public:
 
   ValueId getValueId(const size_t column, const size_t row) const;
 
+  void getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const;
+
+  void gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const;
+
   void setValueId(const size_t column, const size_t row, const ValueId valueId);
 
   void reserve(const size_t nr_of_values);
@@ -100,9 +104,9 @@ public:
 
   virtual const ColumnMetadata *metadataAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0) const;
 
-  virtual const AbstractTable::SharedDictionaryPtr& dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
+  virtual AbstractTable::SharedDictionaryPtr dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
 
-  virtual const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(const size_t column, const table_id_t table_id) const;
+  virtual AbstractTable::SharedDictionaryPtr dictionaryByTableId(const size_t column, const table_id_t table_id) const;
 
   virtual void setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row = 0, const table_id_t table_id = 0);
 
@@ -122,7 +126,7 @@ public:
   }
 
   virtual void *atSlice(const size_t slice, const size_t row) const {
-    return ((value_id_t *) tuples->data()) + row * width;
+    return tuples->rowData(row, width);
   }
 
   virtual size_t getSliceWidth(const size_t slice) const {
@@ -2,6 +2,7 @@
 #include <storage/TableMerger.h>
 
 #include "storage/AbstractMerger.h"
+#include "storage/TableUtils.h"
 
 
 hyrise::storage::column_mapping_t identityMap(hyrise::storage::atable_ptr_t input) {
@@ -34,6 +35,8 @@ std::vector<hyrise::storage::atable_ptr_t> TableMerger::mergeToTable(hyrise::sto
     // do the merge
     auto newSize = _strategy->calculateNewSize(tables.tables_to_merge);
     _merger->mergeValues(tables.tables_to_merge, dest, mapping, newSize);
+    if (_compress)
+      hyrise::storage::runLengthEncodeWhereSmaller(dest);
 
     // create result tables
     result.push_back(dest);
@@ -71,6 +74,9 @@ std::vector<hyrise::storage::atable_ptr_t > TableMerger::merge(std::vector<hyris
 
     // do the merge
     _merger->mergeValues(tables.tables_to_merge, merged_table, identityMap(merged_table), new_size);
+    // sorted or clustered columns are kept as runs if that is smaller
+    if (_compress)
+      hyrise::storage::runLengthEncodeWhereSmaller(merged_table);
 
     // create result tables
     result.push_back(merged_table);
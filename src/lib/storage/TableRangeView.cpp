@@ -40,6 +40,18 @@ ValueId TableRangeView::getValueId(const size_t column, const size_t row) const{
   return _table->getValueId(column, actual_row);
 }
 
+void TableRangeView::getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const {
+  _table->getValueIds(column, start + _start, stop + _start, value_ids);
+}
+
+void TableRangeView::gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const {
+  pos_list_t actual_rows(rows, rows + count);
+  for (auto &row : actual_rows) {
+    row += _start;
+  }
+  _table->gatherValueIds(column, actual_rows.data(), count, value_ids);
+}
+
 void *TableRangeView::atSlice(const size_t slice, const size_t row) const{
   size_t actual_row;
   actual_row = row + _start;
@@ -88,14 +100,14 @@ const ColumnMetadata *TableRangeView::metadataAt(const size_t column, const size
   return _table->metadataAt(column, actual_row, table_id);
 };
 
-const AbstractTable::SharedDictionaryPtr & TableRangeView::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id , const bool of_delta) const{
+AbstractTable::SharedDictionaryPtr TableRangeView::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id , const bool of_delta) const{
   size_t actual_row;
   actual_row = row + _start;
 
   return _table->dictionaryAt(column, actual_row, table_id, of_delta);
 }
 
-const AbstractTable::SharedDictionaryPtr & TableRangeView::dictionaryByTableId(const size_t column, const table_id_t table_id) const{
+AbstractTable::SharedDictionaryPtr TableRangeView::dictionaryByTableId(const size_t column, const table_id_t table_id) const{
   return _table->dictionaryByTableId(column, table_id);
 }
 
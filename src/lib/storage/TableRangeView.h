@@ -38,9 +38,11 @@ public:
   size_t size() const;
   void setValueId(const size_t column, const size_t row, const ValueId valueId);
   ValueId getValueId(const size_t column, const size_t row) const;
+  void getValueIds(const size_t column, const size_t start, const size_t stop, ValueId *value_ids) const;
+  void gatherValueIds(const size_t column, const pos_t *rows, const size_t count, ValueId *value_ids) const;
   void *atSlice(const size_t slice, const size_t row) const;
   const ColumnMetadata *metadataAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0) const;
-  const SharedDictionaryPtr & dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
+  SharedDictionaryPtr dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0, const bool of_delta = false) const;
 
   // throw exceptions if called
   void setDictionaryAt(SharedDictionaryPtr dict, const size_t column, const size_t row = 0, const table_id_t table_id = 0);
@@ -52,7 +54,7 @@ public:
   size_t getOffsetInSlice(const size_t column) const;
   unsigned sliceCount() const;
   hyrise::storage::atable_ptr_t copy_structure(const field_list_t *fields = nullptr, const bool reuse_dict = false, const size_t initial_size = 0, const bool with_containers = true, const bool compressed = false) const;
-  const SharedDictionaryPtr & dictionaryByTableId(const size_t column, const table_id_t table_id) const;
+  SharedDictionaryPtr dictionaryByTableId(const size_t column, const table_id_t table_id) const;
   DataType typeOfColumn(const size_t column) const;
   size_t columnCount() const;
   std::string nameOfColumn(const size_t column) const;
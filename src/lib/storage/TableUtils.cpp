@@ -1,7 +1,14 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "storage/TableUtils.h"
 
+#include <cmath>
+#include <set>
+
 #include "storage/AbstractTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/RunLengthVector.h"
+#include "storage/Table.h"
+#include "taskscheduler/MorselTask.h"
 
 namespace hyrise {
 namespace storage {
@@ -21,4 +28,44 @@ column_mapping_t calculateMapping(
   return map;
 }
 
+size_t runLengthEncodeWhereSmaller(const std::shared_ptr<AbstractTable> &table) {
+  if (const auto vertical = std::dynamic_pointer_cast<MutableVerticalTable>(table)) {
+    std::set<std::shared_ptr<AbstractTable> > containers;
+    for (size_t column = 0; column < vertical->columnCount(); ++column)
+      containers.insert(vertical->containerAt(column));
+
+    size_t encoded = 0;
+    for (const auto &container : containers)
+      encoded += runLengthEncodeWhereSmaller(container);
+    return encoded;
+  }
+
+  const auto plain = std::dynamic_pointer_cast<Table<> >(table);
+  if (!plain || plain->columnCount() == 0)
+    return 0;
+
+  const auto vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(plain->getAttributeVectors(0).at(0).attribute_vector);
+  if (!vector || std::dynamic_pointer_cast<RunLengthVector<value_id_t> >(vector))
+    return 0;
+
+  const size_t rows = plain->size();
+  std::vector<size_t> runs(plain->columnCount());
+  executeMorsels(runs.size(), [&](size_t column, size_t, size_t) {
+      runs[column] = RunLengthVector<value_id_t>::countRuns(*vector, column, rows);
+    }, 1);
+
+  // bit compression uses as many bits as the dictionary needs, see Table::setDictionaryAt
+  uint64_t compressedBits = 0, runBits = 0;
+  for (size_t column = 0; column < runs.size(); ++column) {
+    const size_t values = plain->dictionaryAt(column)->size();
+    compressedBits += rows * (values <= 1 ? 1 : static_cast<uint64_t>(ceil(log(values) / log(2))));
+    runBits += runs[column] * (sizeof(value_id_t) + sizeof(pos_t)) * 8;
+  }
+  if (runBits >= compressedBits)
+    return 0;
+
+  plain->setAttributes(RunLengthVector<value_id_t>::encode(*vector, runs.size(), rows));
+  return 1;
+}
+
 }}
@@ -18,6 +18,12 @@ column_mapping_t calculateMapping(const std::shared_ptr<const AbstractTable> &in
 column_mapping_t calculateMapping(const AbstractTable &input,
                                   const AbstractTable &dest);
 
+/// Replaces the attribute vector of each container of table by a
+/// RunLengthVector if the runs of its columns take less space than bit
+/// compression, returns the number of replaced attribute vectors. With
+/// a column-wise layout the encoding is chosen per column.
+size_t runLengthEncodeWhereSmaller(const std::shared_ptr<AbstractTable> &table);
+
 
 }}
 
@@ -0,0 +1,172 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ValueIdHashTable.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "storage/AbstractDictionary.h"
+
+ValueIdHashTable::ValueIdHashTable(const hyrise::storage::c_atable_ptr_t &table, const field_list_t &fields, const size_t row_offset)
+  : _table(table), _fields(fields) {
+  if (_fields.size() != 1)
+    throw std::runtime_error("ValueIdHashTable needs exactly one key field");
+
+  const field_t field = _fields[0];
+  const size_t tableSize = _table->size();
+  const size_t NO_KEY = std::numeric_limits<size_t>::max();
+  std::vector<size_t> firstKeyOf(std::numeric_limits<table_id_t>::max() + 1, NO_KEY);
+  std::vector<size_t> keys(tableSize);
+  size_t keyCount = 0;
+
+  ValueIdList valueIds(VALUE_ID_BATCH_SIZE);
+  for (pos_t start = 0; start < tableSize; start += VALUE_ID_BATCH_SIZE) {
+    const pos_t stop = std::min<pos_t>(start + VALUE_ID_BATCH_SIZE, tableSize);
+    _table->getValueIds(field, start, stop, valueIds.data());
+    for (pos_t row = start; row < stop; ++row) {
+      const ValueId &vid = valueIds[row - start];
+      if (firstKeyOf[vid.table] == NO_KEY) {
+        const auto &dictionary = _table->dictionaryByTableId(field, vid.table);
+        _dictionaries.push_back(BuildDictionary{vid.table, dictionary, keyCount});
+        firstKeyOf[vid.table] = keyCount;
+        keyCount += dictionary->size();
+      }
+      keys[row] = firstKeyOf[vid.table] + vid.valueId;
+    }
+  }
+
+  // counting sort of all rows by key
+  _offsets.assign(keyCount + 1, 0);
+  for (const size_t key : keys)
+    ++_offsets[key + 1];
+  for (size_t key = 0; key < keyCount; ++key)
+    _offsets[key + 1] += _offsets[key];
+
+  std::vector<pos_t> cursors(_offsets.begin(), _offsets.end() - 1);
+  _rows.resize(tableSize);
+  for (pos_t row = 0; row < tableSize; ++row)
+    _rows[cursors[keys[row]]++] = row + row_offset;
+}
+
+size_t ValueIdHashTable::size() const {
+  return _rows.size();
+}
+
+pos_list_t ValueIdHashTable::get(const hyrise::storage::c_atable_ptr_t &table,
+                                 const field_list_t &columns,
+                                 const pos_t row) const {
+  const ValueId vid = table->getValueId(columns[0], row);
+  const auto &dictionary = table->dictionaryByTableId(columns[0], vid.table);
+  const DataType type = _table->typeOfColumn(_fields[0]);
+
+  pos_list_t positions;
+  for (const auto &build : _dictionaries) {
+    const value_id_t translated = translateValueId(dictionary, build.dictionary, type, vid.valueId);
+    if (translated == NO_TRANSLATION)
+      continue;
+    const size_t key = build.firstKey + translated;
+    positions.insert(positions.end(), _rows.begin() + _offsets[key], _rows.begin() + _offsets[key + 1]);
+  }
+  return positions;
+}
+
+bool ValueIdHashTable::contains(const hyrise::storage::c_atable_ptr_t &table,
+                                const field_list_t &columns,
+                                const pos_t row) const {
+  const ValueId vid = table->getValueId(columns[0], row);
+  const auto &dictionary = table->dictionaryByTableId(columns[0], vid.table);
+  const DataType type = _table->typeOfColumn(_fields[0]);
+
+  for (const auto &build : _dictionaries) {
+    const value_id_t translated = translateValueId(dictionary, build.dictionary, type, vid.valueId);
+    if (translated == NO_TRANSLATION)
+      continue;
+    const size_t key = build.firstKey + translated;
+    if (_offsets[key + 1] != _offsets[key])
+      return true;
+  }
+  return false;
+}
+
+BitVector ValueIdHashTable::matchingValueIds(const hyrise::storage::c_atable_ptr_t &table,
+                                             const field_t field,
+                                             const table_id_t tableId) const {
+  if (table->typeOfColumn(field) != _table->typeOfColumn(_fields[0]))
+    throw std::runtime_error("ValueIdHashTable can only be probed with a column of the build column's type");
+
+  const auto &dictionary = table->dictionaryByTableId(field, tableId);
+  const DataType type = _table->typeOfColumn(_fields[0]);
+  BitVector result(dictionary->size());
+  for (const auto &build : _dictionaries) {
+    const value_id_translation_t translation = translateValueIds(dictionary, build.dictionary, type);
+    for (value_id_t valueId = 0; valueId < translation.size(); ++valueId) {
+      if (translation[valueId] == NO_TRANSLATION)
+        continue;
+      // build dictionaries may hold values without a row
+      const size_t key = build.firstKey + translation[valueId];
+      if (_offsets[key + 1] != _offsets[key])
+        result.set(valueId, true);
+    }
+  }
+  return result;
+}
+
+const ValueIdHashTable::ProbeDictionary &ValueIdHashTable::probeDictionary(const hyrise::storage::c_atable_ptr_t &table,
+                                                                           const field_t field,
+                                                                           const table_id_t tableId,
+                                                                           std::vector<ProbeDictionary> &cache) const {
+  for (const auto &probe : cache) {
+    if (probe.table == tableId)
+      return probe;
+  }
+
+  const auto &dictionary = table->dictionaryByTableId(field, tableId);
+  const DataType type = _table->typeOfColumn(_fields[0]);
+  cache.push_back(ProbeDictionary{tableId, {}});
+  for (const auto &build : _dictionaries)
+    cache.back().translations.push_back(translateValueIds(dictionary, build.dictionary, type));
+  return cache.back();
+}
+
+void ValueIdHashTable::probe(const hyrise::storage::c_atable_ptr_t &table,
+                             const field_t field,
+                             const pos_t start,
+                             const pos_t stop,
+                             pos_list_t &buildRows,
+                             pos_list_t &probeRows) const {
+  if (table->typeOfColumn(field) != _table->typeOfColumn(_fields[0]))
+    throw std::runtime_error("ValueIdHashTable can only be probed with a column of the build column's type");
+
+  std::vector<ProbeDictionary> cache;
+  const ProbeDictionary *current = nullptr;
+  ValueIdList valueIds(VALUE_ID_BATCH_SIZE);
+  for (pos_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+    const pos_t count = std::min<pos_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+    table->getValueIds(field, batch, batch + count, valueIds.data());
+    for (pos_t i = 0; i < count; ++i) {
+      const ValueId &vid = valueIds[i];
+      if (current == nullptr || current->table != vid.table)
+        current = &probeDictionary(table, field, vid.table, cache);
+
+      for (size_t b = 0; b < _dictionaries.size(); ++b) {
+        const value_id_t translated = current->translations[b][vid.valueId];
+        if (translated == NO_TRANSLATION)
+          continue;
+        const size_t key = _dictionaries[b].firstKey + translated;
+        for (size_t r = _offsets[key]; r < _offsets[key + 1]; ++r) {
+          buildRows.push_back(_rows[r]);
+          probeRows.push_back(batch + i);
+        }
+      }
+    }
+  }
+}
+
+uint64_t ValueIdHashTable::numKeys() const {
+  uint64_t keys = 0;
+  for (size_t key = 0; key + 1 < _offsets.size(); ++key) {
+    if (_offsets[key + 1] != _offsets[key])
+      ++keys;
+  }
+  return keys;
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_VALUEIDHASHTABLE_H_
+#define SRC_LIB_STORAGE_VALUEIDHASHTABLE_H_
+
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractHashTable.h"
+#include "storage/AbstractTable.h"
+#include "storage/BitVector.h"
+#include "storage/ValueIdTranslation.h"
+
+/**
+ * Join hash table over the value ids of a single column.
+ *
+ * Every build dictionary gets a dense range of keys, the rows of a value
+ * id are stored contiguously under its key. Probe value ids are translated
+ * into build value ids once per pair of dictionaries (see
+ * translateValueIds), afterwards build and probe only handle integers and
+ * never decode or hash a value.
+ */
+class ValueIdHashTable : public AbstractHashTable {
+public:
+  ValueIdHashTable(const hyrise::storage::c_atable_ptr_t &table, const field_list_t &fields, size_t row_offset = 0);
+
+  virtual ~ValueIdHashTable() {}
+
+  /// Returns the number of rows in the hash table.
+  virtual size_t size() const;
+
+  /// Get positions for the value in the table cell of given row and column.
+  virtual pos_list_t get(const hyrise::storage::c_atable_ptr_t &table,
+                         const field_list_t &columns,
+                         const pos_t row) const;
+
+  virtual bool contains(const hyrise::storage::c_atable_ptr_t &table,
+                        const field_list_t &columns,
+                        const pos_t row) const;
+
+  /// Marks the value ids of the probe table's dictionary tableId of
+  /// column field that have at least one build row
+  BitVector matchingValueIds(const hyrise::storage::c_atable_ptr_t &table,
+                             field_t field,
+                             table_id_t tableId) const;
+
+  /// Appends all pairs of matching build and probe rows for the rows
+  /// [start, stop) of the probe table's column field.
+  void probe(const hyrise::storage::c_atable_ptr_t &table,
+             field_t field,
+             pos_t start,
+             pos_t stop,
+             pos_list_t &buildRows,
+             pos_list_t &probeRows) const;
+
+  hyrise::storage::c_atable_ptr_t getTable() const {
+    return _table;
+  }
+
+  field_list_t getFields() const {
+    return _fields;
+  }
+
+  size_t getFieldCount() const {
+    return _fields.size();
+  }
+
+  uint64_t numKeys() const;
+
+private:
+  struct BuildDictionary {
+    table_id_t table;
+    AbstractTable::SharedDictionaryPtr dictionary;
+    // key of the dictionary's first value id
+    size_t firstKey;
+  };
+
+  /// Translations of one probe dictionary into all build dictionaries
+  struct ProbeDictionary {
+    table_id_t table;
+    std::vector<value_id_translation_t> translations;
+  };
+
+  const ProbeDictionary &probeDictionary(const hyrise::storage::c_atable_ptr_t &table,
+                                         field_t field,
+                                         table_id_t tableId,
+                                         std::vector<ProbeDictionary> &cache) const;
+
+  hyrise::storage::c_atable_ptr_t _table;
+  const field_list_t _fields;
+  std::vector<BuildDictionary> _dictionaries;
+  // rows of key k are _rows[_offsets[k], _offsets[k + 1])
+  std::vector<pos_t> _offsets;
+  std::vector<pos_t> _rows;
+};
+
+#endif  // SRC_LIB_STORAGE_VALUEIDHASHTABLE_H_
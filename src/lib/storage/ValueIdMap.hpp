@@ -4,5 +4,6 @@
 
 #include <storage/OrderPreservingDictionary.h>
 #include <storage/OrderIndifferentDictionary.h>
+#include <storage/ValueIdTranslation.h>
 
 #endif  // SRC_LIB_STORAGE_VALUEIDMAP_HPP_
@@ -0,0 +1,107 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ValueIdTranslation.h"
+
+#include <stdexcept>
+
+#include "storage/BaseDictionary.h"
+#include "storage/FrameOfReferenceDictionary.h"
+
+namespace {
+
+// Ids of two frames of reference differ by the distance of their bases
+bool translateFrameOfReference(const std::shared_ptr<AbstractDictionary> &from,
+                               const std::shared_ptr<AbstractDictionary> &to,
+                               value_id_translation_t &translation) {
+  const auto &source = std::dynamic_pointer_cast<FrameOfReferenceDictionary<hyrise_int_t> >(from);
+  const auto &target = std::dynamic_pointer_cast<FrameOfReferenceDictionary<hyrise_int_t> >(to);
+  if (!source || !target)
+    return false;
+
+  const hyrise_int_t shift = source->base() - target->base();
+  const hyrise_int_t targetSize = target->size();
+  translation.assign(source->size(), NO_TRANSLATION);
+  for (value_id_t id = 0; id < translation.size(); ++id) {
+    const hyrise_int_t targetId = id + shift;
+    if (targetId >= 0 && targetId < targetSize)
+      translation[id] = targetId;
+  }
+  return true;
+}
+
+template <typename T>
+value_id_translation_t translate(const std::shared_ptr<AbstractDictionary> &from,
+                                 const std::shared_ptr<AbstractDictionary> &to) {
+  const auto &source = std::static_pointer_cast<BaseDictionary<T> >(from);
+  const auto &target = std::static_pointer_cast<BaseDictionary<T> >(to);
+  const value_id_t sourceSize = source->size();
+  const value_id_t targetSize = target->size();
+  value_id_translation_t translation(sourceSize, NO_TRANSLATION);
+
+  if (from == to) {
+    for (value_id_t id = 0; id < sourceSize; ++id)
+      translation[id] = id;
+  } else if (source->isOrdered() && target->isOrdered()) {
+    value_id_t targetId = 0;
+    for (value_id_t id = 0; id < sourceSize && targetId < targetSize; ++id) {
+      const T value = source->getValueForValueId(id);
+      T targetValue = target->getValueForValueId(targetId);
+      while (targetValue < value && ++targetId < targetSize)
+        targetValue = target->getValueForValueId(targetId);
+      if (targetId < targetSize && targetValue == value)
+        translation[id] = targetId;
+    }
+  } else {
+    for (value_id_t id = 0; id < sourceSize; ++id) {
+      const T value = source->getValueForValueId(id);
+      if (target->valueExists(value))
+        translation[id] = target->getValueIdForValue(value);
+    }
+  }
+  return translation;
+}
+
+template <typename T>
+value_id_t translateSingle(const std::shared_ptr<AbstractDictionary> &from,
+                           const std::shared_ptr<AbstractDictionary> &to,
+                           const value_id_t id) {
+  if (from == to)
+    return id;
+  const auto &target = std::static_pointer_cast<BaseDictionary<T> >(to);
+  const T value = std::static_pointer_cast<BaseDictionary<T> >(from)->getValueForValueId(id);
+  return target->valueExists(value) ? target->getValueIdForValue(value) : NO_TRANSLATION;
+}
+
+}
+
+value_id_translation_t translateValueIds(const std::shared_ptr<AbstractDictionary> &from,
+                                         const std::shared_ptr<AbstractDictionary> &to,
+                                         const DataType type) {
+  switch (type) {
+    case IntegerType: {
+      value_id_translation_t translation;
+      if (translateFrameOfReference(from, to, translation))
+        return translation;
+      return translate<hyrise_int_t>(from, to);
+    }
+    case FloatType:
+      return translate<hyrise_float_t>(from, to);
+    case StringType:
+      return translate<hyrise_string_t>(from, to);
+  }
+  throw std::runtime_error("Value ids of this type cannot be translated");
+}
+
+value_id_t translateValueId(const std::shared_ptr<AbstractDictionary> &from,
+                            const std::shared_ptr<AbstractDictionary> &to,
+                            const DataType type,
+                            const value_id_t id) {
+  switch (type) {
+    case IntegerType:
+      return translateSingle<hyrise_int_t>(from, to, id);
+    case FloatType:
+      return translateSingle<hyrise_float_t>(from, to, id);
+    case StringType:
+      return translateSingle<hyrise_string_t>(from, to, id);
+  }
+  throw std::runtime_error("Value ids of this type cannot be translated");
+}
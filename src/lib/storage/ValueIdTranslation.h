@@ -0,0 +1,36 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_VALUEIDTRANSLATION_H_
+#define SRC_LIB_STORAGE_VALUEIDTRANSLATION_H_
+
+#include <memory>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractDictionary.h"
+
+/// Value ids of one dictionary translated into the value ids of another
+typedef std::vector<value_id_t> value_id_translation_t;
+
+/// Marks value ids whose value does not occur in the target dictionary
+const value_id_t NO_TRANSLATION = static_cast<value_id_t>(-1);
+
+/**
+ * Maps every value id of dictionary from to the value id of the same
+ * value in dictionary to, or to NO_TRANSLATION if to lacks the value.
+ *
+ * Two order preserving dictionaries are translated in a single merge walk
+ * over both, otherwise every value of from is looked up in to. Either way
+ * each value is compared only once, so that operators can afterwards match
+ * value ids of both dictionaries without decoding or hashing values.
+ */
+value_id_translation_t translateValueIds(const std::shared_ptr<AbstractDictionary> &from,
+                                         const std::shared_ptr<AbstractDictionary> &to,
+                                         DataType type);
+
+/// Translates a single value id of dictionary from, see translateValueIds
+value_id_t translateValueId(const std::shared_ptr<AbstractDictionary> &from,
+                            const std::shared_ptr<AbstractDictionary> &to,
+                            DataType type,
+                            value_id_t id);
+
+#endif  // SRC_LIB_STORAGE_VALUEIDTRANSLATION_H_
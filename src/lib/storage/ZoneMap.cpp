@@ -0,0 +1,54 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ZoneMap.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "taskscheduler/MorselTask.h"
+
+ZoneMap::ZoneMap(const hyrise::storage::c_atable_ptr_t &table, const size_t blockSize)
+  : _blockSize(blockSize), _rows(table->size()), _zones(table->columnCount()) {
+  if (_blockSize == 0)
+    throw std::runtime_error("ZoneMap needs a block size greater than 0");
+
+  // columns are summarized independently of each other
+  executeMorsels(_zones.size(), [&](size_t, size_t first, size_t last) {
+      ValueIdList valueIds(VALUE_ID_BATCH_SIZE);
+      for (field_t column = first; column < last; ++column) {
+        auto &zones = _zones[column];
+        zones.reserve(blockCount());
+        for (size_t start = 0; start < _rows; start += _blockSize) {
+          const size_t stop = std::min(start + _blockSize, _rows);
+          value_id_t low = std::numeric_limits<value_id_t>::max();
+          value_id_t high = 0;
+          for (size_t batch = start; batch < stop; batch += VALUE_ID_BATCH_SIZE) {
+            const size_t count = std::min<size_t>(VALUE_ID_BATCH_SIZE, stop - batch);
+            table->getValueIds(column, batch, batch + count, valueIds.data());
+            for (size_t i = 0; i < count; ++i) {
+              low = std::min(low, valueIds[i].valueId);
+              high = std::max(high, valueIds[i].valueId);
+            }
+          }
+          zones.push_back(std::make_pair(low, high));
+        }
+      }
+    }, 1);
+}
+
+void ZoneMap::candidateRanges(const field_t column, const size_t start, const size_t stop,
+                              const value_id_t low, const value_id_t high,
+                              std::vector<row_range_t> &ranges) const {
+  const auto &zones = _zones.at(column);
+  for (size_t block = start / _blockSize; block * _blockSize < stop; ++block) {
+    if (zones[block].second < low || zones[block].first > high)
+      continue;
+
+    const size_t first = std::max(start, block * _blockSize);
+    const size_t last = std::min(stop, (block + 1) * _blockSize);
+    if (!ranges.empty() && ranges.back().second == first)
+      ranges.back().second = last;
+    else
+      ranges.push_back(row_range_t(first, last));
+  }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_ZONEMAP_H_
+#define SRC_LIB_STORAGE_ZONEMAP_H_
+
+#include <utility>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractTable.h"
+
+// Rows summarized by one zone, matches the default morsel size so that
+// a pruned zone saves a whole morsel of a scan
+#define ZONE_MAP_BLOCK_SIZE 65536
+
+/**
+ * Minimum and maximum value id of every column in each block of rows of
+ * a main table.
+ *
+ * Main dictionaries are order preserving, so a range predicate translates
+ * into a value id range and blocks whose [min, max] does not intersect it
+ * hold no match. On columns whose values are clustered by insertion, e.g.
+ * ids or dates, most blocks of a selective scan can be skipped this way.
+ *
+ * A zone map is built once for a table that is not modified afterwards,
+ * Store builds one for each main table on load and merge.
+ */
+class ZoneMap {
+public:
+  explicit ZoneMap(const hyrise::storage::c_atable_ptr_t &table, size_t blockSize = ZONE_MAP_BLOCK_SIZE);
+
+  /// Appends the rows of [start, stop) whose block may hold a value id
+  /// in [low, high] in column, adjacent blocks are joined into one range
+  void candidateRanges(field_t column, size_t start, size_t stop,
+                       value_id_t low, value_id_t high,
+                       std::vector<row_range_t> &ranges) const;
+
+  value_id_t min(field_t column, size_t block) const {
+    return _zones[column][block].first;
+  }
+
+  value_id_t max(field_t column, size_t block) const {
+    return _zones[column][block].second;
+  }
+
+  size_t blockSize() const {
+    return _blockSize;
+  }
+
+  size_t blockCount() const {
+    return (_rows + _blockSize - 1) / _blockSize;
+  }
+
+  /// Number of rows of the table at the time it was summarized
+  size_t rows() const {
+    return _rows;
+  }
+
+private:
+  const size_t _blockSize;
+  const size_t _rows;
+  std::vector<std::vector<std::pair<value_id_t, value_id_t> > > _zones;
+};
+
+#endif  // SRC_LIB_STORAGE_ZONEMAP_H_
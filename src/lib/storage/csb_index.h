@@ -0,0 +1,289 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_CSB_INDEX_H_
+#define SRC_LIB_STORAGE_CSB_INDEX_H_
+
+#include <algorithm>
+#include <utility>
+
+#include <storage/csb_tree.h>
+
+namespace hyrise {
+namespace index {
+
+/*
+  Full CSB+ tree (Rao et al.) from keys of any ordered type to values.
+
+  Like CSBTree, the children of an internal node are stored contiguously
+  in a node group and the node keeps a single pointer to its group, so
+  more of a node is left for keys. Node groups are allocated at their
+  full size up front, a split shifts the nodes of one group instead of
+  copying it. Splits happen top down while descending, an insert never
+  walks back up.
+
+  Keys are unique and cannot be deleted. The tree is not synchronized,
+  inserts invalidate iterators.
+ */
+template <typename K, typename V>
+class CSBIndex {
+ public:
+  // two cache lines of keys for small types, at least 8 keys otherwise
+  static const size_t node_keys = 2 * cache_line_size / sizeof(K) > 8 ? 2 * cache_line_size / sizeof(K) : 8;
+  static const size_t group_size = node_keys + 1;
+
+ private:
+  struct leaf_t {
+    size_t num_keys;
+    K keys[node_keys];
+    V values[node_keys];
+    leaf_t *next;
+
+    leaf_t() : num_keys(0), next(nullptr) {}
+  };
+
+  struct node_t {
+    size_t num_keys;
+    // keys[i] is the smallest key below child i + 1
+    K keys[node_keys];
+    // group of num_keys + 1 children, leaves if the node is on level 1
+    void *children;
+
+    node_t() : num_keys(0), children(nullptr) {}
+  };
+
+  // leaf if _height is 0
+  void *_root;
+  size_t _height;
+  size_t _size;
+
+ public:
+  class iterator {
+    const leaf_t *_leaf;
+    size_t _index;
+
+   public:
+    iterator() : _leaf(nullptr), _index(0) {}
+
+    iterator(const leaf_t *leaf, size_t index) : _leaf(leaf), _index(index) {}
+
+    const K &key() const {
+      return _leaf->keys[_index];
+    }
+
+    const V &value() const {
+      return _leaf->values[_index];
+    }
+
+    iterator &operator++() {
+      if (++_index == _leaf->num_keys) {
+        _leaf = _leaf->next;
+        _index = 0;
+      }
+      return *this;
+    }
+
+    bool operator==(const iterator &other) const {
+      return _leaf == other._leaf && _index == other._index;
+    }
+
+    bool operator!=(const iterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  CSBIndex() : _root(new leaf_t()), _height(0), _size(0) {
+  }
+
+  ~CSBIndex() {
+    if (_height == 0) {
+      delete static_cast<leaf_t *>(_root);
+    } else {
+      destroyChildren(static_cast<node_t *>(_root), _height);
+      delete static_cast<node_t *>(_root);
+    }
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  // Value of key, nullptr if the key is not stored
+  const V *find(const K &key) const {
+    const void *node = _root;
+    for (size_t level = _height; level > 0; --level) {
+      const node_t *parent = static_cast<const node_t *>(node);
+      node = child(parent, std::upper_bound(parent->keys, parent->keys + parent->num_keys, key) - parent->keys, level - 1);
+    }
+
+    const leaf_t *leaf = static_cast<const leaf_t *>(node);
+    const size_t position = std::lower_bound(leaf->keys, leaf->keys + leaf->num_keys, key) - leaf->keys;
+    if (position < leaf->num_keys && !(key < leaf->keys[position]))
+      return &leaf->values[position];
+    return nullptr;
+  }
+
+  // Inserts key with value, returns false if key is already stored
+  bool insert(const K &key, const V &value) {
+    if (isFull(_root, _height))
+      grow();
+
+    void *node = _root;
+    for (size_t level = _height; level > 0; --level) {
+      node_t *parent = static_cast<node_t *>(node);
+      size_t position = std::upper_bound(parent->keys, parent->keys + parent->num_keys, key) - parent->keys;
+      if (isFull(child(parent, position, level - 1), level - 1)) {
+        splitChild(parent, position, level - 1);
+        if (!(key < parent->keys[position]))
+          ++position;
+      }
+      node = child(parent, position, level - 1);
+    }
+
+    leaf_t *leaf = static_cast<leaf_t *>(node);
+    const size_t position = std::lower_bound(leaf->keys, leaf->keys + leaf->num_keys, key) - leaf->keys;
+    if (position < leaf->num_keys && !(key < leaf->keys[position]))
+      return false;
+
+    for (size_t i = leaf->num_keys; i > position; --i) {
+      leaf->keys[i] = std::move(leaf->keys[i - 1]);
+      leaf->values[i] = std::move(leaf->values[i - 1]);
+    }
+    leaf->keys[position] = key;
+    leaf->values[position] = value;
+    ++leaf->num_keys;
+    ++_size;
+    return true;
+  }
+
+  // Iterates the keys in ascending order
+  iterator begin() const {
+    const void *node = _root;
+    for (size_t level = _height; level > 0; --level)
+      node = child(static_cast<const node_t *>(node), 0, level - 1);
+    const leaf_t *leaf = static_cast<const leaf_t *>(node);
+    return leaf->num_keys == 0 ? end() : iterator(leaf, 0);
+  }
+
+  iterator end() const {
+    return iterator();
+  }
+
+ private:
+  CSBIndex(const CSBIndex &);
+  CSBIndex &operator=(const CSBIndex &);
+
+  static void *child(const node_t *parent, size_t position, size_t level) {
+    if (level == 0)
+      return &static_cast<leaf_t *>(parent->children)[position];
+    return &static_cast<node_t *>(parent->children)[position];
+  }
+
+  static bool isFull(const void *node, size_t level) {
+    if (level == 0)
+      return static_cast<const leaf_t *>(node)->num_keys == node_keys;
+    return static_cast<const node_t *>(node)->num_keys == node_keys;
+  }
+
+  static void destroyChildren(node_t *node, size_t level) {
+    if (level == 1) {
+      delete[] static_cast<leaf_t *>(node->children);
+      return;
+    }
+    node_t *group = static_cast<node_t *>(node->children);
+    for (size_t i = 0; i <= node->num_keys; ++i)
+      destroyChildren(&group[i], level - 1);
+    delete[] group;
+  }
+
+  // Links the leaves [0, count) of a group and the last one to next
+  static void link(leaf_t *group, size_t count, leaf_t *next) {
+    for (size_t i = 0; i + 1 < count; ++i)
+      group[i].next = &group[i + 1];
+    group[count - 1].next = next;
+  }
+
+  // Moves the full root into a new group below a new root and splits it
+  void grow() {
+    node_t *root = new node_t();
+    if (_height == 0) {
+      leaf_t *group = new leaf_t[group_size];
+      group[0] = std::move(*static_cast<leaf_t *>(_root));
+      delete static_cast<leaf_t *>(_root);
+      root->children = group;
+    } else {
+      node_t *group = new node_t[group_size];
+      group[0] = std::move(*static_cast<node_t *>(_root));
+      delete static_cast<node_t *>(_root);
+      root->children = group;
+    }
+    _root = root;
+    ++_height;
+    splitChild(root, 0, _height - 1);
+  }
+
+  /*
+    Splits the full child at position of parent, which is not full, into
+    the nodes at position and position + 1 of the group of parent
+   */
+  void splitChild(node_t *parent, size_t position, size_t level) {
+    const size_t count = parent->num_keys + 1;
+    const size_t half = node_keys / 2;
+    K separator;
+
+    if (level == 0) {
+      leaf_t *group = static_cast<leaf_t *>(parent->children);
+      leaf_t *next = group[count - 1].next;
+      for (size_t i = count; i > position + 1; --i)
+        group[i] = std::move(group[i - 1]);
+
+      leaf_t &left = group[position], &right = group[position + 1];
+      right.num_keys = node_keys - half;
+      for (size_t i = 0; i < right.num_keys; ++i) {
+        right.keys[i] = std::move(left.keys[half + i]);
+        right.values[i] = std::move(left.values[half + i]);
+      }
+      left.num_keys = half;
+      separator = right.keys[0];
+      link(group, count + 1, next);
+    } else {
+      node_t *group = static_cast<node_t *>(parent->children);
+      for (size_t i = count; i > position + 1; --i)
+        group[i] = std::move(group[i - 1]);
+
+      // left keeps the keys [0, half) and children [0, half], right gets
+      // the keys and children after the separator in a new group
+      node_t &left = group[position], &right = group[position + 1];
+      separator = std::move(left.keys[half]);
+      right.num_keys = node_keys - half - 1;
+      for (size_t i = 0; i < right.num_keys; ++i)
+        right.keys[i] = std::move(left.keys[half + 1 + i]);
+      left.num_keys = half;
+
+      if (level == 1) {
+        leaf_t *children = static_cast<leaf_t *>(left.children);
+        leaf_t *next = children[node_keys].next;
+        leaf_t *moved = new leaf_t[group_size];
+        for (size_t i = 0; i <= right.num_keys; ++i)
+          moved[i] = std::move(children[half + 1 + i]);
+        children[half].next = moved;
+        link(moved, right.num_keys + 1, next);
+        right.children = moved;
+      } else {
+        node_t *children = static_cast<node_t *>(left.children);
+        node_t *moved = new node_t[group_size];
+        for (size_t i = 0; i <= right.num_keys; ++i)
+          moved[i] = std::move(children[half + 1 + i]);
+        right.children = moved;
+      }
+    }
+
+    for (size_t i = parent->num_keys; i > position; --i)
+      parent->keys[i] = std::move(parent->keys[i - 1]);
+    parent->keys[position] = std::move(separator);
+    ++parent->num_keys;
+  }
+};
+
+}
+}  // namespace hyrise::index
+
+#endif  // SRC_LIB_STORAGE_CSB_INDEX_H_
@@ -0,0 +1,143 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_SCAN_KERNELS_H_
+#define SRC_LIB_STORAGE_SCAN_KERNELS_H_
+
+#include <stdint.h>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HYRISE_SCAN_AVX2
+#endif
+
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Appends offset + i to positions for every i < count whose value
+ * satisfies low <= values[i] <= high. With SSE available four values
+ * are compared at once and the qualifying lanes are extracted from the
+ * comparison mask.
+ */
+inline void appendPositionsInRange(const uint32_t *values,
+                                   const size_t count,
+                                   const uint32_t low,
+                                   const uint32_t high,
+                                   pos_list_t &positions,
+                                   const size_t offset) {
+  size_t i = 0;
+
+#ifdef __SSE2__
+  // SSE only compares signed integers, flipping the sign bit maps the
+  // unsigned order onto the signed one
+  const __m128i bias = _mm_set1_epi32(0x80000000);
+  const __m128i low_v = _mm_xor_si128(_mm_set1_epi32(low), bias);
+  const __m128i high_v = _mm_xor_si128(_mm_set1_epi32(high), bias);
+
+  for (; i + 4 <= count; i += 4) {
+    const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i)), bias);
+    const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(v, low_v), _mm_cmpgt_epi32(v, high_v));
+    int mask = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+    while (mask) {
+      positions.push_back(offset + i + __builtin_ctz(mask));
+      mask &= mask - 1;
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    if (values[i] >= low && values[i] <= high) {
+      positions.push_back(offset + i);
+    }
+  }
+}
+
+/*
+ * Bit packed values are read with one unaligned 64 bit load at the byte
+ * of their first bit, shifted and masked; no value spans two loads as
+ * long as it has at most 57 bits. The caller guarantees that 8 bytes
+ * can be read at every such byte.
+ */
+inline uint64_t unpackValue(const char *bytes, const uint64_t bit, const uint64_t mask) {
+  uint64_t word;
+  std::memcpy(&word, bytes + (bit >> 3), sizeof(word));
+  return (word >> (bit & 7)) & mask;
+}
+
+inline void appendPackedPositionsInRangeScalar(const char *bytes, uint64_t bit, const uint64_t stride,
+                                               const uint64_t bits, const size_t count,
+                                               const uint32_t low, const uint32_t high,
+                                               pos_list_t &positions, const size_t offset) {
+  const uint64_t mask = (1ull << bits) - 1ull;
+  for (size_t i = 0; i < count; ++i, bit += stride) {
+    const uint64_t value = unpackValue(bytes, bit, mask);
+    if (value >= low && value <= high) {
+      positions.push_back(offset + i);
+    }
+  }
+}
+
+#ifdef HYRISE_SCAN_AVX2
+/*
+ * Unpacks four values at once: their bytes are gathered, shifted by
+ * their bit offsets and masked, then compared as 64 bit integers, which
+ * holds any 32 bit value id and low - 1 and high + 1 without overflow.
+ */
+__attribute__((target("avx2")))
+inline void appendPackedPositionsInRangeAvx2(const char *bytes, uint64_t bit, const uint64_t stride,
+                                             const uint64_t bits, const size_t count,
+                                             const uint32_t low, const uint32_t high,
+                                             pos_list_t &positions, const size_t offset) {
+  const __m256i mask_v = _mm256_set1_epi64x((1ll << bits) - 1ll);
+  const __m256i below_v = _mm256_set1_epi64x(static_cast<int64_t>(low) - 1);
+  const __m256i above_v = _mm256_set1_epi64x(static_cast<int64_t>(high) + 1);
+  const __m256i seven_v = _mm256_set1_epi64x(7);
+  const __m256i lanes_v = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4, bit += 4 * stride) {
+    const __m256i bit_v = _mm256_add_epi64(_mm256_set1_epi64x(bit), lanes_v);
+    __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long *>(bytes), _mm256_srli_epi64(bit_v, 3), 1);
+    v = _mm256_and_si256(_mm256_srlv_epi64(v, _mm256_and_si256(bit_v, seven_v)), mask_v);
+    const __m256i inside = _mm256_and_si256(_mm256_cmpgt_epi64(v, below_v), _mm256_cmpgt_epi64(above_v, v));
+    int matches = _mm256_movemask_pd(_mm256_castsi256_pd(inside));
+    while (matches) {
+      positions.push_back(offset + i + __builtin_ctz(matches));
+      matches &= matches - 1;
+    }
+  }
+
+  appendPackedPositionsInRangeScalar(bytes, bit, stride, bits, count - i, low, high, positions, offset + i);
+}
+#endif
+
+/*
+ * Appends offset + i to positions for every i < count whose bit packed
+ * value, bits wide at bit first + i * stride of data, satisfies
+ * low <= value <= high. The values are compared without decoding them
+ * into a buffer first, with AVX2 if the processor supports it.
+ */
+inline void appendPackedPositionsInRange(const uint64_t *data, const uint64_t first, const uint64_t stride,
+                                         const uint64_t bits, const size_t count,
+                                         const uint32_t low, const uint32_t high,
+                                         pos_list_t &positions, const size_t offset) {
+  const char *bytes = reinterpret_cast<const char *>(data);
+#ifdef HYRISE_SCAN_AVX2
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  if (avx2) {
+    appendPackedPositionsInRangeAvx2(bytes, first, stride, bits, count, low, high, positions, offset);
+    return;
+  }
+#endif
+  appendPackedPositionsInRangeScalar(bytes, first, stride, bits, count, low, high, positions, offset);
+}
+
+}}  // namespace hyrise::storage
+
+#endif  // SRC_LIB_STORAGE_SCAN_KERNELS_H_
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <stdint.h>
 #include <ostream>
+#include <utility>
 
 #include "boost/mpl/vector.hpp"
 #include "boost/mpl/map.hpp"
@@ -58,6 +59,9 @@ typedef std::vector<field_name_t> field_name_list_t;
 typedef std::vector<pos_t> pos_list_t;
 typedef std::vector<field_t> field_list_t;
 
+/// Rows [first, second) of a table
+typedef std::pair<size_t, size_t> row_range_t;
+
 
 /*
   This is the ValueID class used to store important information
@@ -94,6 +98,9 @@ class ValueId {
 
 typedef std::vector<ValueId> ValueIdList;
 
+// Number of rows operators decode per call of the batch value-id access
+#define VALUE_ID_BATCH_SIZE 1024
+
 class ColumnMetadata;
 typedef std::vector<const ColumnMetadata *> metadata_list;
 typedef std::vector<metadata_list *> compound_metadata_list;
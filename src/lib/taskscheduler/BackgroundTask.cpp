@@ -0,0 +1,41 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "taskscheduler/BackgroundTask.h"
+
+#include <chrono>
+
+#include "taskscheduler/SharedScheduler.h"
+
+BackgroundTask::BackgroundTask(const std::function<void()> &function) :
+  _function(function),
+  _result(_function.get_future().share()),
+  _claimed(false) {
+}
+
+void BackgroundTask::run() {
+  if (!_claimed.exchange(true))
+    _function();
+}
+
+void BackgroundTask::operator()() {
+  run();
+}
+
+void BackgroundTask::wait() {
+  run();
+  _result.get();
+}
+
+bool BackgroundTask::done() const {
+  return _result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::shared_ptr<BackgroundTask> runInBackground(const std::function<void()> &function) {
+  auto task = std::make_shared<BackgroundTask>(function);
+  auto &sharedScheduler = SharedScheduler::getInstance();
+  if (sharedScheduler.isInitialized()) {
+    sharedScheduler.getScheduler()->schedule(task);
+  } else {
+    (*task)();
+  }
+  return task;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_TASKSCHEDULER_BACKGROUNDTASK_H_
+#define SRC_LIB_TASKSCHEDULER_BACKGROUNDTASK_H_
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <string>
+
+#include "taskscheduler/Task.h"
+
+/*
+ * Task that runs a function once, e.g. a merge that runs while the
+ * thread that started it goes on. Whichever comes first, a scheduler
+ * thread or a thread waiting for the result, runs the function, so
+ * waiting never depends on a free scheduler thread.
+ */
+class BackgroundTask : public Task {
+  std::packaged_task<void()> _function;
+  std::shared_future<void> _result;
+  std::atomic<bool> _claimed;
+
+  // runs the function unless another thread claimed it already
+  void run();
+
+public:
+  explicit BackgroundTask(const std::function<void()> &function);
+  virtual ~BackgroundTask() {}
+  virtual void operator()();
+  const std::string vname() { return "BackgroundTask"; }
+
+  /*
+   * runs the function on the calling thread if no thread has started
+   * it yet, blocks until it returned and rethrows its exception, if any
+   */
+  void wait();
+  /*
+   * whether the function returned, does not block
+   */
+  bool done() const;
+};
+
+/*
+ * Schedules function on the shared scheduler and returns its task, or
+ * runs it on the calling thread if no scheduler is initialized.
+ */
+std::shared_ptr<BackgroundTask> runInBackground(const std::function<void()> &function);
+
+#endif  // SRC_LIB_TASKSCHEDULER_BACKGROUNDTASK_H_
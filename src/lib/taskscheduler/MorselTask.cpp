@@ -0,0 +1,77 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "taskscheduler/MorselTask.h"
+
+#include <algorithm>
+
+#include "taskscheduler/SharedScheduler.h"
+
+MorselQueue::MorselQueue(size_t size, size_t morselSize, const participant_morsel_function_t &function) :
+  _size(size),
+  _morselSize(morselSize),
+  _morsels(morselCount(size, morselSize)),
+  _function(function),
+  _next(0),
+  _done(0) {
+}
+
+void MorselQueue::work(size_t participant) {
+  size_t morsel;
+  while ((morsel = _next++) < _morsels) {
+    const size_t start = morsel * _morselSize;
+    try {
+      _function(participant, morsel, start, std::min(start + _morselSize, _size));
+    } catch (...) {
+      std::lock_guard<std::mutex> lk(_doneMutex);
+      if (!_exception)
+        _exception = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lk(_doneMutex);
+    if (++_done == _morsels)
+      _doneCondition.notify_all();
+  }
+}
+
+bool MorselQueue::done() {
+  std::lock_guard<std::mutex> lk(_doneMutex);
+  return _done == _morsels;
+}
+
+void MorselQueue::wait() {
+  std::unique_lock<std::mutex> lk(_doneMutex);
+  _doneCondition.wait(lk, [&]() { return _done == _morsels; });
+  if (_exception)
+    std::rethrow_exception(_exception);
+}
+
+void MorselTask::operator()() {
+  _queue->work(_participant);
+}
+
+size_t morselParticipants(size_t size, size_t morselSize) {
+  const size_t morsels = morselCount(size, morselSize);
+  auto &sharedScheduler = SharedScheduler::getInstance();
+  if (morsels <= 1 || !sharedScheduler.isInitialized())
+    return 1;
+  return std::min(morsels, sharedScheduler.getScheduler()->getNumberOfWorker());
+}
+
+void executeMorselsPerParticipant(size_t size, const participant_morsel_function_t &function, size_t morselSize) {
+  auto queue = std::make_shared<MorselQueue>(size, morselSize, function);
+
+  const size_t participants = morselParticipants(size, morselSize);
+  if (participants > 1) {
+    AbstractTaskScheduler *scheduler = SharedScheduler::getInstance().getScheduler();
+    for (size_t i = 1; i < participants; ++i)
+      scheduler->schedule(std::make_shared<MorselTask>(queue, i));
+  }
+
+  queue->work(0);
+  queue->wait();
+}
+
+void executeMorsels(size_t size, const morsel_function_t &function, size_t morselSize) {
+  executeMorselsPerParticipant(size, [&function](size_t, size_t morsel, size_t start, size_t stop) {
+    function(morsel, start, stop);
+  }, morselSize);
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_TASKSCHEDULER_MORSELTASK_H_
+#define SRC_LIB_TASKSCHEDULER_MORSELTASK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "taskscheduler/Task.h"
+
+// Default number of rows an operator processes per morsel
+#define DEFAULT_MORSEL_SIZE 65536
+
+// Called with the morsel number and its row range [start, stop)
+typedef std::function<void(size_t, size_t, size_t)> morsel_function_t;
+// Called with the participant number, the morsel number and its row range
+typedef std::function<void(size_t, size_t, size_t, size_t)> participant_morsel_function_t;
+
+/*
+ * Morsels of one parallel operator execution. Morsels are not bound to
+ * a thread, every participant claims the next unprocessed morsel until
+ * none is left, so faster workers process more morsels.
+ */
+class MorselQueue {
+  const size_t _size;
+  const size_t _morselSize;
+  const size_t _morsels;
+  const participant_morsel_function_t _function;
+
+  std::atomic<size_t> _next;
+  size_t _done;
+  std::exception_ptr _exception;
+  std::mutex _doneMutex;
+  std::condition_variable _doneCondition;
+
+public:
+  MorselQueue(size_t size, size_t morselSize, const participant_morsel_function_t &function);
+
+  /*
+   * claims and processes morsels until all morsels are claimed, passing
+   * the participant number on to the morsel function
+   */
+  void work(size_t participant);
+  /*
+   * blocks until all claimed morsels are processed, rethrows the first
+   * exception raised by a morsel
+   */
+  void wait();
+  /*
+   * whether all morsels are processed, does not block
+   */
+  bool done();
+
+  size_t morsels() const {
+    return _morsels;
+  }
+};
+
+/*
+ * Helper task that works on a morsel queue on a scheduler thread. The
+ * task returns immediately if all morsels have been claimed already.
+ */
+class MorselTask : public Task {
+  std::shared_ptr<MorselQueue> _queue;
+  size_t _participant;
+
+public:
+  MorselTask(const std::shared_ptr<MorselQueue> &queue, size_t participant) : _queue(queue), _participant(participant) {}
+  virtual ~MorselTask() {}
+  virtual void operator()();
+  const std::string vname() { return "MorselTask"; }
+};
+
+/*
+ * Returns the number of morsels a range of size rows is split into.
+ */
+inline size_t morselCount(size_t size, size_t morselSize = DEFAULT_MORSEL_SIZE) {
+  return (size + morselSize - 1) / morselSize;
+}
+
+/*
+ * Splits the rows [0, size) into morsels and calls function for each of
+ * them. The calling thread participates and helper tasks are scheduled
+ * on the shared scheduler, if one is initialized and has more than one
+ * worker; the caller never waits for a helper task that has not started,
+ * so this is safe to call from within a scheduler thread. Returns after
+ * all morsels have been processed.
+ */
+void executeMorsels(size_t size, const morsel_function_t &function, size_t morselSize = DEFAULT_MORSEL_SIZE);
+
+/*
+ * Returns the number of threads that work on the morsels of a range of
+ * size rows, including the calling thread.
+ */
+size_t morselParticipants(size_t size, size_t morselSize = DEFAULT_MORSEL_SIZE);
+
+/*
+ * Like executeMorsels, but additionally passes the number of the calling
+ * participant in [0, morselParticipants(size, morselSize)) to function.
+ * A participant processes its morsels one after another, so operators
+ * can keep thread local state per participant without synchronization.
+ */
+void executeMorselsPerParticipant(size_t size, const participant_morsel_function_t &function, size_t morselSize = DEFAULT_MORSEL_SIZE);
+
+#endif  // SRC_LIB_TASKSCHEDULER_MORSELTASK_H_